@@ -14,6 +14,11 @@ ESP32-CAM Remote Control
 #include "secrets.h"
 #include "esp_wifi.h"
 #include "esp_camera.h"
+#include "camera_pipeline.h"
+#include "motion_stage.h"
+#include "recorder.h"
+#include "actuators.h"
+#include "task_plan.h"
 #include <WiFi.h>
 #include "soc/soc.h"
 #include "soc/rtc_cntl_reg.h"
@@ -136,6 +141,10 @@ void Blink( int n ){
 void setup() 
 {
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 0); // prevent brownouts by silencing them
+
+  // Nucleos y prioridades de todas las tareas: task_plan.cpp
+  task_plan_register(TASK_LOOP, xTaskGetCurrentTaskHandle());
+  task_plan_start();
   
   //Serial.begin(115200);
   //Serial.setDebugOutput(true);
@@ -190,9 +199,17 @@ void setup()
   s->set_vflip(s, 0);
   s->set_hmirror(s, 1);
 
+  // Tarea de captura, llena el anillo de frames que comparten /stream y compania
+  camera_pipeline_start();
+  // Deteccion de movimiento, parada hasta /control?var=motion&val=1
+  motion_stage_start();
+  // Grabacion en SD, parada hasta /recording?action=start
+  recorder_start();
+
   // Remote Control Car
   initMotors();
   initServo();
+  actuators_start();
   
   ledcSetup(7, 5000, 8);
   ledcAttachPin(4, 7);  //pin4 is LED
@@ -266,12 +283,8 @@ void setup()
 #endif
 }
 
+// Lo unico que queda en loop(): cerrar cada segundo la ventana de CPU por tarea de /perf
 void loop() {
-  int count=0;
-  delay(100);
-  if ( count > 100 ){
-    //Serial.printf("RSSi: %ld dBm\n",WiFi.RSSI());
-    count=0;
-  } 
-  count++;
+  task_plan_sample();
+  vTaskDelay(TASK_SAMPLE_MS / portTICK_PERIOD_MS);
 }
@@ -0,0 +1,259 @@
+#include "actuators.h"
+#include "drive_mixer.h"
+#include "servo_motion.h"
+#include "failsafe.h"
+#include "device_state.h"
+#include "metrics.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "Arduino.h"
+#include "freertos/queue.h"
+
+// Tarea que mueve los motores. Los handlers solo encolan el pulso (duty, duracion y que hacer al final)
+// o la posicion del joystick y vuelven enseguida, asi el servidor web no se queda parado en un delay().
+// Con el joystick activo o algun servo en camino hay un tick fijo de CONTROL_TICK_MS en el que
+// el mezclador recalcula las ruedas y el planificador da el siguiente paso de cada servo.
+// La misma tarea vigila el failsafe: si el operador deja de mandar comandos, frena en rampa en ese tick.
+
+#define MOTOR_QUEUE_LEN 8
+
+typedef enum {
+        MSG_PULSE,
+        MSG_DRIVE,
+        MSG_SERVO
+} actuator_msg_type_t;
+
+typedef struct {
+        int8_t x;
+        int8_t y;
+        uint8_t max_duty;
+} drive_input_t;
+
+typedef struct {
+        uint8_t index;
+        int16_t target;
+} servo_input_t;
+
+typedef struct {
+        actuator_msg_type_t type;
+        union {
+                motor_cmd_t pulse;
+                drive_input_t drive;
+                servo_input_t servo;
+        };
+} actuator_msg_t;
+
+static QueueHandle_t motor_queue = NULL;
+static TaskHandle_t actuators_task_handle = NULL;
+
+// ms del ultimo comando, lo escriben los handlers y el canal WebSocket (32 bits, escritura atomica)
+static volatile uint32_t heartbeat_ms = 0;
+static volatile uint32_t failsafe_timeout = FAILSAFE_TIMEOUT_MS;
+static uint32_t failsafe_trips = 0;
+static uint32_t failsafe_worst_ms = 0;
+
+// Lo ultimo escrito en cada canal, de aqui parte la rampa de frenado
+static uint8_t motor_duty[MOTOR_CHANNELS] = {0,};
+
+static uint32_t now_ms(){
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static void motor_write(const uint8_t * duty){
+    for(int i = 0; i < MOTOR_CHANNELS; i++){
+        motor_duty[i] = duty[i];
+        ledcWrite(MOTOR_FIRST_CHANNEL + i, duty[i]);
+    }
+}
+
+// Un comando nuevo no despierta a la tarea: se recoge aqui, al empezar cada vuelta y justo antes de
+// mirar si ha vencido el plazo, que puede haber llegado mientras se esperaba a la cola
+static void failsafe_collect(failsafe_t * fs){
+    uint32_t beat = heartbeat_ms;
+    if(beat != fs->last_feed){
+        failsafe_feed(fs, beat);
+        state_set(STATE_FAILSAFE, 0);
+    }
+}
+
+static TickType_t ticks_until(int64_t when){
+    int64_t left = when - esp_timer_get_time();
+    return left > 0 ? (TickType_t)((left + 999) / 1000 / portTICK_PERIOD_MS) : 0;
+}
+
+static void actuators_task(void * arg){
+    static const uint8_t stopped[MOTOR_CHANNELS] = {0,};
+    static const int16_t park[SERVO_COUNT] = FAILSAFE_PARK;
+    motor_cmd_t active = {{0,}, 0, MOTOR_EXPIRY_STOP};
+    drive_input_t stick = {0, 0, 0};
+    bool pulsing = false;
+    bool driving = false;
+    bool servos_moving = false;
+    bool stopping = false;
+    int64_t expiry = 0;
+    int64_t next_tick = 0;
+    failsafe_t fs;
+    failsafe_init(&fs, failsafe_timeout);
+    uint32_t trip_feed = 0;
+
+    while(true){
+        failsafe_collect(&fs);
+        fs.timeout_ms = failsafe_timeout;
+
+        TickType_t wait = portMAX_DELAY;
+        if(pulsing){
+            wait = ticks_until(expiry);
+        }
+        if(driving || servos_moving || stopping){
+            TickType_t t = ticks_until(next_tick);
+            if(t < wait){
+                wait = t;
+            }
+        }
+        uint32_t left = failsafe_left(&fs, now_ms());
+        if(left != UINT32_MAX){
+            TickType_t t = (left + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+            if(t < wait){
+                wait = t;
+            }
+        }
+
+        actuator_msg_t msg;
+        if(xQueueReceive(motor_queue, &msg, wait) == pdTRUE){
+            if(msg.type == MSG_PULSE){
+                active = msg.pulse;
+                motor_write(active.duty);
+                driving = false;
+                stopping = false;
+                pulsing = active.duration_ms > 0;
+                expiry = esp_timer_get_time() + (int64_t)active.duration_ms * 1000;
+            } else if(msg.type == MSG_DRIVE){
+                stick = msg.drive;
+                pulsing = false;
+                stopping = false;
+                if(!driving && !servos_moving){
+                    next_tick = esp_timer_get_time();
+                }
+                driving = true;
+            } else {
+                servo_motion_set_target(msg.servo.index, msg.servo.target);
+                if(!driving && !servos_moving && !stopping){
+                    next_tick = esp_timer_get_time();
+                }
+                servos_moving = true;
+            }
+            continue;
+        }
+
+        // Antes de leer la hora: un latido posterior a now daria una resta negativa
+        failsafe_collect(&fs);
+        int64_t now = esp_timer_get_time();
+        if(failsafe_expired(&fs, (uint32_t)(now / 1000))){
+            // Sin noticias del operador: fuera pulsos y joystick, frenar desde este mismo tick y aparcar los servos
+            trip_feed = fs.last_feed;
+            pulsing = false;
+            driving = false;
+            stopping = true;
+            next_tick = now;
+            for(int i = 0; i < SERVO_COUNT; i++){
+                if(servo_motion_known(i)){
+                    servo_motion_set_target(i, park[i]);
+                    state_set((state_field_t)(STATE_SERVO + i), park[i]);
+                    servos_moving = true;
+                }
+            }
+            state_set(STATE_FAILSAFE, 1);
+        }
+        if(pulsing && now >= expiry){
+            pulsing = false;
+            if(active.at_expiry == MOTOR_EXPIRY_STOP){
+                motor_write(stopped);
+            }
+        }
+        if((driving || servos_moving || stopping) && now >= next_tick){
+            if(driving){
+                uint8_t duty[MOTOR_CHANNELS];
+                drive_mixer_mix(stick.x, stick.y, stick.max_duty, duty);
+                motor_write(duty);
+                // Joystick en el centro: motores parados, no hace falta seguir con el tick
+                if(!stick.x && !stick.y){
+                    driving = false;
+                }
+            }
+            if(stopping){
+                stopping = failsafe_ramp(motor_duty, MOTOR_CHANNELS);
+                motor_write(motor_duty);
+                if(!stopping){
+                    uint32_t reaction = (uint32_t)(now / 1000) - trip_feed;
+                    failsafe_trips++;
+                    if(reaction > failsafe_worst_ms){
+                        failsafe_worst_ms = reaction;
+                    }
+                    metric_observe(&metric_failsafe_reaction_us, reaction * 1000);
+                }
+            }
+            if(servos_moving){
+                servos_moving = servo_motion_step();
+            }
+            next_tick += CONTROL_TICK_MS * 1000;
+            if(next_tick < now){
+                next_tick = now + CONTROL_TICK_MS * 1000;
+            }
+        }
+    }
+}
+
+void actuators_start(){
+    if(actuators_task_handle){
+        return;
+    }
+    motor_queue = xQueueCreate(MOTOR_QUEUE_LEN, sizeof(actuator_msg_t));
+    task_plan_create(TASK_ACTUATORS, actuators_task, NULL, &actuators_task_handle);
+}
+
+bool motor_enqueue(const motor_cmd_t * cmd){
+    if(!motor_queue){
+        return false;
+    }
+    actuator_msg_t msg;
+    msg.type = MSG_PULSE;
+    msg.pulse = *cmd;
+    return xQueueSend(motor_queue, &msg, 0) == pdTRUE;
+}
+
+bool motor_drive(int x, int y, uint8_t max_duty){
+    if(!motor_queue){
+        return false;
+    }
+    actuator_msg_t msg;
+    msg.type = MSG_DRIVE;
+    msg.drive.x = x;
+    msg.drive.y = y;
+    msg.drive.max_duty = max_duty;
+    return xQueueSend(motor_queue, &msg, 0) == pdTRUE;
+}
+
+bool servo_move(int index, int target){
+    if(!motor_queue || index < 0 || index >= SERVO_COUNT){
+        return false;
+    }
+    actuator_msg_t msg;
+    msg.type = MSG_SERVO;
+    msg.servo.index = index;
+    msg.servo.target = target;
+    return xQueueSend(motor_queue, &msg, 0) == pdTRUE;
+}
+
+void actuators_heartbeat(){
+    heartbeat_ms = now_ms();
+}
+
+void actuators_set_failsafe(uint32_t timeout_ms){
+    failsafe_timeout = timeout_ms;
+}
+
+void actuators_failsafe_stats(uint32_t * trips, uint32_t * worst_ms, uint32_t * bound_ms){
+    *trips = failsafe_trips;
+    *worst_ms = failsafe_worst_ms;
+    *bound_ms = failsafe_timeout ? FAILSAFE_REACTION_MS(failsafe_timeout, CONTROL_TICK_MS) : 0;
+}
@@ -0,0 +1,46 @@
+#ifndef ACTUATORS_H
+#define ACTUATORS_H
+
+#include <stdint.h>
+
+// Canales LEDC de los motores: 3 (pin 12), 4 (pin 13), 5 (pin 14), 6 (pin 15)
+#define MOTOR_FIRST_CHANNEL 3
+#define MOTOR_CHANNELS 4
+
+typedef enum {
+        MOTOR_EXPIRY_STOP,      // al acabar el pulso se paran los cuatro canales
+        MOTOR_EXPIRY_HOLD       // se deja el ultimo duty (noStop)
+} motor_expiry_t;
+
+typedef struct {
+        uint8_t duty[MOTOR_CHANNELS];
+        uint16_t duration_ms;           // 0 = sin limite de tiempo
+        motor_expiry_t at_expiry;
+} motor_cmd_t;
+
+void actuators_start();
+
+// Periodo del tick de control mientras se conduce con el joystick o se mueve algun servo.
+// Coincide con la PWM de 50 Hz de los servos: un paso de trayectoria por periodo.
+#define CONTROL_TICK_MS 20
+
+// No bloquea: la tarea de motores aplica el comando en cuanto lo recibe, sustituyendo al pulso en curso
+bool motor_enqueue(const motor_cmd_t * cmd);
+
+// Joystick: x giro, y avance (-100..100). Pasa a conduccion proporcional, cada tick
+// el mezclador calcula el duty de cada rueda hasta que el joystick vuelve al centro o llega un pulso.
+bool motor_drive(int x, int y, uint8_t max_duty);
+
+// Servo index (0..SERVO_COUNT-1) hacia target (325..650). El planificador lo lleva hasta alli
+// en el tick de control, con la velocidad y aceleracion limitadas de servo_motion.
+bool servo_move(int index, int target);
+
+// Desde cualquier tarea: ha llegado un comando del operador, rearma el failsafe (failsafe.h)
+void actuators_heartbeat();
+// Plazo del failsafe en ms, 0 lo apaga
+void actuators_set_failsafe(uint32_t timeout_ms);
+// Veces que ha saltado y la peor reaccion medida, del ultimo comando a motores parados
+// y la cota del peor caso con el plazo actual (FAILSAFE_REACTION_MS, 0 si esta apagado)
+void actuators_failsafe_stats(uint32_t * trips, uint32_t * worst_ms, uint32_t * bound_ms);
+
+#endif
@@ -0,0 +1,121 @@
+#include "avi.h"
+#include <string.h>
+
+#define AVIF_HASINDEX 0x10
+#define AVIIF_KEYFRAME 0x10
+
+static uint8_t * put32(uint8_t * p, uint32_t v){
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+static uint8_t * put16(uint8_t * p, uint16_t v){
+    p[0] = v;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+static uint8_t * put4cc(uint8_t * p, const char * cc){
+    memcpy(p, cc, 4);
+    return p + 4;
+}
+
+// RIFF 'AVI ' / LIST 'hdrl' (avih, LIST 'strl' (strh, strf)) / JUNK / LIST 'movi'
+#define HDRL_SIZE (4 + 8 + 56 + 12 + 8 + 56 + 8 + 40)
+#define STRL_SIZE (4 + 8 + 56 + 8 + 40)
+#define JUNK_OFFSET (12 + 8 + HDRL_SIZE)
+#define JUNK_SIZE (AVI_MOVI_OFFSET - 8 - JUNK_OFFSET - 8)
+
+void avi_header(uint8_t * out, const avi_info_t * info){
+    uint32_t index_bytes = info->indexed ? 8 + info->frames * AVI_INDEX_ENTRY : 0;
+    uint32_t usec = info->usec_per_frame ? info->usec_per_frame : 100000;
+    uint32_t suggested = info->max_chunk;
+    uint8_t * p = out;
+    memset(out, 0, AVI_HEADER_SIZE);
+
+    p = put4cc(p, "RIFF");
+    p = put32(p, AVI_HEADER_SIZE - 8 + info->movi_bytes + index_bytes);
+    p = put4cc(p, "AVI ");
+    p = put4cc(p, "LIST");
+    p = put32(p, HDRL_SIZE);
+    p = put4cc(p, "hdrl");
+
+    p = put4cc(p, "avih");
+    p = put32(p, 56);
+    p = put32(p, usec);
+    p = put32(p, (uint64_t)suggested * 1000000 / usec);
+    p = put32(p, 0);                                // dwPaddingGranularity
+    p = put32(p, info->indexed ? AVIF_HASINDEX : 0);
+    p = put32(p, info->frames);
+    p = put32(p, 0);                                // dwInitialFrames
+    p = put32(p, 1);                                // dwStreams
+    p = put32(p, suggested);
+    p = put32(p, info->width);
+    p = put32(p, info->height);
+    p += 16;                                        // dwReserved
+
+    p = put4cc(p, "LIST");
+    p = put32(p, STRL_SIZE);
+    p = put4cc(p, "strl");
+
+    p = put4cc(p, "strh");
+    p = put32(p, 56);
+    p = put4cc(p, "vids");
+    p = put4cc(p, "MJPG");
+    p = put32(p, 0);                                // dwFlags
+    p = put16(p, 0);                                // wPriority
+    p = put16(p, 0);                                // wLanguage
+    p = put32(p, 0);                                // dwInitialFrames
+    p = put32(p, usec);                             // dwScale / dwRate = segundos por frame
+    p = put32(p, 1000000);
+    p = put32(p, 0);                                // dwStart
+    p = put32(p, info->frames);
+    p = put32(p, suggested);
+    p = put32(p, 0xFFFFFFFF);                       // dwQuality
+    p = put32(p, 0);                                // dwSampleSize
+    p = put16(p, 0);
+    p = put16(p, 0);
+    p = put16(p, info->width);
+    p = put16(p, info->height);
+
+    p = put4cc(p, "strf");
+    p = put32(p, 40);
+    p = put32(p, 40);                               // biSize
+    p = put32(p, info->width);
+    p = put32(p, info->height);
+    p = put16(p, 1);                                // biPlanes
+    p = put16(p, 24);                               // biBitCount
+    p = put4cc(p, "MJPG");
+    p = put32(p, info->width * info->height * 3);
+    p += 16;                                        // resolucion y paleta
+
+    p = put4cc(p, "JUNK");
+    p = put32(p, JUNK_SIZE);
+    p += JUNK_SIZE;
+
+    p = put4cc(p, "LIST");
+    p = put32(p, 4 + info->movi_bytes);
+    put4cc(p, "movi");
+}
+
+size_t avi_chunk_size(size_t len){
+    return AVI_CHUNK_HEADER + len + (len & 1);
+}
+
+void avi_chunk_header(uint8_t * out, size_t len){
+    put32(put4cc(out, "00dc"), len);
+}
+
+void avi_index_entry(uint8_t * out, uint32_t pos, size_t len){
+    uint8_t * p = put4cc(out, "00dc");
+    p = put32(p, AVIIF_KEYFRAME);
+    p = put32(p, pos - AVI_MOVI_OFFSET);
+    put32(p, len);
+}
+
+void avi_index_header(uint8_t * out, uint32_t entries){
+    put32(put4cc(out, "idx1"), entries * AVI_INDEX_ENTRY);
+}
@@ -0,0 +1,40 @@
+#ifndef AVI_H
+#define AVI_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Contenedor AVI MJPEG para las grabaciones. La cabecera ocupa un sector justo (relleno con JUNK)
+// y termina abriendo la lista 'movi', asi los frames empiezan alineados a 512 y todo lo demas es
+// anadir al final. Al cerrar se anade idx1 y se reescribe solo este primer sector con los totales.
+// Un archivo sin cerrar se sigue pudiendo reproducir: el indice es opcional en MJPEG.
+// No depende de nada del ESP32, se puede probar en el PC con ffprobe.
+
+#define AVI_HEADER_SIZE 512
+#define AVI_MOVI_OFFSET 508             // la fourcc 'movi'; los offsets de idx1 cuentan desde aqui
+#define AVI_CHUNK_HEADER 8
+#define AVI_INDEX_ENTRY 16
+
+typedef struct {
+        uint32_t width;
+        uint32_t height;
+        uint32_t frames;
+        uint32_t usec_per_frame;
+        uint32_t movi_bytes;            // trozos de frame, sin la cabecera de la lista
+        uint32_t max_chunk;             // para dwSuggestedBufferSize
+        bool indexed;                   // hay idx1 detras de movi, con una entrada por frame
+} avi_info_t;
+
+// Escribe los AVI_HEADER_SIZE bytes de la cabecera
+void avi_header(uint8_t * out, const avi_info_t * info);
+
+// Bytes que ocupa en el archivo el trozo de un JPEG de len bytes (cabecera y relleno a par)
+size_t avi_chunk_size(size_t len);
+void avi_chunk_header(uint8_t * out, size_t len);
+
+// Entrada de idx1 para un frame cuyo trozo empieza en pos (posicion en el archivo)
+void avi_index_entry(uint8_t * out, uint32_t pos, size_t len);
+// Cabecera de idx1 (8 bytes) para entries entradas
+void avi_index_header(uint8_t * out, uint32_t entries);
+
+#endif
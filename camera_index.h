@@ -0,0 +1,554 @@
+// Generado por tools/embed_html.py a partir de html/, no editar a mano
+#ifndef CAMERA_INDEX_H
+#define CAMERA_INDEX_H
+
+#include <stdint.h>
+#include "Arduino.h"
+#include "static_assets.h"
+
+// style.css: 11719 bytes originales, 3206 minimizado, 1127 con gzip
+static const uint8_t style_css_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xdd, 0x56, 0xdb, 0x6e, 0xdc, 0x36,
+  0x10, 0x7d, 0xd7, 0x57, 0x10, 0x31, 0x02, 0xd8, 0xc8, 0xd2, 0x91, 0xf6, 0xe2, 0x3a, 0x5a, 0xb4,
+  0x68, 0x81, 0xd6, 0xe8, 0x07, 0xf4, 0xa1, 0x40, 0xd0, 0x07, 0x4a, 0x1a, 0x69, 0x19, 0x53, 0xa2,
+  0x40, 0x52, 0x7b, 0x89, 0xe0, 0x8f, 0xea, 0x37, 0xf4, 0xc7, 0x3a, 0xa4, 0xa8, 0xdb, 0x5e, 0x9a,
+  0x3c, 0xd7, 0x02, 0xbc, 0x12, 0x39, 0x1c, 0xce, 0xcc, 0x39, 0x73, 0xc8, 0x44, 0x66, 0xa7, 0x36,
+  0x97, 0x95, 0xa1, 0x39, 0x2b, 0xb9, 0x38, 0xc5, 0xbf, 0x28, 0xce, 0xc4, 0xe2, 0x77, 0x10, 0x7b,
+  0x30, 0x3c, 0x65, 0x0b, 0xcd, 0x2a, 0x4d, 0x35, 0x28, 0x9e, 0x6f, 0x83, 0x84, 0xa5, 0xaf, 0x85,
+  0x92, 0x4d, 0x95, 0xc5, 0x77, 0xd1, 0xb3, 0x7d, 0xb6, 0x41, 0x2a, 0x85, 0x54, 0xf1, 0xdd, 0x6f,
+  0x2f, 0xf6, 0xd9, 0x06, 0xce, 0x95, 0xe6, 0x5f, 0x21, 0x8e, 0x9e, 0xea, 0xe3, 0x1b, 0xc1, 0xbf,
+  0x8f, 0x1f, 0xc9, 0x1f, 0xac, 0x64, 0xff, 0xfc, 0x2d, 0x89, 0x00, 0xa3, 0x18, 0xc9, 0x1b, 0xc0,
+  0xff, 0x89, 0x34, 0xb2, 0x02, 0x1d, 0xec, 0x96, 0xed, 0x64, 0xd1, 0x33, 0x2e, 0x0a, 0x34, 0xa4,
+  0x86, 0xcb, 0xea, 0xb1, 0x64, 0xbc, 0x6a, 0x33, 0xae, 0x6b, 0xc1, 0x4e, 0x71, 0x2e, 0x00, 0xa7,
+  0xee, 0x4a, 0xa8, 0x9a, 0xc5, 0xcc, 0xc0, 0x4e, 0xd0, 0x8c, 0xab, 0x6e, 0x2c, 0xc6, 0x80, 0x9a,
+  0xb2, 0xf2, 0x96, 0xc3, 0xea, 0x0a, 0xf7, 0xc2, 0xe8, 0xac, 0xe9, 0x41, 0xb1, 0x1a, 0xbf, 0xed,
+  0xcf, 0x36, 0x28, 0x79, 0x45, 0x0f, 0x3c, 0x33, 0xbb, 0x78, 0xb5, 0x0e, 0xeb, 0xe3, 0x3c, 0xc7,
+  0xd5, 0x93, 0x7d, 0xb6, 0x41, 0xcd, 0xb2, 0x8c, 0x57, 0x45, 0xfc, 0xec, 0x0c, 0xa4, 0xca, 0x40,
+  0x51, 0xc5, 0x32, 0xde, 0xe8, 0x78, 0x8d, 0x43, 0x25, 0x53, 0x05, 0xba, 0x31, 0xb2, 0x8e, 0x69,
+  0xe4, 0x9c, 0xf8, 0x11, 0xc5, 0x8b, 0x9d, 0x89, 0xed, 0x10, 0x86, 0x93, 0x62, 0x92, 0x50, 0x99,
+  0x59, 0x3e, 0xdb, 0x31, 0x20, 0x17, 0x0e, 0x13, 0xbc, 0xa8, 0x28, 0x37, 0x50, 0xea, 0x58, 0x1b,
+  0x05, 0x26, 0xdd, 0xbd, 0x05, 0x39, 0x2f, 0x1a, 0x05, 0x6d, 0x1f, 0x44, 0xd8, 0xbb, 0xb7, 0x6f,
+  0xf4, 0x00, 0xc9, 0x2b, 0x37, 0xd4, 0x6f, 0x98, 0x40, 0x2e, 0x15, 0x8c, 0x26, 0x34, 0x11, 0x32,
+  0x7d, 0xa5, 0xda, 0x30, 0x65, 0xae, 0x98, 0xb3, 0xdc, 0x80, 0xba, 0xb0, 0x06, 0x4c, 0xfd, 0xd2,
+  0x76, 0xf0, 0xe1, 0xbf, 0x79, 0x25, 0x78, 0x05, 0x37, 0x5d, 0x7b, 0x27, 0x73, 0x63, 0x37, 0xd8,
+  0x27, 0x44, 0x78, 0x59, 0x0c, 0xc5, 0x70, 0x3b, 0x6f, 0x83, 0x0e, 0x89, 0x28, 0x0c, 0xdf, 0x6f,
+  0x83, 0x1d, 0xb8, 0xea, 0xb1, 0xc6, 0xc8, 0x6b, 0x45, 0x0f, 0x26, 0x55, 0x77, 0xa4, 0xf9, 0xb9,
+  0x84, 0x8c, 0x33, 0x72, 0x3f, 0x22, 0x4a, 0x9e, 0x43, 0x2c, 0xfd, 0x03, 0x61, 0x55, 0x46, 0xee,
+  0xa5, 0xe2, 0x58, 0x7d, 0xe6, 0x28, 0x22, 0x70, 0x44, 0xa7, 0xac, 0x86, 0x87, 0xa0, 0xbd, 0x8e,
+  0xcb, 0x15, 0xa6, 0xfc, 0x07, 0x36, 0xd7, 0x52, 0x29, 0xd9, 0x91, 0x4e, 0xd3, 0xb1, 0xdf, 0x3e,
+  0xa5, 0x94, 0x89, 0xf4, 0x1e, 0x47, 0xf7, 0x3b, 0x42, 0x89, 0x65, 0xdd, 0x43, 0x9f, 0x79, 0x97,
+  0xec, 0x24, 0xf3, 0xff, 0x1f, 0xfa, 0x43, 0x77, 0xdf, 0x25, 0x8d, 0x41, 0x05, 0xd0, 0xdf, 0x2c,
+  0xfc, 0x97, 0x46, 0x1b, 0x9e, 0x9f, 0xa8, 0x07, 0x2a, 0xd6, 0x35, 0x4b, 0x01, 0x93, 0x35, 0x07,
+  0x00, 0xdb, 0xe7, 0x15, 0xdb, 0x23, 0x0b, 0x8a, 0x42, 0x40, 0x9b, 0x36, 0x4a, 0xa3, 0x1a, 0xd5,
+  0x92, 0xa3, 0xa9, 0xda, 0x06, 0x33, 0x4c, 0x66, 0xa6, 0x34, 0x4d, 0x5a, 0xd9, 0x18, 0x1b, 0x98,
+  0x8d, 0x54, 0xa2, 0x4f, 0x6e, 0x4e, 0xf6, 0xb5, 0x43, 0x22, 0x1c, 0x60, 0x08, 0xcf, 0xd7, 0xc5,
+  0xe9, 0x0e, 0xd2, 0x57, 0xc8, 0x3e, 0xcc, 0x15, 0xc6, 0xe9, 0xd3, 0x23, 0xaf, 0xea, 0xc6, 0x50,
+  0x2b, 0x20, 0xf5, 0x37, 0x13, 0x73, 0x55, 0xf1, 0xbb, 0x2c, 0x97, 0x23, 0xa7, 0xe3, 0x4d, 0x7d,
+  0x24, 0xb8, 0xed, 0xd4, 0xd9, 0x4f, 0x82, 0x25, 0x20, 0x06, 0x97, 0xbe, 0xa4, 0x9e, 0x6b, 0x9e,
+  0x1c, 0x13, 0xbd, 0x99, 0x0a, 0xdb, 0xfa, 0x87, 0xf7, 0x73, 0x5f, 0xc4, 0xbd, 0x2f, 0xe6, 0x63,
+  0x1a, 0x04, 0xe2, 0xd2, 0x89, 0x29, 0x8e, 0x1c, 0xe2, 0x08, 0x17, 0x29, 0x56, 0x15, 0x80, 0xa0,
+  0x1e, 0x17, 0xfd, 0xeb, 0x44, 0x90, 0xaf, 0xc6, 0x10, 0x87, 0x64, 0x63, 0xbb, 0xb1, 0x03, 0xf7,
+  0xb2, 0x29, 0xfa, 0xfc, 0xa6, 0x0b, 0xa2, 0xe5, 0xa8, 0xab, 0xb6, 0xf0, 0xb3, 0xba, 0x38, 0xcd,
+  0x3d, 0xc7, 0xd5, 0x1f, 0x3a, 0x79, 0x7e, 0x76, 0x28, 0xe5, 0xf9, 0x2a, 0x5c, 0xad, 0xcf, 0xe5,
+  0xc2, 0x6d, 0x37, 0x3f, 0x98, 0x10, 0xf1, 0x1e, 0xfc, 0x3e, 0xd6, 0x78, 0x27, 0xf7, 0xa0, 0xda,
+  0xb9, 0xbb, 0xf5, 0xa7, 0x75, 0x36, 0x18, 0x30, 0xe4, 0xed, 0x1e, 0xe6, 0x16, 0xcb, 0x28, 0x5d,
+  0x46, 0xbd, 0xc5, 0x23, 0xa6, 0xcb, 0x12, 0x01, 0x59, 0x4f, 0xc4, 0x0c, 0x72, 0xd6, 0x08, 0x33,
+  0x0f, 0x92, 0x85, 0xf6, 0xc1, 0xea, 0xea, 0x03, 0x47, 0x11, 0x39, 0xaf, 0x51, 0x2d, 0x35, 0x77,
+  0x2a, 0xa5, 0x40, 0x30, 0xbb, 0xe1, 0x35, 0xa2, 0x9c, 0x65, 0x33, 0x99, 0x1b, 0xfc, 0x76, 0x28,
+  0x7f, 0x3f, 0xc9, 0x1f, 0xb5, 0xe0, 0x58, 0xb4, 0xb6, 0x9b, 0xda, 0x38, 0x12, 0xcd, 0xf6, 0x9c,
+  0x17, 0xb5, 0x1b, 0x3b, 0x07, 0x66, 0xcc, 0x93, 0x76, 0x18, 0x15, 0x0a, 0x4e, 0x83, 0xef, 0x85,
+  0xff, 0x8d, 0x3b, 0xa5, 0xba, 0xc1, 0x24, 0xbc, 0x22, 0x54, 0xbe, 0x04, 0x8f, 0x6b, 0x3d, 0x2c,
+  0xee, 0x17, 0x5d, 0xa9, 0x4f, 0xaf, 0x0c, 0xef, 0xde, 0x5d, 0x40, 0x3f, 0x39, 0x49, 0x3a, 0xdc,
+  0xbd, 0x26, 0xbb, 0x77, 0x01, 0xb9, 0xe9, 0x0e, 0x13, 0x7b, 0x8a, 0xac, 0xe6, 0xc7, 0x3f, 0x1d,
+  0x49, 0xf6, 0x16, 0xb8, 0x5a, 0x0e, 0x8d, 0xdf, 0x97, 0xea, 0x9a, 0xb1, 0x25, 0xe0, 0x0d, 0xfb,
+  0x3e, 0x83, 0x5e, 0x2c, 0x5d, 0xa2, 0x38, 0x52, 0xc6, 0xee, 0x0d, 0xb3, 0x81, 0x3f, 0xef, 0x97,
+  0x4f, 0xee, 0x3c, 0xb8, 0x3d, 0x67, 0x05, 0xd4, 0xb5, 0xaa, 0x6f, 0x98, 0x08, 0xc5, 0x42, 0x4b,
+  0xdc, 0x80, 0x0c, 0xf7, 0x95, 0x09, 0x3b, 0xd6, 0x17, 0x30, 0x4e, 0x08, 0x71, 0xd1, 0x26, 0x56,
+  0x27, 0x4a, 0x86, 0x7d, 0x6e, 0x2b, 0x8a, 0x77, 0x2b, 0xcc, 0xf1, 0x4a, 0xb9, 0x47, 0x69, 0x89,
+  0x9e, 0x1c, 0x4d, 0x70, 0x59, 0x2a, 0xa4, 0x9e, 0x60, 0xc3, 0x12, 0x0c, 0xa9, 0x31, 0x68, 0xdc,
+  0x69, 0xd2, 0xa6, 0x2f, 0xf2, 0xe6, 0xfc, 0x8e, 0xd5, 0xb7, 0xec, 0xd4, 0xe9, 0x5c, 0xbf, 0xba,
+  0xef, 0x79, 0xac, 0x51, 0xe8, 0x36, 0x9e, 0xea, 0x80, 0x81, 0xa3, 0xa1, 0xee, 0x90, 0x8e, 0x53,
+  0xe8, 0xd8, 0x38, 0xed, 0x1b, 0x7b, 0xb3, 0xdc, 0xce, 0xe9, 0x8a, 0x61, 0xef, 0x78, 0x96, 0x41,
+  0xd5, 0x06, 0x7b, 0xae, 0x79, 0xc2, 0x85, 0xed, 0x0e, 0xd2, 0x8d, 0x05, 0x1e, 0xc4, 0xcf, 0xe6,
+  0x54, 0xc3, 0x8f, 0x4e, 0xfd, 0xfe, 0x22, 0xad, 0xa7, 0x0f, 0xf9, 0x64, 0x79, 0x85, 0xeb, 0xf7,
+  0x6e, 0x42, 0xe1, 0xc4, 0x08, 0x18, 0x51, 0x12, 0xef, 0x19, 0x70, 0x1f, 0x66, 0x50, 0x20, 0x92,
+  0xb4, 0x94, 0x5f, 0xe9, 0xcd, 0xd9, 0x83, 0xc2, 0x82, 0xa1, 0x74, 0x97, 0x32, 0x83, 0x98, 0x24,
+  0x86, 0x0a, 0x35, 0x9e, 0xa6, 0xac, 0xae, 0x81, 0xe1, 0xca, 0x14, 0xa7, 0x3a, 0x0a, 0x51, 0x94,
+  0x28, 0x7b, 0x2d, 0x17, 0x03, 0xa8, 0x64, 0xd5, 0x95, 0xc2, 0x07, 0x16, 0x79, 0x3c, 0xec, 0x8d,
+  0x64, 0x30, 0x59, 0x2f, 0xa7, 0x26, 0x4f, 0x6b, 0x0f, 0xda, 0xdd, 0x17, 0x79, 0x8a, 0x7e, 0xe5,
+  0xfb, 0xa0, 0xed, 0xc5, 0x97, 0xac, 0x46, 0x32, 0xbd, 0xbc, 0x84, 0xf8, 0x37, 0xee, 0xb3, 0x9c,
+  0xed, 0xe3, 0xbf, 0x3a, 0x27, 0xcb, 0x9b, 0x4e, 0xc2, 0x30, 0xcf, 0xbf, 0xc3, 0xc9, 0xbf, 0xfb,
+  0x46, 0xe0, 0x27, 0x86, 0x0c, 0x00, 0x00,
+};
+
+// joy.js: 12736 bytes originales, 8018 minimizado, 2566 con gzip
+static const uint8_t joy_js_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x59, 0x6d, 0x6f, 0xda, 0x4a,
+  0x16, 0xfe, 0x9e, 0x5f, 0x31, 0xa2, 0xd2, 0x5d, 0x68, 0x0d, 0x18, 0x92, 0x74, 0x6f, 0x93, 0xa6,
+  0x7b, 0x09, 0x38, 0xc5, 0xbb, 0x04, 0x10, 0x90, 0xa6, 0x68, 0xb5, 0x1f, 0x0c, 0x1e, 0xc0, 0xad,
+  0xf1, 0x70, 0x6d, 0x13, 0x9a, 0xdb, 0xdb, 0xff, 0xbe, 0xcf, 0x19, 0x8f, 0xdf, 0xc0, 0xd0, 0x48,
+  0xab, 0xfd, 0xb0, 0xd2, 0x56, 0x95, 0x60, 0x66, 0xce, 0x79, 0xce, 0xcb, 0x3c, 0x67, 0xe6, 0x0c,
+  0xa9, 0xbf, 0x3e, 0x7b, 0xcd, 0xfa, 0xd6, 0x9a, 0xb3, 0xe4, 0xdf, 0x15, 0xfb, 0x22, 0x9e, 0x6b,
+  0x5f, 0x02, 0x2c, 0xfc, 0x66, 0x6d, 0xc3, 0x95, 0xf0, 0x93, 0x85, 0x91, 0x98, 0x71, 0x3f, 0x14,
+  0xac, 0xf3, 0x97, 0xd6, 0xda, 0x99, 0x0b, 0x56, 0xbe, 0x15, 0xb3, 0x99, 0x08, 0xf9, 0xfc, 0x6b,
+  0x05, 0xd2, 0x3d, 0x2b, 0x08, 0xd9, 0x5a, 0xd8, 0xce, 0xc2, 0xe1, 0x36, 0xa4, 0xf5, 0x77, 0x35,
+  0xfd, 0x6d, 0xad, 0xa9, 0x37, 0x75, 0x2c, 0x8e, 0xf8, 0x93, 0x13, 0x38, 0xc2, 0x8b, 0xa1, 0x1a,
+  0xb5, 0x46, 0xed, 0xed, 0x19, 0x59, 0xbf, 0x97, 0x1a, 0x73, 0x2b, 0xa4, 0xd5, 0xae, 0x13, 0x84,
+  0xc2, 0x7f, 0xbe, 0xc2, 0x7c, 0xc7, 0x0a, 0x53, 0xaf, 0x3e, 0x71, 0x3f, 0xd1, 0xbe, 0x8f, 0x4d,
+  0xdc, 0x3e, 0xd3, 0xb0, 0xc3, 0x83, 0xb9, 0xef, 0x6c, 0x48, 0x1d, 0x5a, 0x64, 0xae, 0xaa, 0xbf,
+  0xad, 0xea, 0xef, 0x22, 0x13, 0x10, 0xd8, 0xf7, 0xfa, 0xce, 0xf9, 0x06, 0x65, 0x33, 0x08, 0xb6,
+  0x9c, 0xbd, 0x6a, 0xe8, 0xcc, 0xf2, 0x6c, 0x7c, 0x36, 0x12, 0xe5, 0x8b, 0x6a, 0x53, 0x97, 0xca,
+  0x97, 0x05, 0xca, 0x6d, 0xe1, 0xfb, 0x7c, 0x1e, 0x5e, 0xb1, 0xc9, 0x4e, 0xb0, 0x20, 0x74, 0xe6,
+  0x5f, 0x03, 0xe6, 0x78, 0xcc, 0x62, 0xbe, 0xd8, 0x69, 0x2c, 0x5c, 0x59, 0x1e, 0x26, 0x20, 0xff,
+  0x9b, 0xeb, 0x58, 0xeb, 0xdd, 0xbb, 0xcb, 0xf3, 0x0b, 0xb6, 0x40, 0x06, 0xc3, 0x15, 0x67, 0xc1,
+  0x76, 0xb9, 0xe4, 0x41, 0xce, 0xcf, 0x8b, 0xaa, 0x7e, 0xce, 0xf2, 0xff, 0x8e, 0x1a, 0x34, 0xbd,
+  0x90, 0xfb, 0x9e, 0xe5, 0x8e, 0x2c, 0xdb, 0xd9, 0x06, 0x6c, 0xb7, 0xe2, 0x1e, 0x9b, 0xc3, 0xde,
+  0x92, 0x47, 0xe8, 0xce, 0x1f, 0x9c, 0x89, 0x05, 0x9b, 0x5b, 0xde, 0x93, 0x15, 0xe4, 0x5c, 0x79,
+  0xb2, 0xbc, 0xc0, 0x75, 0x36, 0x48, 0xdf, 0x09, 0x57, 0x1a, 0x55, 0xfd, 0xaf, 0x32, 0xea, 0x8b,
+  0x22, 0x27, 0x5c, 0x11, 0x20, 0x59, 0x6f, 0xd9, 0xec, 0x99, 0x39, 0xeb, 0x8d, 0xcb, 0xd7, 0xdc,
+  0x0b, 0x1d, 0x6f, 0x89, 0xb8, 0x3d, 0xbe, 0x63, 0x1b, 0xcb, 0x07, 0x85, 0xe0, 0x1e, 0x99, 0x0b,
+  0x78, 0x28, 0x6d, 0x2c, 0xb6, 0xde, 0x9c, 0x2c, 0x58, 0xae, 0x13, 0x3e, 0x93, 0x67, 0x20, 0x93,
+  0xa8, 0xfa, 0x3c, 0xdc, 0xfa, 0x1e, 0xc9, 0xe9, 0x6c, 0x23, 0x02, 0x27, 0xf1, 0xa1, 0xf1, 0xae,
+  0xda, 0x68, 0x54, 0x1b, 0xbf, 0x4a, 0x1f, 0xce, 0x8f, 0xfb, 0x70, 0xc9, 0xe6, 0x51, 0x46, 0x90,
+  0x76, 0x3b, 0xa6, 0x0d, 0xd0, 0x0d, 0x62, 0x9f, 0xed, 0xd0, 0xca, 0x1e, 0x64, 0x13, 0x60, 0x04,
+  0xda, 0x3c, 0x92, 0xe1, 0x11, 0x5f, 0x8b, 0x27, 0x30, 0x02, 0xbc, 0x60, 0xaf, 0x2e, 0x00, 0xab,
+  0x0c, 0xb8, 0x88, 0xd5, 0x0b, 0x7d, 0x61, 0x6f, 0xe7, 0x58, 0x25, 0x96, 0xf8, 0x9c, 0xd8, 0x89,
+  0x81, 0xd8, 0x70, 0x3f, 0xb2, 0xbc, 0x73, 0xc2, 0x15, 0xa2, 0xd9, 0xce, 0x57, 0xcc, 0x06, 0xc5,
+  0xe7, 0x3c, 0x28, 0x32, 0xdd, 0x38, 0x62, 0x3a, 0x47, 0xc5, 0x0b, 0x56, 0x65, 0x7d, 0xb1, 0x63,
+  0x7f, 0x17, 0xcf, 0x63, 0x22, 0x16, 0xdb, 0x09, 0xff, 0xab, 0x24, 0x97, 0xf7, 0x9c, 0xe4, 0x8a,
+  0xc6, 0x94, 0xdd, 0x8d, 0xb5, 0xe4, 0x1a, 0xf3, 0x44, 0xc8, 0x84, 0x07, 0x47, 0xad, 0x90, 0xe9,
+  0x9a, 0x2e, 0xeb, 0x69, 0x82, 0xd5, 0x7b, 0x73, 0xc2, 0x7a, 0x70, 0xc6, 0x43, 0xc6, 0xca, 0x18,
+  0x54, 0xe4, 0x0a, 0x96, 0x9c, 0x80, 0x2d, 0x1c, 0x97, 0x33, 0x7c, 0x62, 0xd3, 0x42, 0x4a, 0x1c,
+  0xa1, 0x25, 0x26, 0x87, 0xbe, 0xf8, 0x42, 0xb9, 0x2d, 0xaf, 0xc2, 0x70, 0x13, 0x5c, 0xd5, 0xeb,
+  0x4b, 0xc4, 0xb7, 0x9d, 0xd5, 0xe6, 0x62, 0x5d, 0x9f, 0xc5, 0xc5, 0x5e, 0x8f, 0xc5, 0x2b, 0x35,
+  0x42, 0x6d, 0x8b, 0xcd, 0xb3, 0xef, 0x2c, 0x57, 0xd0, 0x9a, 0x57, 0x28, 0xf6, 0xcb, 0x53, 0x07,
+  0x45, 0x4d, 0xba, 0x32, 0xe4, 0xfe, 0xda, 0x09, 0x64, 0x49, 0xc3, 0x95, 0x15, 0xf7, 0x39, 0x98,
+  0xb5, 0xf4, 0x2d, 0x70, 0xdc, 0xd6, 0xd8, 0xc2, 0xe7, 0x11, 0x97, 0x57, 0x96, 0x4f, 0x61, 0x02,
+  0x49, 0xe6, 0x00, 0x87, 0x00, 0x6d, 0xf6, 0x2c, 0xb4, 0x1c, 0x2f, 0x62, 0xdf, 0x1c, 0xb6, 0x01,
+  0x27, 0xc3, 0x00, 0x50, 0x20, 0x16, 0xe1, 0xce, 0xf2, 0xb9, 0xdc, 0x2d, 0x2b, 0x08, 0xc4, 0xdc,
+  0xc1, 0x29, 0x62, 0x33, 0x5b, 0xcc, 0xb7, 0x44, 0xd9, 0x68, 0xcf, 0x28, 0x03, 0x01, 0x2b, 0x53,
+  0xe0, 0xa5, 0xb1, 0xd2, 0x28, 0x55, 0xa4, 0x19, 0x9b, 0x5b, 0x2e, 0xf0, 0x54, 0x92, 0xe3, 0x45,
+  0xb9, 0xcb, 0x62, 0x1b, 0x4a, 0x02, 0xf8, 0x8e, 0x64, 0x98, 0x46, 0x44, 0x71, 0xb7, 0x36, 0xf9,
+  0x11, 0x2f, 0xbb, 0xce, 0xda, 0x51, 0x36, 0x48, 0x5d, 0x26, 0x85, 0xf8, 0x00, 0xe0, 0x6d, 0x80,
+  0x38, 0xc8, 0x5b, 0x2d, 0x3a, 0x22, 0xe9, 0x93, 0xcb, 0xe0, 0x36, 0xdb, 0x99, 0xeb, 0x04, 0x2b,
+  0x0d, 0xe4, 0x25, 0xf0, 0xd9, 0x36, 0xc4, 0x64, 0x40, 0x93, 0x72, 0xff, 0x34, 0x8a, 0xa5, 0x8e,
+  0xba, 0x0d, 0xb8, 0x4b, 0xae, 0x01, 0xc3, 0x81, 0xf7, 0x6a, 0xe3, 0x62, 0x0f, 0xa5, 0x14, 0xd9,
+  0xd9, 0x50, 0x62, 0x43, 0x95, 0x2a, 0x59, 0xfe, 0xbb, 0x95, 0x58, 0xe7, 0xa3, 0x71, 0xc8, 0xa7,
+  0x05, 0xca, 0x10, 0x66, 0xb9, 0xd4, 0xb2, 0x51, 0xb6, 0x42, 0x5a, 0x95, 0xbb, 0x8f, 0x19, 0x59,
+  0xc1, 0xc2, 0x75, 0xc5, 0x8e, 0x02, 0x9c, 0x0b, 0xd4, 0x1a, 0xc5, 0x15, 0x5c, 0x25, 0x1c, 0xb3,
+  0x66, 0xa8, 0x1a, 0x19, 0x52, 0xb4, 0xf9, 0xe0, 0x22, 0x3c, 0x8e, 0xfc, 0xa0, 0xbd, 0xd8, 0xa4,
+  0x5b, 0xac, 0x96, 0x82, 0x95, 0xe5, 0xba, 0x6c, 0xc6, 0x55, 0xe6, 0x60, 0x9a, 0xc8, 0x9d, 0x8b,
+  0xca, 0x27, 0x1f, 0x82, 0x10, 0x3c, 0x70, 0x2c, 0x17, 0xa4, 0xf7, 0xa5, 0xd1, 0xfd, 0x68, 0x23,
+  0x0e, 0x4d, 0xba, 0x06, 0x1b, 0x0f, 0xee, 0x26, 0x8f, 0xad, 0x91, 0xc1, 0xcc, 0x31, 0x1b, 0x8e,
+  0x06, 0x9f, 0xcc, 0x8e, 0xd1, 0x61, 0xa5, 0xd6, 0x18, 0xe3, 0x92, 0xc6, 0x1e, 0xcd, 0x49, 0x77,
+  0xf0, 0x30, 0x61, 0x90, 0x18, 0xb5, 0xfa, 0x93, 0x29, 0x1b, 0xdc, 0xb1, 0x56, 0x7f, 0xca, 0xfe,
+  0x61, 0xf6, 0x3b, 0x1a, 0x33, 0x3e, 0x0f, 0x47, 0xc6, 0x78, 0xcc, 0x06, 0x23, 0x80, 0x99, 0xf7,
+  0xc3, 0x9e, 0x69, 0x60, 0xd6, 0xec, 0xb7, 0x7b, 0x0f, 0x1d, 0xb3, 0xff, 0x91, 0xdd, 0x42, 0xb3,
+  0x3f, 0x40, 0x21, 0x99, 0xa8, 0x20, 0xc0, 0x4e, 0x06, 0xd2, 0xa4, 0x02, 0x33, 0x8d, 0x31, 0xc1,
+  0xdd, 0x1b, 0xa3, 0x76, 0x17, 0xc3, 0xd6, 0xad, 0xd9, 0x33, 0x27, 0x53, 0x0d, 0x50, 0x77, 0xe6,
+  0xa4, 0x4f, 0xb8, 0x77, 0x83, 0x11, 0x6b, 0xb1, 0x61, 0x6b, 0x34, 0x31, 0xdb, 0x0f, 0xbd, 0xd6,
+  0x88, 0x0d, 0x1f, 0x46, 0xc3, 0xc1, 0xd8, 0x80, 0x0b, 0x1d, 0x00, 0xf7, 0xcd, 0xfe, 0xdd, 0x08,
+  0x76, 0x8c, 0x7b, 0xa3, 0x3f, 0xa9, 0xc1, 0x2e, 0xe6, 0x98, 0xf1, 0x09, 0x03, 0x36, 0xee, 0xb6,
+  0x7a, 0x3d, 0x32, 0x06, 0xb4, 0xd6, 0x03, 0x62, 0x18, 0x91, 0x97, 0xac, 0x3d, 0x18, 0x4e, 0x47,
+  0xe6, 0xc7, 0xee, 0x84, 0x75, 0x07, 0xbd, 0x8e, 0x81, 0xc9, 0x5b, 0x03, 0xde, 0xb5, 0x6e, 0x7b,
+  0x46, 0x64, 0x0c, 0xa1, 0xb5, 0x7b, 0x2d, 0xf3, 0x5e, 0x63, 0x9d, 0xd6, 0x7d, 0xeb, 0xa3, 0x21,
+  0xb5, 0x06, 0xc0, 0xa1, 0x08, 0x49, 0x30, 0xf2, 0x91, 0x3d, 0x76, 0x0d, 0x9a, 0x24, 0x9b, 0x2d,
+  0xfc, 0x6f, 0x4f, 0xcc, 0x41, 0x9f, 0x82, 0x69, 0x0f, 0xfa, 0x93, 0x11, 0x86, 0x1a, 0x62, 0x1d,
+  0x4d, 0x12, 0xe5, 0x47, 0x73, 0x6c, 0x68, 0xac, 0x35, 0x32, 0xc7, 0x94, 0x96, 0xbb, 0xd1, 0xe0,
+  0x9e, 0xc2, 0xa4, 0xc4, 0x42, 0x67, 0x20, 0x61, 0xa0, 0xd9, 0x37, 0x22, 0x1c, 0x4a, 0x7a, 0x7e,
+  0x6f, 0x20, 0x42, 0xe3, 0x87, 0xb1, 0x91, 0x40, 0xb2, 0x8e, 0xd1, 0xea, 0x01, 0x6d, 0x4c, 0xca,
+  0x51, 0xa0, 0xb1, 0x38, 0x36, 0xb7, 0x7e, 0xf6, 0x64, 0xf9, 0xe9, 0xa1, 0x74, 0xc3, 0xca, 0xf1,
+  0x65, 0x52, 0x06, 0x13, 0xa9, 0xfa, 0xb9, 0xaf, 0xa5, 0xb7, 0x4e, 0x50, 0x39, 0xfb, 0x7e, 0x96,
+  0x8e, 0x20, 0x9f, 0x19, 0xfc, 0xf9, 0x27, 0xfb, 0xfe, 0xe3, 0x5a, 0x02, 0x86, 0x4e, 0x88, 0xa3,
+  0x0f, 0x68, 0xe1, 0xf3, 0x86, 0x83, 0x52, 0xa9, 0x54, 0x4d, 0x2d, 0xdd, 0xdc, 0xb0, 0xd2, 0xd6,
+  0xb3, 0xf9, 0x02, 0x16, 0xec, 0x12, 0xfb, 0x1b, 0x2b, 0xa1, 0x17, 0x92, 0xb7, 0x7c, 0x09, 0x3d,
+  0xcb, 0xbe, 0x7c, 0x45, 0x3b, 0xdb, 0x39, 0x36, 0xce, 0xff, 0x42, 0x48, 0xb5, 0x74, 0x00, 0xa9,
+  0xe7, 0x91, 0xa4, 0x18, 0x90, 0x56, 0x5c, 0x56, 0x51, 0x21, 0x54, 0xbc, 0xf6, 0x33, 0xac, 0x48,
+  0x0e, 0x60, 0x8e, 0xea, 0x15, 0xee, 0x1c, 0xd7, 0x6d, 0x0b, 0x17, 0x65, 0x55, 0x88, 0x5b, 0x20,
+  0x76, 0x98, 0x81, 0x57, 0xba, 0xde, 0x6a, 0xe9, 0xfa, 0x5e, 0x02, 0x0e, 0x54, 0x33, 0x56, 0x7b,
+  0xd0, 0x7d, 0x3c, 0x9e, 0x98, 0x02, 0xb1, 0x03, 0xab, 0xcd, 0x62, 0x6b, 0x89, 0x4a, 0xc6, 0xda,
+  0x18, 0x57, 0xf4, 0x57, 0xfe, 0x82, 0x28, 0x73, 0x82, 0x85, 0x71, 0x9e, 0x9f, 0x1f, 0x8d, 0x33,
+  0xa3, 0x0c, 0xdb, 0xfc, 0xdb, 0x8b, 0x22, 0x2d, 0x10, 0xfb, 0x59, 0xa4, 0x07, 0x2a, 0x19, 0x6b,
+  0x3f, 0x8d, 0xb4, 0x50, 0x10, 0x16, 0x0b, 0x42, 0xfd, 0x55, 0x3f, 0x08, 0xb5, 0x40, 0x1b, 0xc6,
+  0xa9, 0x6b, 0x1b, 0xc9, 0xa6, 0x6d, 0x22, 0xda, 0x9c, 0xb2, 0x51, 0x6c, 0xbb, 0x48, 0xee, 0x20,
+  0xd8, 0xd0, 0x47, 0xa3, 0x73, 0x75, 0x5a, 0xad, 0x12, 0x15, 0xab, 0x98, 0x7d, 0x69, 0xc7, 0xb5,
+  0x0e, 0x8b, 0xf1, 0x0d, 0x5e, 0x5b, 0xf2, 0xd0, 0x88, 0xfa, 0xcf, 0xdb, 0x67, 0xd3, 0x4e, 0xcf,
+  0x03, 0xa5, 0x16, 0xb5, 0xbf, 0x59, 0x85, 0xb9, 0xcf, 0xd1, 0x03, 0x28, 0x9d, 0x72, 0x29, 0x12,
+  0x28, 0x41, 0x3c, 0xfa, 0x56, 0x73, 0x6c, 0x48, 0xcb, 0x7a, 0xbe, 0x3e, 0x73, 0x16, 0xe5, 0xb4,
+  0x6c, 0xf5, 0x0a, 0xfb, 0xce, 0xe2, 0x02, 0xcf, 0xba, 0x53, 0x9b, 0xbb, 0x0e, 0xb0, 0xe4, 0xf6,
+  0x5c, 0xb3, 0x1f, 0xa4, 0x95, 0xa9, 0x50, 0xa9, 0x96, 0x54, 0x73, 0x81, 0x5e, 0x57, 0xae, 0x91,
+  0xa2, 0xf2, 0x20, 0xb6, 0x21, 0x3f, 0x13, 0xbf, 0x12, 0x88, 0xe8, 0xcb, 0xf5, 0x59, 0x0e, 0xca,
+  0xda, 0x6c, 0xb8, 0x67, 0xb7, 0x57, 0x8e, 0x8b, 0x1c, 0x48, 0x85, 0x38, 0x01, 0x10, 0xc1, 0x4e,
+  0xde, 0x28, 0x14, 0xa4, 0xab, 0x1d, 0xcd, 0x94, 0x4b, 0x4d, 0xbb, 0xa4, 0x84, 0x36, 0x68, 0x64,
+  0x02, 0x4e, 0x81, 0xeb, 0xd7, 0xac, 0x5e, 0x67, 0xb7, 0x42, 0xb8, 0xe8, 0x3e, 0x1b, 0x37, 0x53,
+  0x5c, 0xc2, 0x55, 0xa6, 0xdf, 0xf4, 0x45, 0x04, 0xe6, 0xf8, 0xc8, 0xe2, 0x02, 0xed, 0x99, 0x37,
+  0xa7, 0x93, 0xb3, 0xc9, 0xf0, 0x5e, 0xb3, 0xc2, 0x55, 0x6d, 0x68, 0x46, 0x40, 0x4e, 0xfe, 0x51,
+  0x02, 0x66, 0x64, 0x63, 0xaa, 0x96, 0x73, 0xc3, 0x7a, 0xb3, 0xf2, 0xa6, 0xa1, 0x57, 0x2a, 0xf5,
+  0x66, 0xa4, 0xbc, 0xb6, 0xbe, 0xdd, 0xa3, 0x87, 0x88, 0x0f, 0xf9, 0x3d, 0xac, 0x37, 0xec, 0x32,
+  0x12, 0x8b, 0x79, 0x99, 0xd8, 0x38, 0x10, 0x3c, 0xd7, 0x55, 0xec, 0x92, 0x40, 0x9f, 0x21, 0x92,
+  0xcb, 0x6c, 0x9d, 0x35, 0xb3, 0xeb, 0xd3, 0x74, 0x5d, 0xe5, 0x38, 0x11, 0x48, 0xde, 0x0f, 0x5d,
+  0xe1, 0x3b, 0x7f, 0x50, 0xb2, 0x51, 0x88, 0xe8, 0xa7, 0x86, 0x22, 0x38, 0x04, 0x6d, 0xe8, 0xa7,
+  0x95, 0xfa, 0x7c, 0x49, 0x3c, 0x3c, 0x01, 0xf9, 0x9a, 0x55, 0x1b, 0x7b, 0x18, 0x78, 0xe8, 0x22,
+  0x1d, 0x45, 0x66, 0x13, 0x5f, 0x0f, 0xec, 0xe6, 0x74, 0xf6, 0xac, 0x1e, 0xe0, 0xa5, 0x36, 0xe5,
+  0xab, 0xe7, 0xf3, 0x8d, 0x4a, 0x5a, 0x66, 0x6e, 0xaa, 0xe6, 0xa6, 0xb2, 0x20, 0x4a, 0xf0, 0x99,
+  0xde, 0x37, 0xe8, 0xca, 0xfc, 0xb0, 0x44, 0x2d, 0x5b, 0x52, 0x5a, 0xf1, 0x17, 0x55, 0x5c, 0x74,
+  0x0d, 0x2b, 0x67, 0x2d, 0xdb, 0x36, 0x9e, 0x30, 0xd5, 0x43, 0x4f, 0xcb, 0xc1, 0xd7, 0x72, 0x29,
+  0x83, 0xa1, 0xe1, 0xcd, 0x32, 0xa1, 0xe1, 0x98, 0x86, 0x68, 0xf7, 0x2d, 0x37, 0xe0, 0x69, 0x41,
+  0x1e, 0xd1, 0x25, 0xd7, 0x52, 0x55, 0x22, 0xce, 0x4b, 0x35, 0x51, 0x28, 0xa9, 0xa2, 0xe1, 0xd9,
+  0xa9, 0xde, 0x8f, 0x33, 0x8e, 0x2f, 0xa7, 0xdc, 0x5e, 0x0b, 0x74, 0xee, 0xb6, 0xd8, 0x79, 0x12,
+  0xe1, 0x9e, 0x46, 0x1d, 0x8c, 0x5e, 0x60, 0x5a, 0x6a, 0x26, 0x4e, 0x4b, 0xcd, 0x17, 0x3a, 0x2d,
+  0x35, 0xb7, 0x9b, 0x54, 0xef, 0x61, 0x93, 0x75, 0xd9, 0xf6, 0xad, 0x9d, 0xa1, 0x6a, 0xa2, 0x8c,
+  0x19, 0x1a, 0xc7, 0x3f, 0x0e, 0xd0, 0x38, 0xee, 0x95, 0x58, 0x5e, 0x90, 0xa2, 0x8c, 0x4e, 0x82,
+  0xda, 0x8c, 0x2f, 0x1d, 0x6f, 0x88, 0x3a, 0x26, 0xf1, 0x78, 0xd2, 0xf2, 0xe7, 0x65, 0xc5, 0x05,
+  0x2d, 0xae, 0x14, 0x6d, 0xaf, 0xf8, 0x34, 0xbc, 0x32, 0xf3, 0x87, 0x42, 0x26, 0x1c, 0x85, 0xe3,
+  0x66, 0xee, 0xc4, 0x83, 0xdb, 0x2c, 0x15, 0x0b, 0xe4, 0x2d, 0x33, 0x0e, 0x9f, 0x65, 0x4b, 0x56,
+  0x70, 0xf7, 0xec, 0x8b, 0x96, 0x65, 0xf0, 0xb9, 0xe0, 0xd2, 0xa8, 0x8f, 0x05, 0x07, 0xfe, 0x46,
+  0x34, 0x7f, 0x9f, 0x3f, 0x34, 0xe8, 0x8c, 0x56, 0xfc, 0xcf, 0x9e, 0x42, 0xea, 0x34, 0x57, 0x3a,
+  0x6f, 0xf6, 0x75, 0x3e, 0xe4, 0x8e, 0x80, 0x14, 0x63, 0xef, 0x6c, 0xa8, 0x96, 0xb3, 0x98, 0x15,
+  0x05, 0x1a, 0x95, 0xd6, 0x31, 0x3f, 0xa6, 0xc7, 0xfd, 0x98, 0x1e, 0xf7, 0x43, 0x35, 0x7c, 0x09,
+  0xc8, 0xfe, 0x69, 0x51, 0xe0, 0x49, 0x76, 0xbb, 0x23, 0xef, 0x35, 0xa5, 0xac, 0xed, 0x1d, 0xac,
+  0xa7, 0x36, 0x9b, 0xce, 0x8a, 0xa5, 0x4f, 0x17, 0x48, 0x8c, 0x17, 0x5d, 0xb3, 0xa4, 0x69, 0xb9,
+  0x1f, 0x7d, 0x7c, 0xd0, 0x6d, 0x7b, 0xc8, 0xa7, 0xcb, 0xf8, 0x7b, 0x76, 0xb2, 0xa9, 0xeb, 0xc0,
+  0x04, 0x1e, 0x15, 0x83, 0xdc, 0xfc, 0x71, 0x28, 0x36, 0x65, 0x3d, 0xf5, 0x28, 0x6d, 0x33, 0x0b,
+  0xe4, 0x1a, 0xa9, 0x5c, 0xb6, 0x77, 0x49, 0x09, 0x84, 0x07, 0xbf, 0x1b, 0x33, 0x0d, 0xda, 0xf9,
+  0x85, 0xf2, 0x11, 0xee, 0x1e, 0xf4, 0x9c, 0xc7, 0xb8, 0x5b, 0x60, 0xfb, 0x27, 0xdc, 0xcd, 0x1e,
+  0x7f, 0x65, 0xfe, 0xa4, 0x8e, 0xce, 0xf4, 0x52, 0x6e, 0x14, 0x49, 0xd3, 0x36, 0xa6, 0xc2, 0xf2,
+  0x4b, 0x0d, 0x2a, 0xf4, 0xd9, 0xe1, 0x0b, 0x6b, 0xeb, 0x86, 0x8a, 0xf0, 0x09, 0x0e, 0x9a, 0x91,
+  0x06, 0xfb, 0xe5, 0x17, 0x16, 0xc9, 0x86, 0xf4, 0x5b, 0x4a, 0x28, 0xa1, 0x78, 0xf0, 0x4f, 0xfd,
+  0x5f, 0x6a, 0x42, 0x8a, 0xa9, 0x0e, 0x02, 0xb8, 0x09, 0xa1, 0x8f, 0x28, 0xd1, 0xef, 0x4e, 0xb8,
+  0x2b, 0x12, 0xba, 0x9d, 0x10, 0x8b, 0xae, 0x0f, 0xc5, 0x47, 0xb1, 0x58, 0x04, 0x3c, 0x1c, 0xe2,
+  0xf1, 0x2e, 0xc5, 0x97, 0xf4, 0x9b, 0x73, 0x2d, 0x14, 0x0f, 0x68, 0x63, 0xfc, 0xb6, 0x15, 0x20,
+  0x43, 0x51, 0xbb, 0x78, 0x3b, 0xe8, 0x4c, 0x4b, 0x19, 0x47, 0xaa, 0x09, 0xa3, 0x23, 0x84, 0x1e,
+  0x5f, 0x84, 0x89, 0xf9, 0xfd, 0xc5, 0x89, 0xd8, 0x64, 0xce, 0xf4, 0x23, 0x08, 0xca, 0x87, 0x17,
+  0xc0, 0xe5, 0x24, 0x15, 0x76, 0x42, 0x77, 0x97, 0x5b, 0xfe, 0x08, 0x77, 0x2c, 0xb1, 0x94, 0xea,
+  0x24, 0x53, 0xff, 0xda, 0x5e, 0x79, 0x5e, 0xff, 0xf4, 0xc8, 0xfe, 0x51, 0xb0, 0xdf, 0xb8, 0xa8,
+  0x8a, 0xb8, 0xa1, 0xcb, 0xac, 0x16, 0xb4, 0xcd, 0xd9, 0xcd, 0x4b, 0xee, 0xf4, 0xf4, 0x58, 0x88,
+  0x6f, 0xf4, 0xff, 0x5e, 0x08, 0x99, 0x00, 0x92, 0x7b, 0xf2, 0x25, 0xec, 0x4e, 0xae, 0xc6, 0x54,
+  0x78, 0x9f, 0xc5, 0x05, 0xcc, 0x2c, 0x26, 0xe2, 0xff, 0x79, 0xf7, 0x9f, 0xf0, 0x4e, 0x35, 0x1b,
+  0xff, 0x5b, 0xb4, 0xa3, 0x1f, 0x1b, 0x6b, 0x1f, 0x79, 0x18, 0x9f, 0xdb, 0x49, 0x3c, 0xb2, 0x2b,
+  0x50, 0x7f, 0x6f, 0xc8, 0x1a, 0x81, 0xd2, 0x75, 0xa2, 0xd5, 0x8d, 0x5f, 0x59, 0xa7, 0xd4, 0xe2,
+  0x17, 0x58, 0x46, 0x0f, 0xad, 0xf4, 0xe7, 0x63, 0x5a, 0x51, 0x3e, 0xf6, 0xc5, 0xa7, 0x27, 0xc5,
+  0xa7, 0x39, 0xf1, 0xa3, 0xd0, 0xe5, 0x86, 0xae, 0xbf, 0x8e, 0xfb, 0x13, 0xbc, 0xd4, 0x54, 0xc6,
+  0x2b, 0xf5, 0xdc, 0x3d, 0x5f, 0x01, 0xc3, 0xe5, 0x9f, 0x16, 0x64, 0x86, 0x52, 0xd8, 0xa3, 0x2e,
+  0x94, 0xb3, 0xb8, 0xd3, 0x04, 0x77, 0xba, 0x8f, 0xfb, 0xba, 0xda, 0x38, 0x86, 0xdd, 0x71, 0xfc,
+  0x0c, 0xba, 0x04, 0xa7, 0x26, 0x01, 0x04, 0xc2, 0xcd, 0x84, 0x95, 0x52, 0x49, 0xbd, 0xeb, 0xe3,
+  0x57, 0x10, 0xe6, 0xf6, 0xc3, 0x88, 0x24, 0x9e, 0xd4, 0x93, 0x25, 0x16, 0xc8, 0xf8, 0x23, 0x49,
+  0x98, 0xac, 0x7f, 0xb8, 0x39, 0xf1, 0x06, 0xc2, 0xbd, 0x97, 0x08, 0xbe, 0x3f, 0xf1, 0x20, 0x8a,
+  0xb2, 0x10, 0x3b, 0xd9, 0x2e, 0x11, 0xa5, 0xb2, 0x46, 0xde, 0x1f, 0xb7, 0x91, 0x57, 0xed, 0x1f,
+  0xa8, 0x7e, 0x78, 0xa9, 0xd5, 0x71, 0xac, 0x9a, 0x26, 0xe7, 0xfd, 0xa9, 0x67, 0xa5, 0x3a, 0x22,
+  0x63, 0x80, 0x1b, 0xe9, 0x78, 0x1e, 0xf2, 0xb1, 0x94, 0x39, 0x91, 0xd4, 0xf4, 0x9b, 0x64, 0x7e,
+  0xcf, 0xd8, 0x87, 0x53, 0xaf, 0xd4, 0x17, 0x18, 0x33, 0x8e, 0x18, 0x33, 0x94, 0x31, 0xc5, 0xb2,
+  0x68, 0x25, 0xc7, 0x9a, 0xf1, 0x86, 0xcb, 0xe3, 0xe5, 0x80, 0x37, 0x81, 0x5a, 0x88, 0x69, 0x13,
+  0x8f, 0xe5, 0xaf, 0x0f, 0xbe, 0xd8, 0xe2, 0x72, 0x04, 0x65, 0xe3, 0x9f, 0x23, 0x82, 0xdf, 0xd1,
+  0x48, 0xc9, 0x6f, 0x1b, 0xb1, 0x3b, 0xa8, 0x0e, 0x34, 0x98, 0x15, 0xf6, 0x86, 0xe5, 0xd7, 0x33,
+  0xac, 0xa2, 0xf5, 0x0a, 0x1e, 0xd6, 0xf9, 0x5e, 0x99, 0x82, 0x8e, 0xac, 0x7e, 0x60, 0x64, 0x8a,
+  0x3c, 0x8b, 0xbd, 0xc0, 0xf8, 0x3a, 0x8d, 0x4b, 0xce, 0xca, 0x48, 0xa1, 0xf5, 0x6f, 0x04, 0x2f,
+  0xa6, 0x73, 0x52, 0x1f, 0x00, 0x00,
+};
+
+// app.js: 16607 bytes originales, 10673 minimizado, 3581 con gzip
+static const uint8_t app_js_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5a, 0x7b, 0x6f, 0xdb, 0x38,
+  0x12, 0xff, 0xdf, 0x9f, 0x82, 0x29, 0x8a, 0x4a, 0xba, 0xc8, 0x8a, 0xed, 0x6e, 0x8b, 0xc2, 0x5e,
+  0x27, 0x48, 0xec, 0xf4, 0xb6, 0x8b, 0x74, 0x5b, 0x34, 0xd9, 0x17, 0x72, 0x41, 0x4b, 0x4b, 0xb4,
+  0xad, 0x46, 0x16, 0x5d, 0x89, 0xb2, 0xe3, 0xa4, 0xfe, 0xee, 0x37, 0x33, 0xd4, 0xdb, 0x76, 0xe2,
+  0x2e, 0x0e, 0x38, 0x14, 0xb0, 0x24, 0x72, 0x38, 0x9c, 0xc7, 0x6f, 0x1e, 0x64, 0xb3, 0xe0, 0x11,
+  0x73, 0x55, 0x30, 0x98, 0xf2, 0x30, 0x14, 0x41, 0xcc, 0xfa, 0xec, 0xda, 0x18, 0x47, 0x7c, 0x26,
+  0x62, 0xff, 0x5e, 0x18, 0xb6, 0xf1, 0x2d, 0xe1, 0x81, 0xaf, 0x56, 0xf0, 0x36, 0x0e, 0x78, 0x3c,
+  0x85, 0x67, 0x3c, 0x17, 0xc2, 0x83, 0x67, 0x28, 0x63, 0x25, 0xe7, 0x38, 0x20, 0xa2, 0x85, 0xcc,
+  0x9e, 0x73, 0x1e, 0x66, 0xaf, 0x2f, 0xe1, 0xc5, 0xe5, 0x11, 0xfc, 0x7a, 0x91, 0xbf, 0x10, 0x77,
+  0xd9, 0xcb, 0xca, 0xb8, 0xe9, 0x35, 0x16, 0x7a, 0xdf, 0x4b, 0xe9, 0xde, 0x0a, 0x05, 0xbb, 0x86,
+  0x49, 0x10, 0xd8, 0x34, 0x22, 0xbe, 0xc1, 0x67, 0x2b, 0x7d, 0x0f, 0x71, 0xee, 0x61, 0x4d, 0x5f,
+  0x9f, 0x14, 0x7e, 0x5c, 0xdf, 0xd0, 0xc7, 0x40, 0x26, 0x34, 0xd7, 0xea, 0x35, 0xc6, 0x49, 0xe8,
+  0x2a, 0x5f, 0x86, 0x7a, 0x18, 0xd4, 0x70, 0x95, 0x69, 0x35, 0x1e, 0x68, 0x8b, 0x25, 0x6a, 0x14,
+  0x8a, 0x25, 0xfb, 0x53, 0x8c, 0xf4, 0x5e, 0xa6, 0xb1, 0x8c, 0xbb, 0x47, 0x47, 0x06, 0x3b, 0x64,
+  0x9e, 0x74, 0x93, 0x19, 0x6c, 0xe1, 0x04, 0xd2, 0xe5, 0xc8, 0xc1, 0x99, 0x82, 0x4e, 0x21, 0x28,
+  0x0f, 0x93, 0x46, 0xf7, 0x4d, 0xe7, 0xc8, 0xb0, 0x7a, 0x8d, 0x65, 0xec, 0x8c, 0xfc, 0x90, 0x47,
+  0xab, 0xab, 0xd5, 0x5c, 0x00, 0x37, 0x83, 0x47, 0x11, 0x5f, 0x8d, 0x92, 0xf1, 0x58, 0x44, 0x06,
+  0x4d, 0xcb, 0x50, 0xce, 0x45, 0x08, 0x53, 0x99, 0x24, 0xa6, 0xc5, 0x1e, 0x2a, 0xda, 0x2d, 0xe3,
+  0x1e, 0x5b, 0xa7, 0xb4, 0x6e, 0x20, 0x63, 0xf1, 0x18, 0x31, 0x9a, 0xa2, 0xc7, 0x62, 0xa1, 0xae,
+  0xfc, 0x99, 0x90, 0x89, 0x32, 0x0b, 0xbd, 0x6c, 0xd6, 0x69, 0xb5, 0x5a, 0x56, 0xc1, 0x0c, 0xfc,
+  0x14, 0xf3, 0x49, 0x85, 0x9d, 0xc8, 0x74, 0xf7, 0x52, 0xd5, 0x87, 0x5c, 0xf1, 0x3f, 0x7c, 0xb1,
+  0x34, 0x85, 0xe3, 0xc1, 0x2b, 0xa8, 0x34, 0x96, 0x11, 0x33, 0x91, 0xc4, 0x27, 0x0b, 0xc2, 0xe3,
+  0x90, 0xbd, 0x61, 0x3f, 0xf7, 0x99, 0xe7, 0x8c, 0x56, 0x4a, 0x5c, 0x88, 0x70, 0xa2, 0xa6, 0x34,
+  0xdc, 0x67, 0x6f, 0x32, 0x76, 0x31, 0x39, 0xc6, 0x73, 0x26, 0x42, 0xfd, 0xee, 0x87, 0xea, 0x65,
+  0xc7, 0xc4, 0x65, 0x3f, 0xd9, 0x4c, 0x45, 0x89, 0x00, 0xa6, 0xfe, 0x98, 0x99, 0xa9, 0xcf, 0xae,
+  0x81, 0xf6, 0x86, 0x1d, 0xf4, 0xfb, 0x2c, 0x09, 0x3d, 0x31, 0xf6, 0x43, 0xe1, 0x21, 0x17, 0xed,
+  0x43, 0x67, 0x9e, 0xc4, 0x53, 0x73, 0x2e, 0x22, 0x90, 0x62, 0xc6, 0x43, 0x57, 0x38, 0xa1, 0x5c,
+  0x82, 0x11, 0x9a, 0xac, 0xbc, 0xba, 0x60, 0x88, 0x4b, 0x02, 0x92, 0x88, 0x1d, 0xb3, 0x57, 0x2d,
+  0x2b, 0x85, 0x82, 0x13, 0x4f, 0xfd, 0x31, 0x38, 0xba, 0xd7, 0xf0, 0x44, 0x20, 0x94, 0xa8, 0xac,
+  0xee, 0x35, 0xd6, 0xf8, 0x0f, 0x1f, 0x65, 0x74, 0xbc, 0x45, 0x60, 0x9b, 0x9e, 0xcd, 0xe4, 0x78,
+  0x0c, 0x28, 0x9a, 0xda, 0x6c, 0xc1, 0x83, 0x54, 0x32, 0x8d, 0x3b, 0x33, 0x7d, 0x3b, 0x64, 0x6d,
+  0x8b, 0x1d, 0x1f, 0x1f, 0x23, 0xbe, 0x3c, 0x27, 0xd6, 0x2a, 0xbf, 0x31, 0x69, 0x5d, 0xdb, 0xaa,
+  0x8f, 0x21, 0x39, 0xf2, 0xcb, 0x26, 0xde, 0x85, 0xaa, 0xfd, 0x3a, 0x9d, 0xe8, 0xd8, 0x6c, 0xce,
+  0xa3, 0x58, 0xc0, 0x98, 0x89, 0xbb, 0xe5, 0xf6, 0xca, 0x59, 0x80, 0x25, 0x35, 0xe9, 0x4f, 0x59,
+  0x00, 0xe4, 0x34, 0x99, 0x4e, 0x7a, 0xf8, 0x06, 0x04, 0xdc, 0xb0, 0xdb, 0x86, 0xfe, 0xa9, 0x06,
+  0x4d, 0xd6, 0x6e, 0xb5, 0x6e, 0x2a, 0x16, 0x88, 0x45, 0xe8, 0x01, 0x90, 0x54, 0x24, 0x03, 0x13,
+  0x51, 0x9e, 0xab, 0x4f, 0xc1, 0x38, 0x05, 0xee, 0xa5, 0x4c, 0xe0, 0xf8, 0xe0, 0xba, 0xbb, 0x0f,
+  0x63, 0xa2, 0xd4, 0xa2, 0x50, 0xcc, 0x1d, 0x1e, 0x16, 0xae, 0xd6, 0x88, 0x7d, 0xf1, 0x02, 0x17,
+  0x1f, 0x03, 0x92, 0x76, 0x22, 0x0f, 0x3f, 0x4e, 0x31, 0x6c, 0xce, 0x28, 0x6c, 0xcc, 0x37, 0x96,
+  0xe6, 0x98, 0x3b, 0xa4, 0x55, 0xb8, 0x43, 0x6b, 0x4d, 0xac, 0x1d, 0x94, 0xd8, 0x04, 0x50, 0xd2,
+  0x2a, 0x0b, 0x95, 0x01, 0xc9, 0x04, 0xec, 0x32, 0x16, 0xca, 0x9d, 0x9a, 0x9b, 0x01, 0x2c, 0x23,
+  0x7f, 0xe2, 0x87, 0x18, 0xbe, 0x47, 0xae, 0xd6, 0xf4, 0x04, 0x04, 0xea, 0x63, 0xb4, 0x67, 0x71,
+  0xfd, 0x02, 0x36, 0xa1, 0x01, 0xbd, 0x19, 0x02, 0x85, 0x64, 0xc6, 0xd4, 0x74, 0xc1, 0x63, 0x8c,
+  0x40, 0xc3, 0xe8, 0x55, 0xad, 0x36, 0xc4, 0x49, 0xf3, 0xce, 0x66, 0xab, 0x4c, 0xc5, 0x5b, 0xb1,
+  0x02, 0xc2, 0x3b, 0x64, 0x68, 0x23, 0xb3, 0x95, 0xb6, 0x0a, 0x0d, 0x03, 0xee, 0x73, 0x6e, 0x16,
+  0x8b, 0x84, 0x4a, 0xa2, 0x10, 0xdc, 0x54, 0xda, 0x00, 0xc8, 0x0a, 0x8b, 0x62, 0x94, 0x75, 0x6a,
+  0x46, 0xdd, 0xdb, 0x92, 0xed, 0xd7, 0xdb, 0x4c, 0xb9, 0xc5, 0x8d, 0x59, 0x12, 0x06, 0x00, 0xde,
+  0xd5, 0x56, 0xbc, 0x79, 0x6c, 0xc5, 0x0a, 0x57, 0xac, 0xfe, 0xe7, 0x5e, 0xd1, 0xd2, 0x90, 0x1f,
+  0xc8, 0x88, 0x2f, 0xf4, 0x66, 0x34, 0xb0, 0x4a, 0xdd, 0xa2, 0x23, 0x09, 0x4a, 0x09, 0x0f, 0xcc,
+  0x22, 0x5b, 0xa6, 0x96, 0x11, 0x01, 0x66, 0xa3, 0x6c, 0x2b, 0x48, 0x4a, 0xe7, 0x81, 0xc0, 0xd7,
+  0xb3, 0xd5, 0x3b, 0xcf, 0x34, 0x40, 0xd8, 0x58, 0x71, 0x85, 0xf9, 0x9b, 0x72, 0x97, 0xc6, 0x36,
+  0xa5, 0x8d, 0xc0, 0x77, 0x85, 0x69, 0x39, 0xb1, 0x8c, 0x54, 0xc1, 0x95, 0xdb, 0x6c, 0x84, 0x79,
+  0x58, 0x3b, 0x8b, 0x71, 0x08, 0x9f, 0x11, 0x64, 0xd9, 0x34, 0x0b, 0x89, 0xc0, 0x82, 0xfd, 0xc0,
+  0x30, 0xa1, 0x88, 0x7e, 0xb9, 0x7a, 0x7f, 0x91, 0x25, 0x0a, 0x8d, 0xff, 0x13, 0x66, 0xfc, 0x79,
+  0xc9, 0x0c, 0xd6, 0x65, 0xc6, 0x2f, 0x57, 0x57, 0x1f, 0x99, 0x61, 0x81, 0x0e, 0x85, 0x73, 0x61,
+  0xc6, 0x9d, 0x79, 0x47, 0x31, 0x6a, 0x66, 0xc6, 0x59, 0x2a, 0x83, 0x45, 0x36, 0x9b, 0x09, 0xcf,
+  0xe7, 0x21, 0x67, 0x38, 0x15, 0x5f, 0xe7, 0x73, 0x90, 0x76, 0xda, 0x37, 0x8e, 0x92, 0x6f, 0xfd,
+  0x3b, 0xe1, 0x99, 0x6d, 0x8b, 0x78, 0xcc, 0x62, 0xda, 0xc1, 0x28, 0x85, 0xa2, 0x2e, 0x7f, 0x50,
+  0x1c, 0xdb, 0x54, 0x14, 0x76, 0xdb, 0x0b, 0x75, 0x28, 0xe0, 0x87, 0x79, 0xd9, 0x30, 0x30, 0x6c,
+  0x6b, 0x63, 0x2d, 0xbb, 0x65, 0xa0, 0x11, 0x6a, 0xa1, 0x90, 0x21, 0x98, 0xad, 0xff, 0x21, 0x46,
+  0xb3, 0x68, 0xdf, 0x2b, 0xc5, 0x02, 0x7c, 0x3b, 0xb5, 0xec, 0xb8, 0x3d, 0x2f, 0xfe, 0x6f, 0x33,
+  0xc4, 0x54, 0xf0, 0x48, 0x8d, 0x04, 0x57, 0x94, 0x1e, 0xda, 0x86, 0x86, 0x20, 0x98, 0xf6, 0x55,
+  0x2b, 0xb3, 0x78, 0xda, 0x59, 0x68, 0x44, 0x29, 0x81, 0x70, 0x53, 0xd1, 0x8a, 0xfa, 0x93, 0x52,
+  0xba, 0xc8, 0x27, 0x2e, 0xa7, 0x98, 0x9e, 0xf7, 0x42, 0x6b, 0xbe, 0xc6, 0x48, 0x01, 0x77, 0x80,
+  0x88, 0xcb, 0x12, 0x47, 0x1d, 0x79, 0x39, 0xb5, 0x33, 0x9e, 0xc7, 0xd5, 0x2a, 0x0b, 0xb0, 0xaa,
+  0xce, 0x22, 0x72, 0xe0, 0x69, 0x13, 0xc4, 0x8a, 0xa9, 0xdb, 0x51, 0x3a, 0x77, 0x3b, 0xf2, 0xd5,
+  0xd1, 0xc6, 0xf4, 0x02, 0xbc, 0x28, 0x22, 0x4d, 0x01, 0xef, 0xa1, 0x27, 0x1d, 0x96, 0xa2, 0x8f,
+  0x1d, 0x36, 0x8c, 0x4b, 0xec, 0x00, 0x6b, 0x4b, 0xa8, 0x2b, 0xa4, 0x6c, 0xc8, 0xa8, 0xf9, 0x8b,
+  0xeb, 0xf3, 0x38, 0x48, 0x56, 0xdf, 0x32, 0x0e, 0x4d, 0xe3, 0xae, 0xa9, 0x97, 0xb0, 0x61, 0x59,
+  0x63, 0xee, 0x07, 0x31, 0x1f, 0x0b, 0x8c, 0x1f, 0x87, 0xbd, 0x3d, 0x7d, 0x77, 0x71, 0x79, 0xfa,
+  0xf6, 0xbc, 0x8b, 0x25, 0x96, 0x7b, 0x92, 0xcd, 0xa1, 0xb1, 0x19, 0xf3, 0x40, 0x71, 0xe6, 0x41,
+  0x41, 0x94, 0x50, 0x26, 0x3d, 0x19, 0x17, 0x92, 0x97, 0x18, 0xcd, 0x24, 0x79, 0x8b, 0xd8, 0xbc,
+  0xff, 0xf0, 0xc7, 0xbb, 0xf7, 0xef, 0xce, 0x7f, 0xbb, 0xfa, 0xc0, 0xa0, 0x8d, 0xab, 0x0a, 0xa1,
+  0xe9, 0x8a, 0x3c, 0x5f, 0x9f, 0x59, 0x91, 0x91, 0xb6, 0xcd, 0x2c, 0x71, 0xe6, 0x6e, 0xdb, 0xcc,
+  0x34, 0x0b, 0xe4, 0xf5, 0x16, 0xd8, 0x94, 0x3b, 0x58, 0x82, 0xc2, 0x12, 0xf2, 0xb1, 0x5c, 0x3a,
+  0xe7, 0x0b, 0x80, 0xcb, 0xa5, 0x4c, 0x22, 0x57, 0x14, 0xd0, 0x20, 0x68, 0x65, 0x2d, 0x6e, 0x89,
+  0xe2, 0x71, 0xdc, 0x0b, 0x24, 0x8c, 0x51, 0x00, 0x11, 0x3b, 0xdc, 0xf3, 0x68, 0xe1, 0x85, 0x1f,
+  0x2b, 0x01, 0x28, 0x33, 0x0d, 0x4c, 0x9c, 0xd0, 0xfa, 0xef, 0xe8, 0x28, 0x7f, 0xbd, 0xfc, 0xf0,
+  0x9b, 0x43, 0x1d, 0xcd, 0x96, 0x7e, 0xf2, 0x96, 0xc1, 0x16, 0xd4, 0xeb, 0xe5, 0xfa, 0x5c, 0xdf,
+  0x62, 0xdb, 0xe2, 0xc1, 0xa3, 0xf7, 0x74, 0x24, 0xdc, 0x16, 0xf8, 0x67, 0xdf, 0xbf, 0x13, 0x6d,
+  0xbf, 0x44, 0xcd, 0x41, 0x9e, 0x85, 0x48, 0x17, 0x40, 0x23, 0x08, 0xf1, 0xeb, 0x87, 0x89, 0xc8,
+  0x92, 0xb4, 0xa3, 0xa8, 0x43, 0xc7, 0x54, 0xe6, 0x4e, 0x85, 0x7b, 0x3b, 0x92, 0x50, 0xee, 0x30,
+  0x71, 0xd3, 0x97, 0x40, 0xe9, 0x0f, 0x0e, 0xb4, 0x24, 0x98, 0x24, 0xd8, 0xc6, 0xaa, 0x88, 0x87,
+  0x13, 0xa1, 0x97, 0x40, 0x16, 0x48, 0x44, 0x2e, 0xf8, 0xba, 0x51, 0x0b, 0x6b, 0x18, 0xda, 0x6d,
+  0xbe, 0x48, 0xf0, 0xd9, 0x0f, 0xd9, 0xaf, 0x1a, 0xb3, 0xd8, 0x64, 0xc3, 0xb3, 0x3c, 0x4c, 0xf1,
+  0x8a, 0xe3, 0xf8, 0x52, 0x9e, 0xc8, 0x22, 0x15, 0xe7, 0xd2, 0xf7, 0xde, 0x76, 0x59, 0x4b, 0x2a,
+  0xd4, 0x52, 0xd9, 0xc2, 0xf7, 0x84, 0x3c, 0x1d, 0x41, 0x3d, 0xcc, 0xcf, 0x61, 0x34, 0xf4, 0x7b,
+  0x14, 0x54, 0x07, 0xb0, 0x24, 0xe4, 0xc7, 0x33, 0x1a, 0xf9, 0x18, 0xc9, 0x91, 0x38, 0x4d, 0x0b,
+  0x51, 0xce, 0xeb, 0x02, 0xf0, 0x13, 0xba, 0xab, 0xea, 0xe2, 0x61, 0x24, 0xe7, 0x73, 0xf2, 0x41,
+  0xab, 0x3a, 0x72, 0x25, 0x15, 0x0f, 0x6a, 0x27, 0x39, 0x9a, 0xff, 0x81, 0x04, 0x4a, 0xf4, 0x59,
+  0xc1, 0xdf, 0x51, 0xb1, 0x0d, 0x2d, 0x96, 0xaf, 0xcb, 0xad, 0x59, 0x95, 0xb4, 0xaf, 0x65, 0xc5,
+  0x7c, 0xd0, 0xc4, 0x7c, 0x51, 0x9e, 0xcd, 0x2b, 0x71, 0x2b, 0xaf, 0xc4, 0x96, 0xce, 0x74, 0xd4,
+  0x45, 0x6e, 0xa8, 0x42, 0x39, 0x97, 0x8e, 0xd0, 0xd8, 0xad, 0x7b, 0x3e, 0xa6, 0xa0, 0x4a, 0xac,
+  0x17, 0xa6, 0x33, 0x15, 0xe4, 0x5e, 0x55, 0xf4, 0xcd, 0xb9, 0x8d, 0xca, 0x5c, 0xc1, 0xb2, 0x35,
+  0x03, 0xf6, 0xf6, 0xa9, 0x6e, 0x81, 0x96, 0xfe, 0x44, 0xc5, 0xd4, 0x54, 0xa9, 0x38, 0x6d, 0xb3,
+  0x88, 0x0b, 0x0d, 0xa5, 0xef, 0x96, 0xa3, 0xa6, 0x22, 0x2c, 0x3a, 0x86, 0xa8, 0xd4, 0x08, 0x45,
+  0xce, 0xd7, 0x18, 0x9b, 0x08, 0xec, 0x85, 0x6a, 0x64, 0x14, 0xe6, 0x35, 0x7f, 0xbf, 0xe7, 0x6a,
+  0xea, 0xcc, 0xf8, 0x1d, 0x56, 0x71, 0xcf, 0x81, 0x83, 0xe9, 0xe7, 0x24, 0x66, 0x47, 0xd4, 0x9f,
+  0x40, 0x47, 0xb5, 0xf5, 0xd0, 0x07, 0xda, 0x03, 0x05, 0x96, 0xfc, 0x92, 0xd3, 0x11, 0xb2, 0x0e,
+  0xa8, 0x04, 0x3a, 0x96, 0x8f, 0xc9, 0x6b, 0x6b, 0xd3, 0x8e, 0xba, 0x8b, 0xf5, 0x67, 0x13, 0x9b,
+  0x7d, 0x9d, 0x0b, 0xf8, 0x85, 0x4a, 0xee, 0x65, 0x06, 0x55, 0x18, 0x19, 0x47, 0x7f, 0x35, 0xf1,
+  0x24, 0x0d, 0xf0, 0x98, 0xcd, 0xbb, 0xcc, 0xfc, 0x8f, 0x77, 0x68, 0x1d, 0xf9, 0x8e, 0xb8, 0x13,
+  0xae, 0x49, 0xb4, 0x76, 0x7a, 0xb4, 0x05, 0x3a, 0x62, 0xd6, 0x04, 0x8c, 0x6f, 0xa3, 0xc3, 0x06,
+  0x0b, 0xe9, 0xf0, 0xf7, 0xa4, 0x38, 0xd4, 0xc1, 0xe7, 0x75, 0xfb, 0xc6, 0x02, 0xd0, 0xb4, 0x34,
+  0xf6, 0x2a, 0xb1, 0x02, 0x5d, 0x16, 0xd2, 0x1f, 0x57, 0x23, 0x08, 0x7b, 0x9f, 0xcc, 0x7a, 0x99,
+  0x5f, 0x0f, 0x35, 0xe7, 0x66, 0x95, 0x12, 0x8e, 0x71, 0x55, 0xff, 0xa7, 0x18, 0xdb, 0x4d, 0xbc,
+  0x6e, 0xd4, 0x82, 0x15, 0x08, 0x4b, 0x82, 0x41, 0x54, 0x5b, 0xec, 0xf7, 0x4f, 0x17, 0x4e, 0x24,
+  0x16, 0xf2, 0x56, 0x7c, 0x18, 0x7d, 0x85, 0x54, 0x00, 0xdf, 0xc5, 0x6c, 0xba, 0x9f, 0x0e, 0x7f,
+  0xa4, 0x74, 0x21, 0xa1, 0xa9, 0x12, 0x25, 0x16, 0x9b, 0xb3, 0x40, 0x8e, 0xcc, 0x6b, 0xb4, 0xf8,
+  0x8d, 0x0d, 0x70, 0xc1, 0x1c, 0x0a, 0x45, 0xcd, 0x9f, 0x81, 0xcf, 0x8f, 0x70, 0xd4, 0x00, 0xc0,
+  0x60, 0x2c, 0xce, 0x26, 0x8e, 0x0c, 0x03, 0xc9, 0xbd, 0xca, 0x8d, 0x47, 0xea, 0x1e, 0xc0, 0xc0,
+  0xf6, 0x23, 0x2d, 0x4a, 0x0b, 0xbe, 0x03, 0xe3, 0x21, 0x49, 0xb3, 0x9a, 0x6c, 0x8e, 0x75, 0xbf,
+  0x9b, 0xd9, 0xaf, 0xc8, 0x41, 0x40, 0xdb, 0x6b, 0x54, 0x82, 0x0b, 0x1c, 0x63, 0xe3, 0xb0, 0xee,
+  0xe6, 0xb4, 0x38, 0x71, 0xe4, 0x66, 0x01, 0x06, 0x2a, 0x6e, 0x02, 0xea, 0x17, 0xf0, 0xb5, 0x88,
+  0xce, 0xa1, 0xad, 0x84, 0xa6, 0x32, 0xbd, 0x2a, 0x80, 0xc6, 0x1c, 0xf7, 0xab, 0xdc, 0x9b, 0xc0,
+  0x84, 0xbe, 0x39, 0x79, 0xc9, 0x7e, 0x46, 0x02, 0xf8, 0x38, 0x3c, 0xb4, 0x48, 0x74, 0x58, 0x78,
+  0xed, 0xdf, 0x50, 0x56, 0x69, 0xbf, 0x44, 0x2d, 0x68, 0x00, 0xbd, 0x9e, 0x0e, 0xb6, 0xca, 0x83,
+  0x9d, 0x6d, 0x94, 0x2f, 0x33, 0xca, 0xac, 0xd8, 0x33, 0xbf, 0xd7, 0x48, 0xdf, 0x9a, 0xed, 0x4d,
+  0xa9, 0x2f, 0x95, 0x9c, 0xe7, 0x3d, 0x43, 0x91, 0xd1, 0xad, 0x52, 0x76, 0x77, 0x38, 0xfe, 0x9a,
+  0x99, 0x7f, 0xcb, 0x19, 0xbf, 0x57, 0xc7, 0x4c, 0x6b, 0xdb, 0x0e, 0xd0, 0x21, 0xeb, 0x40, 0x4b,
+  0xa2, 0x20, 0x37, 0xbf, 0xde, 0xb8, 0x57, 0xe9, 0x55, 0x28, 0x3b, 0x61, 0x01, 0xcf, 0x06, 0x68,
+  0xaf, 0xf4, 0xea, 0x21, 0x10, 0x51, 0x79, 0xea, 0x13, 0x98, 0x9b, 0x8f, 0x02, 0x71, 0x49, 0x65,
+  0x13, 0x53, 0x4f, 0xe1, 0x24, 0xd8, 0xa7, 0x7c, 0xfa, 0x48, 0xef, 0x0c, 0xd3, 0x76, 0xa7, 0xc6,
+  0x73, 0x43, 0x2f, 0xa0, 0xcc, 0xf2, 0x24, 0xf0, 0x41, 0x90, 0xc6, 0xfe, 0x24, 0xe4, 0x41, 0x17,
+  0x67, 0x1c, 0xfd, 0xbe, 0x99, 0xd5, 0xa2, 0x0c, 0x9b, 0x11, 0xc1, 0x00, 0xf8, 0x44, 0xce, 0x48,
+  0x7a, 0x2b, 0x2c, 0x39, 0x9f, 0x68, 0x28, 0x2b, 0x9b, 0xe0, 0xa9, 0x54, 0x12, 0x3a, 0xb8, 0xd0,
+  0x81, 0xc7, 0x7c, 0xfd, 0xea, 0xd5, 0xcb, 0xd7, 0x16, 0x01, 0xa6, 0x56, 0xd2, 0xe6, 0xc9, 0x4c,
+  0x3b, 0x28, 0xcb, 0xac, 0xc4, 0xcc, 0xc1, 0x87, 0xb9, 0x21, 0x84, 0x88, 0x33, 0x57, 0xc2, 0xab,
+  0xe3, 0xc9, 0xb0, 0xd6, 0xf3, 0x2d, 0x50, 0x2e, 0x98, 0xa1, 0x2e, 0x45, 0xdb, 0x1e, 0x77, 0x84,
+  0x6a, 0x54, 0x5c, 0x95, 0x81, 0x7c, 0xe9, 0x47, 0xa6, 0xd2, 0x24, 0x92, 0xcb, 0x70, 0x53, 0xe6,
+  0x3c, 0x69, 0x17, 0x2b, 0xd8, 0xbf, 0xf0, 0xde, 0xaa, 0xca, 0x12, 0xc3, 0x99, 0x38, 0xe0, 0xc9,
+  0x8c, 0x68, 0xe3, 0x64, 0x44, 0x77, 0xa1, 0x98, 0xed, 0x31, 0x42, 0x80, 0x40, 0x1b, 0x85, 0xc8,
+  0x10, 0x41, 0x44, 0x05, 0xd4, 0x0b, 0x4d, 0xd0, 0x6b, 0x10, 0xcb, 0x7e, 0xce, 0x53, 0x6b, 0x83,
+  0xb7, 0x5f, 0x64, 0xac, 0xe5, 0xd4, 0x0f, 0x04, 0x44, 0x3e, 0x1e, 0xf2, 0xb2, 0xba, 0x1f, 0xe6,
+  0xe5, 0x70, 0x57, 0x60, 0xa6, 0x15, 0x1f, 0x08, 0x7f, 0x66, 0x10, 0x2e, 0x23, 0x30, 0xe9, 0xad,
+  0x66, 0x8c, 0x69, 0x1b, 0x56, 0x03, 0xb4, 0xfc, 0x70, 0xe2, 0x8c, 0x23, 0x39, 0x1b, 0x4c, 0x79,
+  0x34, 0x90, 0x9e, 0x70, 0xf8, 0x7c, 0x1e, 0xac, 0x4c, 0xdd, 0x9f, 0x54, 0x74, 0x21, 0xb6, 0xc0,
+  0xcc, 0x4a, 0xdd, 0x3c, 0xc3, 0xca, 0x80, 0x30, 0x83, 0x3a, 0xdb, 0xd4, 0x37, 0xa3, 0xdb, 0x8b,
+  0x03, 0x05, 0x00, 0x01, 0x58, 0xeb, 0x83, 0x02, 0x1d, 0xb2, 0x9f, 0x7a, 0x45, 0x9b, 0x9a, 0x42,
+  0x18, 0x6f, 0xd6, 0x31, 0xed, 0x65, 0x05, 0x64, 0x86, 0xe5, 0xa3, 0x50, 0x02, 0xd6, 0xe0, 0x75,
+  0x00, 0x12, 0x1d, 0x93, 0x7e, 0x99, 0x46, 0xe9, 0xe1, 0x9b, 0xf2, 0xc2, 0x46, 0x84, 0x97, 0xca,
+  0x20, 0xa9, 0x43, 0xb7, 0x1c, 0x29, 0x3b, 0x9b, 0x55, 0xf9, 0x5a, 0x69, 0x91, 0xec, 0x35, 0x2a,
+  0x92, 0xa6, 0xb3, 0x99, 0xdf, 0x5c, 0x39, 0x5f, 0xfd, 0xe9, 0xab, 0xa9, 0x1f, 0xa2, 0x7f, 0x4b,
+  0xd6, 0x46, 0x1f, 0x36, 0x75, 0xfe, 0xcb, 0xc0, 0xac, 0xc1, 0x9d, 0x35, 0x9a, 0x1b, 0x83, 0x3b,
+  0x4b, 0x39, 0x9a, 0xe3, 0x57, 0xb9, 0x6a, 0xa7, 0xa0, 0x84, 0xd7, 0x4b, 0xe5, 0xbb, 0xb7, 0xa6,
+  0xf1, 0x15, 0x06, 0x87, 0xfe, 0x22, 0xbb, 0xbf, 0xc1, 0xcf, 0x77, 0x7e, 0x38, 0x4f, 0xd4, 0x47,
+  0x19, 0xff, 0xf5, 0x48, 0x27, 0xf8, 0x0c, 0x29, 0x81, 0xc6, 0xbf, 0x87, 0x7d, 0xc4, 0x5f, 0xcf,
+  0xca, 0xeb, 0xd3, 0xe5, 0x7f, 0xef, 0xbd, 0xfc, 0xef, 0xf2, 0xf2, 0xa1, 0x1f, 0x09, 0x1a, 0x7d,
+  0x6a, 0x79, 0x4e, 0x58, 0x5e, 0xfd, 0xa4, 0xcc, 0x15, 0x51, 0x9f, 0x14, 0xb1, 0x22, 0x99, 0x3e,
+  0x8e, 0x3f, 0xb1, 0x82, 0x88, 0x9e, 0xed, 0xbc, 0x24, 0x7a, 0xa8, 0x99, 0x58, 0x67, 0x96, 0x3e,
+  0xfa, 0xc6, 0xf9, 0xb7, 0xa0, 0x21, 0x6a, 0x02, 0x6d, 0xf6, 0xaa, 0xf5, 0x14, 0x93, 0xcc, 0xce,
+  0x9b, 0x3c, 0xfe, 0xde, 0x97, 0x47, 0x6e, 0xc3, 0x1a, 0x0f, 0x18, 0xdf, 0x97, 0x45, 0x5d, 0x85,
+  0xbd, 0xe5, 0xaf, 0xcb, 0xbd, 0xb7, 0xd0, 0x64, 0xe2, 0xda, 0x62, 0x1a, 0xdb, 0x87, 0x41, 0x71,
+  0xcb, 0x9c, 0xe7, 0x85, 0x92, 0xe4, 0x56, 0xe9, 0x3f, 0x11, 0x4a, 0x72, 0x59, 0x25, 0xc6, 0x29,
+  0x1a, 0x3a, 0x1f, 0x39, 0x64, 0x02, 0xbc, 0x94, 0x62, 0xcf, 0x94, 0xaf, 0x02, 0xf1, 0xac, 0xcb,
+  0x10, 0x00, 0x31, 0xc6, 0x55, 0xe7, 0x99, 0xcd, 0x9e, 0xf1, 0x44, 0xc9, 0x4f, 0x14, 0xa1, 0x57,
+  0x72, 0x20, 0x50, 0x16, 0x20, 0x19, 0x73, 0x3c, 0x10, 0xaf, 0x7b, 0x59, 0x44, 0x76, 0xb6, 0x45,
+  0x64, 0x07, 0x23, 0xd2, 0x2e, 0x76, 0x29, 0xed, 0xba, 0x77, 0x70, 0x76, 0xb6, 0x06, 0x67, 0x67,
+  0xdf, 0xe0, 0xec, 0x6c, 0x0d, 0xce, 0xce, 0xbe, 0xc1, 0xd9, 0xd9, 0x16, 0x9c, 0x9d, 0x27, 0x65,
+  0xae, 0x88, 0xfa, 0xa4, 0x88, 0x15, 0xc9, 0xf6, 0x09, 0xce, 0xce, 0x3e, 0xc1, 0xd9, 0xd9, 0x16,
+  0x9c, 0x9d, 0x1f, 0x0c, 0xce, 0xce, 0x96, 0xe0, 0xec, 0xfc, 0x60, 0x70, 0x76, 0xb6, 0x04, 0x67,
+  0xe7, 0xc7, 0x82, 0xb3, 0x53, 0x57, 0x61, 0x6f, 0xf9, 0xeb, 0x72, 0xef, 0x2d, 0x74, 0x2d, 0x38,
+  0x3b, 0x5b, 0x83, 0xb3, 0xb8, 0x68, 0xda, 0xb8, 0xd5, 0x19, 0x7e, 0x78, 0x9f, 0x36, 0x01, 0x17,
+  0x70, 0x98, 0xc1, 0xff, 0x00, 0x6f, 0x94, 0x8f, 0x33, 0x79, 0x9b, 0x37, 0x32, 0xcf, 0xe0, 0x33,
+  0x10, 0x8a, 0x0d, 0x7a, 0xf1, 0xd2, 0xc7, 0xb2, 0x77, 0x46, 0x37, 0x4c, 0x30, 0xea, 0xf2, 0x58,
+  0x14, 0x37, 0x53, 0xdd, 0x41, 0xff, 0x2c, 0xbb, 0x99, 0x3a, 0x69, 0x77, 0xa1, 0xfd, 0x49, 0xeb,
+  0x3c, 0x91, 0xe9, 0xab, 0xa8, 0x2e, 0xbd, 0xc7, 0x22, 0x80, 0x93, 0x57, 0x13, 0x2c, 0xae, 0x17,
+  0xa5, 0x5d, 0x5f, 0x99, 0x7c, 0x94, 0x28, 0x25, 0xc3, 0x8c, 0x3e, 0x19, 0xcd, 0x7c, 0x85, 0xb4,
+  0x46, 0xdb, 0xc8, 0xe9, 0x3c, 0x31, 0xe6, 0x49, 0xa0, 0xba, 0x69, 0x1f, 0xb9, 0x6e, 0x40, 0x5f,
+  0x12, 0x2b, 0x36, 0xec, 0x7f, 0x79, 0xfe, 0xe0, 0xae, 0x2b, 0x97, 0xe1, 0xcf, 0x1f, 0xce, 0x1c,
+  0xdf, 0x5b, 0xd3, 0x55, 0xf8, 0xf3, 0x87, 0xc1, 0xfa, 0x4b, 0xd6, 0x48, 0x0f, 0xd3, 0x4e, 0xf5,
+  0xbc, 0x7f, 0xfc, 0x80, 0xcb, 0x65, 0x20, 0x9c, 0x40, 0x4e, 0xcc, 0x2f, 0x91, 0xf8, 0x96, 0xc0,
+  0x09, 0x9b, 0x29, 0xc9, 0x9e, 0x3f, 0x0c, 0xd7, 0x6c, 0xec, 0x87, 0x7e, 0x3c, 0x15, 0x1e, 0x9c,
+  0xad, 0x15, 0x57, 0x49, 0xdc, 0x85, 0xe1, 0x73, 0x47, 0xbf, 0xaf, 0xbf, 0x58, 0x6b, 0x2b, 0x2d,
+  0xfe, 0x6e, 0x7f, 0xd7, 0x1d, 0x46, 0x2f, 0x95, 0x4f, 0xf4, 0xcf, 0x60, 0x33, 0xb0, 0x54, 0xc0,
+  0xe3, 0x18, 0xfd, 0x81, 0xce, 0x31, 0x8d, 0xa9, 0xef, 0x79, 0x22, 0x34, 0xac, 0x35, 0xf8, 0x61,
+  0x83, 0x22, 0x12, 0x33, 0x09, 0x99, 0xb4, 0x4c, 0x34, 0xd9, 0xce, 0xc6, 0xf3, 0x63, 0x3c, 0x7c,
+  0x78, 0x86, 0x65, 0x37, 0xce, 0x9c, 0xec, 0xab, 0x7f, 0xd0, 0x82, 0x25, 0xd3, 0x9d, 0x7c, 0x77,
+  0xad, 0x6a, 0xc3, 0x2a, 0xbf, 0x6f, 0x9e, 0xd9, 0x03, 0x7b, 0x68, 0xc1, 0xda, 0x61, 0xff, 0x80,
+  0x5a, 0xcc, 0x83, 0xfe, 0xd0, 0xfa, 0xfe, 0x7d, 0xd8, 0x43, 0x58, 0x9c, 0xf7, 0x1a, 0x05, 0x06,
+  0xa0, 0x95, 0xd3, 0xe8, 0x38, 0x01, 0x93, 0xe6, 0x68, 0xb0, 0x1b, 0x83, 0xfe, 0xc1, 0xc1, 0xc0,
+  0xce, 0x07, 0xfa, 0x03, 0xab, 0xdb, 0x20, 0x0a, 0x72, 0xbd, 0x9d, 0x3e, 0x61, 0xd8, 0x6e, 0x0c,
+  0x5f, 0xbc, 0x38, 0x3f, 0xe8, 0xf7, 0x07, 0x27, 0x88, 0xbc, 0x6e, 0xe3, 0x00, 0xbe, 0x4d, 0x83,
+  0x0b, 0x57, 0xf3, 0xf6, 0xbd, 0x93, 0xc1, 0x89, 0x30, 0x17, 0x30, 0x33, 0xc6, 0x5f, 0x83, 0x4f,
+  0xca, 0x33, 0xe6, 0xd8, 0x54, 0xc0, 0x43, 0x98, 0xb1, 0x85, 0x3b, 0x08, 0xfc, 0x1a, 0xeb, 0x0f,
+  0x83, 0x2f, 0x47, 0x9f, 0x27, 0xdc, 0x0f, 0x4b, 0xe4, 0x63, 0xf3, 0x0e, 0x66, 0x04, 0xfd, 0x1a,
+  0x63, 0xee, 0x8a, 0xcf, 0x91, 0x70, 0xe5, 0x24, 0xc4, 0x3f, 0x15, 0x49, 0xa9, 0x60, 0xf7, 0xc1,
+  0xc9, 0xd4, 0x0c, 0x81, 0x62, 0x02, 0xbf, 0x96, 0xb5, 0x2e, 0x85, 0x15, 0x60, 0x24, 0x5a, 0x5d,
+  0x12, 0x9a, 0x65, 0x74, 0x1a, 0x04, 0xa6, 0xe1, 0xd0, 0x5f, 0x43, 0x18, 0x96, 0x03, 0x47, 0xeb,
+  0x73, 0x8e, 0xc1, 0x42, 0x26, 0xc7, 0xbf, 0x92, 0x80, 0xaa, 0xd3, 0x37, 0xd1, 0x8a, 0x02, 0x22,
+  0x08, 0xaa, 0x1f, 0x30, 0xf8, 0x0d, 0x3a, 0x77, 0x6b, 0xbd, 0x06, 0x89, 0x35, 0x1c, 0x35, 0x72,
+  0x35, 0xaa, 0xbe, 0xd4, 0x0f, 0x51, 0x67, 0xd6, 0x43, 0xda, 0x88, 0x9e, 0xa5, 0x97, 0x58, 0xeb,
+  0x2d, 0x24, 0x8f, 0xc9, 0x96, 0x46, 0x4c, 0x93, 0x13, 0x75, 0x49, 0xc8, 0x01, 0x48, 0xe5, 0x9b,
+  0xe0, 0xa0, 0xeb, 0x01, 0xa8, 0x7c, 0x63, 0x1f, 0xb4, 0x81, 0x37, 0x76, 0xb4, 0x1a, 0xb2, 0x5f,
+  0xfb, 0x3b, 0x2f, 0x2a, 0xd3, 0xcb, 0x61, 0xd0, 0xe0, 0xf6, 0x29, 0xa2, 0x26, 0x46, 0x24, 0xd8,
+  0x5f, 0x44, 0x48, 0x1e, 0xec, 0x26, 0x87, 0xef, 0x26, 0x94, 0xf7, 0x20, 0x40, 0xba, 0xd9, 0x6e,
+  0x3a, 0x25, 0x27, 0x93, 0x40, 0x34, 0x0b, 0x11, 0xc2, 0xdd, 0xb4, 0xe4, 0x5c, 0x11, 0xe2, 0xd1,
+  0x1a, 0x29, 0xe5, 0x6e, 0x4a, 0x72, 0x60, 0x89, 0xe9, 0x5c, 0x3b, 0x2d, 0x3d, 0xdd, 0xc7, 0x74,
+  0x3b, 0x60, 0x97, 0x6e, 0x0a, 0xec, 0x59, 0x71, 0x2b, 0xdb, 0x37, 0xe8, 0x52, 0x81, 0xe9, 0xb3,
+  0xbf, 0x01, 0xd1, 0xf3, 0x4d, 0xaf, 0x2e, 0x5d, 0x38, 0x7c, 0xb5, 0xd1, 0xcb, 0x87, 0x46, 0xf7,
+  0x4d, 0xdb, 0x40, 0x5f, 0x23, 0xe5, 0x17, 0x44, 0x80, 0x79, 0xbb, 0xc1, 0x4b, 0xce, 0x73, 0x56,
+  0x70, 0x4c, 0xa9, 0xa2, 0x08, 0xb7, 0x6e, 0x7c, 0xc5, 0x8b, 0x85, 0x2c, 0xe1, 0xf1, 0x39, 0xa0,
+  0x43, 0x9c, 0x7c, 0x76, 0x47, 0x90, 0xe4, 0x86, 0x5c, 0xa5, 0xb7, 0x4f, 0xeb, 0x2f, 0x9a, 0x39,
+  0x48, 0x23, 0xb7, 0xb0, 0x10, 0x7a, 0x6a, 0x56, 0x9d, 0xd2, 0x8e, 0x3f, 0xd3, 0x42, 0xc4, 0x99,
+  0x14, 0x10, 0x13, 0x25, 0x09, 0x7b, 0x8d, 0xb3, 0x13, 0x60, 0xd1, 0xfd, 0x66, 0x22, 0x83, 0xb0,
+  0xca, 0x60, 0x04, 0xc1, 0x02, 0xa3, 0xff, 0x08, 0x8e, 0x79, 0xcc, 0x4c, 0xb1, 0x68, 0x10, 0x3f,
+  0x4c, 0x06, 0x05, 0x20, 0xa3, 0xdd, 0xee, 0xc3, 0x7c, 0x00, 0x5a, 0xc5, 0x8f, 0x52, 0x50, 0x1e,
+  0x68, 0xc2, 0xa9, 0x3e, 0x99, 0x23, 0xb1, 0x7a, 0x04, 0x8b, 0x40, 0xe8, 0x0a, 0x3f, 0x80, 0xf3,
+  0x76, 0x46, 0x0f, 0x87, 0xc4, 0xaa, 0x6c, 0xa0, 0x6b, 0x04, 0x5c, 0xa2, 0xbc, 0xf8, 0xe9, 0x2c,
+  0xa4, 0x93, 0x50, 0x29, 0x07, 0xad, 0x33, 0xf1, 0x93, 0x47, 0x84, 0x13, 0x24, 0xfe, 0xe2, 0x51,
+  0x8a, 0xcf, 0x94, 0x2d, 0x0b, 0x79, 0x92, 0x0d, 0x79, 0x12, 0xe0, 0x91, 0xe4, 0xf2, 0x50, 0xbe,
+  0xc4, 0x74, 0x99, 0x4b, 0xb0, 0x7c, 0x84, 0x7f, 0x96, 0x26, 0x81, 0xc5, 0xdd, 0x6e, 0x32, 0xa0,
+  0x9a, 0x41, 0xf6, 0x2a, 0x84, 0x58, 0x6e, 0x08, 0xb1, 0x04, 0x0e, 0xcb, 0x5c, 0x08, 0xca, 0xb5,
+  0x98, 0x6a, 0x73, 0x21, 0x56, 0x4f, 0x84, 0xab, 0x27, 0x14, 0xa0, 0x05, 0xe5, 0xb8, 0x7f, 0x82,
+  0xb2, 0xc8, 0xda, 0x40, 0x7c, 0xfa, 0x08, 0x71, 0xfe, 0x87, 0x80, 0x20, 0xf0, 0xe9, 0x86, 0xc0,
+  0xa7, 0xb0, 0xfa, 0xd5, 0xcf, 0xa7, 0xba, 0x18, 0x41, 0xe2, 0xf7, 0xcd, 0x15, 0xa6, 0x42, 0xa8,
+  0x81, 0xe6, 0x3d, 0xbe, 0x20, 0xa0, 0x57, 0xb5, 0x55, 0x69, 0x4a, 0xce, 0x97, 0x9d, 0x98, 0x3c,
+  0x10, 0x10, 0xe6, 0xc6, 0xc7, 0x40, 0x40, 0xef, 0xc2, 0x74, 0xaf, 0xc3, 0x06, 0xef, 0xde, 0x32,
+  0x19, 0xb1, 0x40, 0x2e, 0x05, 0x5e, 0xc5, 0x41, 0xa3, 0x91, 0xe8, 0xf6, 0x4a, 0x00, 0xe8, 0x05,
+  0x13, 0x21, 0x54, 0x5c, 0xc0, 0x18, 0x53, 0x53, 0x3f, 0x66, 0x63, 0xc1, 0x31, 0x92, 0x0f, 0x08,
+  0x09, 0xd2, 0xf7, 0x58, 0x2a, 0x88, 0xd5, 0xc5, 0x2f, 0x73, 0x64, 0xae, 0x2c, 0xfb, 0x60, 0x95,
+  0x59, 0x16, 0x04, 0xc5, 0xca, 0x64, 0x67, 0x42, 0xa2, 0x94, 0xf7, 0xff, 0x1f, 0x29, 0xef, 0x2b,
+  0x52, 0xde, 0x5b, 0xf6, 0x7d, 0x11, 0x13, 0x53, 0x2d, 0x23, 0x28, 0xd2, 0x02, 0x12, 0xaa, 0xa5,
+  0x6b, 0x8c, 0xe8, 0xff, 0x02, 0xef, 0x90, 0x66, 0x50, 0xb1, 0x29, 0x00, 0x00,
+};
+
+// index.html: 5904 bytes originales, 3667 minimizado, 1029 con gzip
+static const uint8_t index_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x57, 0xe1, 0x72, 0xda, 0x38,
+  0x10, 0xfe, 0x9f, 0xa7, 0xd0, 0x69, 0xa6, 0x93, 0x76, 0x26, 0x60, 0x30, 0x81, 0xd2, 0x04, 0x7b,
+  0x26, 0xbd, 0x5e, 0x6f, 0x6e, 0x26, 0xd3, 0xeb, 0x95, 0xdc, 0x4d, 0xf8, 0x29, 0xac, 0x05, 0xab,
+  0x11, 0x96, 0x2b, 0x09, 0x12, 0xfa, 0x22, 0xf7, 0x40, 0x7d, 0xb1, 0x93, 0x64, 0x1b, 0xb0, 0x8d,
+  0x81, 0x26, 0xf7, 0x07, 0x64, 0xe9, 0xdb, 0xdd, 0x6f, 0x3f, 0xad, 0xe4, 0xf5, 0xe8, 0x17, 0x2a,
+  0x22, 0xbd, 0x4e, 0x01, 0xc5, 0x7a, 0xc1, 0xc3, 0xb3, 0x51, 0xf1, 0x07, 0x84, 0x9a, 0x3f, 0xcd,
+  0x34, 0x87, 0xf0, 0xee, 0xe6, 0xfd, 0xed, 0xcd, 0xc8, 0xcb, 0x1e, 0xce, 0x46, 0x0b, 0xd0, 0x04,
+  0x45, 0x31, 0x91, 0x0a, 0x74, 0x80, 0x97, 0x7a, 0xd6, 0x1a, 0xe2, 0x62, 0x3a, 0x21, 0x0b, 0x08,
+  0xf0, 0x8a, 0xc1, 0x63, 0x2a, 0xa4, 0xc6, 0x28, 0x12, 0x89, 0x86, 0xc4, 0xc0, 0x1e, 0x19, 0xd5,
+  0x71, 0x40, 0x61, 0xc5, 0x22, 0x68, 0xb9, 0x87, 0x0b, 0x96, 0x30, 0xcd, 0x08, 0x6f, 0xa9, 0x88,
+  0x70, 0x08, 0xba, 0x78, 0x13, 0xef, 0xb7, 0xf1, 0xe7, 0x9e, 0x8f, 0xfe, 0xfc, 0xc7, 0xbf, 0x1c,
+  0x74, 0xb6, 0x61, 0x39, 0x4b, 0x1e, 0x90, 0x04, 0x1e, 0x60, 0xa5, 0xd7, 0x1c, 0x54, 0x0c, 0x60,
+  0x02, 0xc4, 0x12, 0x66, 0xf9, 0x4c, 0x3b, 0xa2, 0xb4, 0x1b, 0xcd, 0x08, 0x69, 0x47, 0x4a, 0x59,
+  0x6f, 0x2a, 0x92, 0x2c, 0xd5, 0x48, 0xc9, 0x28, 0xc0, 0x5f, 0xc5, 0xba, 0x3d, 0x04, 0xda, 0xbb,
+  0xf4, 0x87, 0xa4, 0xfd, 0xd5, 0x2c, 0x8f, 0xbc, 0x6c, 0xd9, 0xe0, 0xbc, 0x3c, 0xdb, 0xa9, 0xa0,
+  0x6b, 0x4b, 0x82, 0x4c, 0x39, 0x20, 0x44, 0x38, 0x9b, 0x27, 0x01, 0x8e, 0x0c, 0x7d, 0x90, 0x18,
+  0x4d, 0x85, 0xa4, 0x20, 0x51, 0x80, 0x33, 0xa2, 0xd2, 0xfe, 0x50, 0x93, 0x1f, 0x57, 0x29, 0x31,
+  0xb0, 0x1e, 0x46, 0x8e, 0x44, 0x9e, 0xe9, 0x55, 0xaf, 0xf3, 0x0a, 0x57, 0x5c, 0xd8, 0x08, 0x4b,
+  0xad, 0x45, 0x82, 0x18, 0x0d, 0xf0, 0x1c, 0x74, 0x4b, 0x69, 0xc6, 0x39, 0x0e, 0x7f, 0x07, 0x8d,
+  0xc6, 0x76, 0x38, 0xf2, 0x32, 0x80, 0xe5, 0xa4, 0x69, 0x16, 0x41, 0x8a, 0xc7, 0x2c, 0xc2, 0xa0,
+  0x12, 0xa1, 0x6f, 0x22, 0x18, 0x08, 0x65, 0x2b, 0xe7, 0x4f, 0x69, 0x09, 0x64, 0xd1, 0xb2, 0x82,
+  0x13, 0x96, 0x58, 0xc6, 0x11, 0x27, 0x4a, 0x05, 0x98, 0x2d, 0xc8, 0x1c, 0xb6, 0xf3, 0x28, 0x66,
+  0x94, 0x42, 0x52, 0x98, 0xe6, 0xa0, 0x88, 0x0b, 0x05, 0xd8, 0x39, 0x72, 0xc3, 0x56, 0xe6, 0x0e,
+  0x87, 0x3f, 0xfe, 0x1d, 0x79, 0x06, 0x67, 0xd0, 0x6c, 0x31, 0xdf, 0x09, 0x84, 0x33, 0x59, 0xad,
+  0x9b, 0x7c, 0xfd, 0x38, 0xe3, 0xde, 0x3e, 0x49, 0x58, 0x92, 0x2e, 0x35, 0xb2, 0x25, 0x18, 0x60,
+  0x49, 0x92, 0x39, 0x6c, 0x88, 0xaf, 0xdc, 0xa3, 0xcc, 0x58, 0x29, 0x90, 0x2b, 0x81, 0xd1, 0x82,
+  0x19, 0x63, 0xbf, 0xd3, 0x31, 0x23, 0xf2, 0x14, 0xe0, 0x77, 0x76, 0xb4, 0x22, 0x7c, 0x69, 0x8c,
+  0xfb, 0xfd, 0x0e, 0x3e, 0x13, 0x89, 0x29, 0x4c, 0x63, 0x65, 0x0d, 0x12, 0xfa, 0xab, 0x49, 0x5a,
+  0x0a, 0xfe, 0xfa, 0xdc, 0x59, 0x9f, 0x5f, 0xe8, 0x98, 0xa9, 0xb6, 0x83, 0xbf, 0xb9, 0xc6, 0xbb,
+  0x94, 0x37, 0xdb, 0xe8, 0x57, 0x28, 0x77, 0xdf, 0x1e, 0xd9, 0x46, 0x2d, 0xe6, 0x73, 0xbe, 0x95,
+  0x6b, 0xac, 0x89, 0xb4, 0x9b, 0x69, 0x9f, 0x6a, 0xbb, 0xe9, 0xe5, 0x55, 0x13, 0x96, 0x92, 0x8e,
+  0x62, 0x88, 0x1e, 0xa6, 0xe2, 0x29, 0xcb, 0x33, 0x11, 0x4a, 0x8b, 0x14, 0x23, 0x93, 0x08, 0x67,
+  0xd1, 0x83, 0x51, 0x81, 0x48, 0x94, 0x88, 0xb1, 0x99, 0x0c, 0x3a, 0xd7, 0x6c, 0x86, 0x5e, 0xbb,
+  0x24, 0x9c, 0x11, 0xd0, 0x37, 0xc5, 0x52, 0xf7, 0xfa, 0xac, 0x94, 0x70, 0xe6, 0xe6, 0xfc, 0x22,
+  0x5b, 0xb6, 0xd9, 0x7e, 0x12, 0xc8, 0x0e, 0x77, 0x92, 0xae, 0xa4, 0xb5, 0x9b, 0xd5, 0x4c, 0xc8,
+  0x47, 0x22, 0xe9, 0x0e, 0x8d, 0x92, 0xf7, 0x88, 0xc8, 0xf3, 0x8b, 0xae, 0xf5, 0xfa, 0x31, 0x03,
+  0xee, 0x29, 0xdc, 0x70, 0x1b, 0xa8, 0xa4, 0xe8, 0xc0, 0x54, 0xed, 0x47, 0xb3, 0xc1, 0x71, 0xc3,
+  0x7a, 0xb7, 0xfb, 0xea, 0x1a, 0xc5, 0xc0, 0xe6, 0xb1, 0xbe, 0xea, 0x9f, 0x58, 0x30, 0x8e, 0xb2,
+  0xf5, 0x99, 0x17, 0x48, 0x51, 0x1e, 0x7e, 0xbf, 0xbf, 0x29, 0x8f, 0xe6, 0xe2, 0x70, 0x96, 0x4d,
+  0xc5, 0x91, 0xef, 0x99, 0xdc, 0xc7, 0xb4, 0x73, 0x90, 0x69, 0xa9, 0x4a, 0x96, 0x32, 0xe1, 0x30,
+  0xd3, 0x07, 0x05, 0xf5, 0x6d, 0xdc, 0x3b, 0x83, 0xbc, 0x35, 0xc8, 0x7d, 0x57, 0xc1, 0x73, 0xa3,
+  0x57, 0x2a, 0xaa, 0x1e, 0xb9, 0x67, 0x23, 0xdb, 0xea, 0xf8, 0x3f, 0xa3, 0xda, 0x9c, 0xa5, 0x05,
+  0x1e, 0x0c, 0x7d, 0x59, 0x24, 0xfd, 0xc5, 0x42, 0x8f, 0xc6, 0x1f, 0x94, 0xc2, 0x87, 0xe3, 0x14,
+  0x80, 0x3e, 0x8f, 0x6a, 0x63, 0x21, 0x29, 0xeb, 0xf3, 0x40, 0x21, 0xd9, 0x71, 0xe3, 0x3d, 0x63,
+  0x6d, 0x4f, 0x2a, 0xa5, 0xf0, 0xe5, 0x02, 0x4f, 0x49, 0xf4, 0x70, 0xf4, 0x94, 0xf6, 0x2d, 0x83,
+  0xf7, 0x39, 0xf2, 0xa7, 0x8e, 0x69, 0x49, 0xe8, 0xbf, 0xfe, 0xbe, 0xb9, 0xfd, 0xe3, 0x6e, 0x72,
+  0x1a, 0xe9, 0x2a, 0xe7, 0x06, 0xa1, 0xbf, 0x2d, 0x0d, 0x50, 0xaf, 0x73, 0xa9, 0xbb, 0x85, 0xd6,
+  0x83, 0xde, 0x46, 0xea, 0x6e, 0xf3, 0xa1, 0xcd, 0x8d, 0x4f, 0x3b, 0xb6, 0x3b, 0x6f, 0xe9, 0x70,
+  0x94, 0xba, 0xe0, 0x14, 0x16, 0xc2, 0x36, 0x01, 0x69, 0x31, 0x11, 0x69, 0xae, 0x34, 0xd1, 0xa5,
+  0xb9, 0x15, 0xa3, 0x20, 0x6a, 0xb3, 0x1a, 0x38, 0x98, 0x66, 0x47, 0xae, 0xb3, 0x59, 0x74, 0x9a,
+  0x82, 0x5f, 0x40, 0x09, 0xbe, 0xd4, 0x4c, 0x24, 0xcf, 0xdc, 0xf9, 0xa6, 0x7b, 0x4f, 0x9a, 0x96,
+  0x4b, 0xb1, 0xef, 0x50, 0x29, 0xd9, 0xc1, 0xf6, 0xc5, 0xd8, 0x7c, 0xf3, 0x15, 0xb6, 0x3f, 0x2d,
+  0xe3, 0xf6, 0x25, 0x6f, 0x25, 0x2d, 0x7a, 0x10, 0xd3, 0x64, 0x75, 0x3f, 0xb0, 0x95, 0xd5, 0xc5,
+  0xf5, 0x04, 0x9f, 0x85, 0x42, 0xf7, 0x57, 0x39, 0xf3, 0x02, 0x60, 0x26, 0xd9, 0x77, 0x23, 0x03,
+  0xdc, 0xe3, 0x3c, 0x1b, 0x0d, 0x4f, 0xe6, 0x92, 0xf0, 0x4c, 0x71, 0x4b, 0xf3, 0xeb, 0xac, 0x26,
+  0x8d, 0x56, 0x93, 0x06, 0xab, 0x0f, 0x4c, 0x56, 0x6d, 0xcc, 0x14, 0x38, 0x9b, 0x06, 0x93, 0x7b,
+  0x54, 0xb5, 0xa8, 0x53, 0xf2, 0xa6, 0x26, 0xf9, 0x49, 0x0d, 0x38, 0xd9, 0x0f, 0x1c, 0xd7, 0x80,
+  0xe3, 0xec, 0x36, 0x29, 0x83, 0x1b, 0x3a, 0x8f, 0x26, 0x4d, 0xfd, 0x63, 0x9a, 0xfa, 0x07, 0x34,
+  0x75, 0xbc, 0xf6, 0x49, 0xea, 0x1f, 0x90, 0xd4, 0x19, 0xd5, 0x15, 0xf5, 0x9b, 0x15, 0x75, 0x16,
+  0x35, 0x41, 0xfd, 0x53, 0x05, 0xf5, 0x4f, 0x15, 0xd4, 0x3f, 0x28, 0x68, 0xb9, 0x5e, 0x4f, 0x3c,
+  0x41, 0xae, 0x39, 0x34, 0xba, 0xd7, 0xba, 0xcb, 0xe1, 0x6e, 0x77, 0xd9, 0x39, 0xd2, 0x5d, 0x1a,
+  0x07, 0x07, 0x1a, 0xcc, 0xcd, 0xd6, 0xfa, 0x38, 0x7c, 0x31, 0xd7, 0xde, 0xcb, 0x98, 0xf6, 0x0e,
+  0x9f, 0x76, 0xcf, 0x7d, 0xff, 0x54, 0x3e, 0x9f, 0x48, 0x9a, 0xb6, 0xa7, 0x6f, 0x2f, 0x3b, 0xfe,
+  0x3b, 0x32, 0xac, 0x7d, 0x3e, 0xe5, 0xdf, 0x4d, 0x5e, 0xf6, 0xed, 0xf8, 0x1f, 0xd6, 0xe0, 0x5a,
+  0x77, 0x53, 0x0e, 0x00, 0x00,
+};
+
+static const static_asset_t static_assets[] = {
+    { "/style.cdd1cfaa.css", "text/css", style_css_gz, 1127, "\"cdd1cfaa7d646a16\"", true },
+    { "/joy.8ed3428a.js", "application/javascript", joy_js_gz, 2566, "\"8ed3428abcc57dbf\"", true },
+    { "/app.b74029a8.js", "application/javascript", app_js_gz, 3581, "\"b74029a85e6bb1c3\"", true },
+    { "/", "text/html", index_html_gz, 1029, "\"cf2a769cd51639d7\"", false },
+};
+#define STATIC_ASSET_COUNT 4
+
+#endif
@@ -0,0 +1,302 @@
+#include "camera_pipeline.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "img_converters.h"
+#include "metrics.h"
+#include "motion_stage.h"
+#include "recorder.h"
+#include "task_plan.h"
+#include "Arduino.h"
+#include "freertos/event_groups.h"
+
+// Captura en su propia tarea y deja cada frame en un anillo de buffers con contador de referencias.
+// El driver recupera su buffer en cuanto se copia el JPEG, asi un envio lento no para la camara
+// y quien transmite siempre coge el ultimo frame, saltandose los que se hayan quedado viejos.
+// Los buffers de los huecos son la reserva de memoria: en PSRAM, solo crecen y se reutilizan frame a frame,
+// tambien cuando el sensor no da JPEG y hay que codificarlo aqui (nada de un malloc/free por frame).
+
+// Cada publicacion deja puesto solo el bit de su seq (modulo FRAME_SEQ_BITS), y quien espera lo hace
+// a cualquier bit distinto del del ultimo seq que vio: si se publica entre que mira el anillo y se
+// pone a esperar, el bit ya esta y no se duerme. Un pulso set+clear se perdia en esa ventana.
+// Solo fallaria con FRAME_SEQ_BITS frames dentro de la ventana, y entonces espera al siguiente.
+#define FRAME_SEQ_BITS 8
+#define FRAME_SEQ_MASK ((1 << FRAME_SEQ_BITS) - 1)
+
+static frame_t ring[FRAME_RING_SIZE];
+static frame_t * latest = NULL;
+static uint32_t next_seq = 1;
+static portMUX_TYPE ring_mux = portMUX_INITIALIZER_UNLOCKED;
+static EventGroupHandle_t ring_events = NULL;
+static TaskHandle_t capture_task_handle = NULL;
+static int subscribers = 0;
+
+static uint32_t frames_captured = 0;
+static uint32_t frames_dropped = 0;
+static uint32_t buffer_allocs = 0;
+static size_t buffer_bytes = 0;
+
+// Sin JPEG del sensor: calidad del codificador y lo que se reserva por frame. Si un frame no cabe
+// se pierde y la reserva se dobla para los siguientes, hasta que todos los huecos tienen su tamano.
+#define ENCODE_QUALITY 80
+static size_t encode_reserve = 0;
+
+typedef struct {
+        frame_t * frame;
+        bool overflow;
+} encode_sink_t;
+
+// Reserva un hueco libre para escribir (refs = 1 sera luego la referencia del anillo)
+static frame_t * ring_reserve_slot(){
+    frame_t * slot = NULL;
+    portENTER_CRITICAL(&ring_mux);
+    for(int i = 0; i < FRAME_RING_SIZE; i++){
+        if(ring[i].refs == 0){
+            slot = &ring[i];
+            slot->refs = 1;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&ring_mux);
+    return slot;
+}
+
+static void ring_unreserve_slot(frame_t * slot){
+    portENTER_CRITICAL(&ring_mux);
+    slot->refs = 0;
+    portEXIT_CRITICAL(&ring_mux);
+}
+
+static EventBits_t seq_bit(uint32_t seq){
+    return 1 << (seq % FRAME_SEQ_BITS);
+}
+
+static void ring_publish(frame_t * slot){
+    portENTER_CRITICAL(&ring_mux);
+    frame_t * old = latest;
+    uint32_t seq = next_seq++;
+    slot->seq = seq;
+    latest = slot;
+    if(old){
+        old->refs--;
+    }
+    portEXIT_CRITICAL(&ring_mux);
+    xEventGroupClearBits(ring_events, FRAME_SEQ_MASK & ~seq_bit(seq));
+    xEventGroupSetBits(ring_events, seq_bit(seq));
+}
+
+// Espera a que se publique algo despues de seen (next_seq - 1 leido con ring_mux)
+static void ring_wait(uint32_t seen, int64_t left_us){
+    xEventGroupWaitBits(ring_events, FRAME_SEQ_MASK & ~seq_bit(seen), pdFALSE, pdFALSE, left_us / 1000 / portTICK_PERIOD_MS + 1);
+}
+
+// Sin nadie mirando no se guarda el ultimo frame, el siguiente suscriptor no debe recibir uno viejo
+static void ring_drop_latest(){
+    portENTER_CRITICAL(&ring_mux);
+    if(latest){
+        latest->refs--;
+        latest = NULL;
+    }
+    portEXIT_CRITICAL(&ring_mux);
+}
+
+static bool ring_grow(frame_t * f, size_t len){
+    if(f->capacity >= len){
+        return true;
+    }
+    // El contenido no se conserva: liberar antes deja que el bloque nuevo aproveche el hueco del viejo
+    size_t capacity = len + len / 4;
+    heap_caps_free(f->buf);
+    buffer_bytes -= f->capacity;
+    f->capacity = 0;
+    f->buf = (uint8_t *)heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if(!f->buf){
+        f->buf = (uint8_t *)malloc(capacity);
+    }
+    if(!f->buf){
+        return false;
+    }
+    buffer_allocs++;
+    buffer_bytes += capacity;
+    f->capacity = capacity;
+    return true;
+}
+
+// 4 bits por pixel: de sobra para un JPEG de calidad 80 de una escena normal
+static size_t encode_bound(size_t width, size_t height){
+    size_t bound = width * height / 2 + 4096;
+    return bound > encode_reserve ? bound : encode_reserve;
+}
+
+// Salida de frame2jpg_cb directamente al buffer del hueco
+static size_t encode_write(void * arg, size_t index, const void * data, size_t len){
+    encode_sink_t * sink = (encode_sink_t *)arg;
+    frame_t * f = sink->frame;
+    if(!index){
+        f->len = 0;
+    }
+    if(f->len + len > f->capacity){
+        sink->overflow = true;
+        return 0;
+    }
+    memcpy(f->buf + f->len, data, len);
+    f->len += len;
+    return len;
+}
+
+static bool ring_fill(frame_t * slot, camera_fb_t * fb){
+    if(fb->format == PIXFORMAT_JPEG){
+        if(!ring_grow(slot, fb->len)){
+            return false;
+        }
+        memcpy(slot->buf, fb->buf, fb->len);
+        slot->len = fb->len;
+    } else {
+        if(!ring_grow(slot, encode_bound(fb->width, fb->height))){
+            return false;
+        }
+        encode_sink_t sink = {slot, false};
+        if(!frame2jpg_cb(fb, ENCODE_QUALITY, encode_write, &sink) || sink.overflow){
+            // Nunca hace falta mas que el frame sin comprimir en RGB
+            size_t raw = fb->width * fb->height * 3;
+            if(sink.overflow && encode_reserve < raw){
+                encode_reserve = slot->capacity * 2 < raw ? slot->capacity * 2 : raw;
+            }
+            return false;
+        }
+    }
+    slot->width = fb->width;
+    slot->height = fb->height;
+    return true;
+}
+
+static void capture_task(void * arg){
+    while(true){
+        if(!subscribers){
+            ring_drop_latest();
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        int64_t fr_start = esp_timer_get_time();
+        camera_fb_t * fb = esp_camera_fb_get();
+        if(!fb){
+            // Serial.println("Camera capture failed");
+            vTaskDelay(10 / portTICK_PERIOD_MS);
+            continue;
+        }
+        int64_t timestamp = esp_timer_get_time();
+        frames_captured++;
+
+        frame_t * slot = ring_reserve_slot();
+        if(!slot){
+            // Todos los huecos estan en uso por clientes lentos, se pierde este frame
+            frames_dropped++;
+            esp_camera_fb_return(fb);
+            continue;
+        }
+        bool filled = ring_fill(slot, fb);
+        esp_camera_fb_return(fb);
+        if(!filled){
+            frames_dropped++;
+            ring_unreserve_slot(slot);
+            continue;
+        }
+        slot->timestamp = timestamp;
+        metric_observe(&metric_capture_us, esp_timer_get_time() - fr_start);
+        metric_observe(&metric_frame_bytes, slot->len);
+        ring_publish(slot);
+        // El recien publicado es el mas reciente: nadie lo reutiliza hasta la siguiente vuelta de esta tarea
+        recorder_tee(slot);
+        if(motion_stage_due(timestamp)){
+            // Solo la captura publica, asi que el mas reciente es el que acaba de salir
+            motion_stage_offer(frame_acquire_latest(0, 0));
+        }
+    }
+}
+
+void camera_pipeline_start(){
+    if(capture_task_handle){
+        return;
+    }
+    ring_events = xEventGroupCreate();
+    task_plan_create(TASK_CAPTURE, capture_task, NULL, &capture_task_handle);
+}
+
+void camera_pipeline_subscribe(){
+    portENTER_CRITICAL(&ring_mux);
+    subscribers++;
+    portEXIT_CRITICAL(&ring_mux);
+    xTaskNotifyGive(capture_task_handle);
+}
+
+void camera_pipeline_unsubscribe(){
+    portENTER_CRITICAL(&ring_mux);
+    if(subscribers > 0){
+        subscribers--;
+    }
+    portEXIT_CRITICAL(&ring_mux);
+}
+
+frame_t * frame_acquire_latest(uint32_t last_seq, uint32_t timeout_ms){
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while(true){
+        frame_t * f = NULL;
+        portENTER_CRITICAL(&ring_mux);
+        uint32_t seen = next_seq - 1;
+        if(latest && latest->seq != last_seq){
+            f = latest;
+            f->refs++;
+        }
+        portEXIT_CRITICAL(&ring_mux);
+        if(f){
+            return f;
+        }
+        int64_t left = deadline - esp_timer_get_time();
+        if(left <= 0){
+            return NULL;
+        }
+        ring_wait(seen, left);
+    }
+}
+
+frame_t * frame_acquire_since(int64_t since, uint32_t timeout_ms){
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    frame_t * f = NULL;
+    camera_pipeline_subscribe();
+    while(true){
+        portENTER_CRITICAL(&ring_mux);
+        uint32_t seen = next_seq - 1;
+        if(latest && latest->timestamp >= since){
+            f = latest;
+            f->refs++;
+        }
+        portEXIT_CRITICAL(&ring_mux);
+        int64_t left = deadline - esp_timer_get_time();
+        if(f || left <= 0){
+            break;
+        }
+        ring_wait(seen, left);
+    }
+    // Si era el unico suscriptor la captura se vuelve a dormir; la referencia mantiene el frame
+    camera_pipeline_unsubscribe();
+    return f;
+}
+
+void frame_release(frame_t * f){
+    if(!f){
+        return;
+    }
+    portENTER_CRITICAL(&ring_mux);
+    f->refs--;
+    portEXIT_CRITICAL(&ring_mux);
+}
+
+void camera_pipeline_stats(uint32_t * captured, uint32_t * dropped){
+    *captured = frames_captured;
+    *dropped = frames_dropped;
+}
+
+void camera_pipeline_buffer_stats(uint32_t * allocs, size_t * bytes){
+    *allocs = buffer_allocs;
+    *bytes = buffer_bytes;
+}
@@ -0,0 +1,48 @@
+#ifndef CAMERA_PIPELINE_H
+#define CAMERA_PIPELINE_H
+
+#include "esp_camera.h"
+
+// Frame ya codificado en JPEG, copiado fuera del buffer del driver.
+// Lo comparten los que lo leen mediante un contador de referencias.
+typedef struct {
+        uint8_t * buf;
+        size_t len;
+        size_t capacity;
+        size_t width;
+        size_t height;
+        uint32_t seq;
+        int64_t timestamp;      // esp_timer_get_time() al recibirlo del sensor
+        int refs;
+} frame_t;
+
+// Uno por cliente de stream con un envio a medias, el del analisis de movimiento,
+// el ultimo publicado y el que se esta escribiendo
+#define FRAME_RING_SIZE 7
+
+void camera_pipeline_start();
+
+// La tarea de captura solo trabaja mientras haya alguien suscrito
+void camera_pipeline_subscribe();
+void camera_pipeline_unsubscribe();
+
+// Frame mas reciente con seq distinto de last_seq, espera hasta timeout_ms. NULL si no llega ninguno.
+// Hay que devolverlo siempre con frame_release().
+frame_t * frame_acquire_latest(uint32_t last_seq, uint32_t timeout_ms);
+void frame_release(frame_t * f);
+
+// /capture sirve el ultimo frame del anillo si no tiene mas de esto; si no, espera al siguiente
+#define SNAPSHOT_MAX_AGE_MS 250
+#define SNAPSHOT_TIMEOUT_MS 1000
+
+// Frame recibido del sensor a partir de since (esp_timer_get_time()), espera hasta timeout_ms.
+// Se suscribe mientras espera: sin nadie en /stream despierta a la tarea de captura solo para esta foto.
+// Mismo contrato que frame_acquire_latest, hay que devolverlo con frame_release().
+frame_t * frame_acquire_since(int64_t since, uint32_t timeout_ms);
+
+void camera_pipeline_stats(uint32_t * captured, uint32_t * dropped);
+// Veces que se ha pedido memoria para un hueco y lo que ocupan entre todos.
+// Con la resolucion estable deja de crecer en cuanto cada hueco ha tenido un frame.
+void camera_pipeline_buffer_stats(uint32_t * allocs, size_t * bytes);
+
+#endif
@@ -0,0 +1,329 @@
+#include "clip_server.h"
+#include "recorder.h"
+#include "metrics.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "Arduino.h"
+#include "freertos/semphr.h"
+#include "lwip/sockets.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Una descarga a la vez: el buffer es uno y la tarjeta no da para mas
+typedef struct {
+        volatile bool busy;     // del handler a la tarea, y vuelta cuando cierra el archivo
+        int fd;                 // socket, -1 si el cliente ya no esta
+        int file;
+        uint32_t left;
+} clip_download_t;
+
+static clip_download_t download = {false, -1, -1, 0};
+static SemaphoreHandle_t download_lock = NULL;
+static TaskHandle_t clips_task_handle = NULL;
+static httpd_handle_t clips_server = NULL;
+static uint8_t * chunk = NULL;
+static volatile int rate_kbps = CLIP_RATE_KBPS;
+static uint32_t downloads = 0;
+static volatile uint32_t sent_bytes = 0;
+
+// strtoul se traga espacios y signo: "bytes=--5" daria un numero enorme en lugar de un Range mal escrito
+static bool range_digit(const char * p){
+    return *p >= '0' && *p <= '9';
+}
+
+int clip_parse_range(const char * range, uint32_t size, uint32_t * start, uint32_t * len){
+    if(strncmp(range, "bytes=", 6) || strchr(range, ',')){
+        return 0;
+    }
+    const char * p = range + 6;
+    char * end;
+    uint32_t first, last;
+    if(*p == '-'){
+        // Los ultimos n bytes
+        if(!range_digit(p + 1)){
+            return 0;
+        }
+        unsigned long n = strtoul(p + 1, &end, 10);
+        if(*end){
+            return 0;
+        }
+        if(!n || !size){
+            return -1;
+        }
+        first = n >= size ? 0 : size - n;
+        last = size - 1;
+    } else {
+        if(!range_digit(p)){
+            return 0;
+        }
+        unsigned long a = strtoul(p, &end, 10);
+        if(*end != '-'){
+            return 0;
+        }
+        p = end + 1;
+        unsigned long b = size ? size - 1 : 0;
+        if(*p){
+            if(!range_digit(p)){
+                return 0;
+            }
+            b = strtoul(p, &end, 10);
+            if(*end || b < a){
+                return 0;
+            }
+        }
+        if(a >= size){
+            return -1;
+        }
+        first = a;
+        last = b < size ? b : size - 1;
+    }
+    *start = first;
+    *len = last - first + 1;
+    return 1;
+}
+
+// Solo nombres de archivo sueltos dentro de RECORD_DIR
+static bool clip_name_ok(const char * name){
+    size_t n = strlen(name);
+    if(!n || n > 31 || name[0] == '.'){
+        return false;
+    }
+    for(size_t i = 0; i < n; i++){
+        char c = name[i];
+        if(!isalnum((unsigned char)c) && c != '.' && c != '_' && c != '-'){
+            return false;
+        }
+    }
+    return true;
+}
+
+// Envia un trozo de la descarga en curso; false cuando se ha acabado o se ha cortado
+static bool clip_step(int64_t * next){
+    uint32_t n = download.left < CLIP_CHUNK ? download.left : CLIP_CHUNK;
+    bool ok = n && read(download.file, chunk, n) == (ssize_t)n;
+    uint32_t off = 0;
+    int64_t progress = esp_timer_get_time();
+    while(ok && off < n){
+        // El cerrojo solo alrededor del send sin espera: si el cliente se va, close_fn no se queda bloqueado
+        int fd, w = -1, err = 0;
+        xSemaphoreTake(download_lock, portMAX_DELAY);
+        fd = download.fd;
+        if(fd >= 0){
+            w = send(fd, chunk + off, n - off, MSG_DONTWAIT);
+            err = errno;
+        }
+        xSemaphoreGive(download_lock);
+        int64_t now = esp_timer_get_time();
+        if(w > 0){
+            off += w;
+            progress = now;
+        } else if(fd >= 0 && w < 0 && (err == EAGAIN || err == EWOULDBLOCK) &&
+                  now - progress < CLIP_SEND_TIMEOUT_MS * 1000LL){
+            vTaskDelay(10 / portTICK_PERIOD_MS);
+        } else {
+            ok = false;
+        }
+    }
+    if(!ok){
+        return false;
+    }
+    download.left -= n;
+    sent_bytes += n;
+
+    // Tope de velocidad: cada trozo adelanta la hora del siguiente; sin acumular credito si el cliente fue lento
+    int kbps = rate_kbps;
+    int64_t now = esp_timer_get_time();
+    if(kbps){
+        *next = (*next > now ? *next : now) + (int64_t)n * 1000000 / (kbps * 1024);
+        if(*next - now >= 1000){
+            vTaskDelay((*next - now) / 1000 / portTICK_PERIOD_MS);
+        }
+    }
+    return download.left > 0;
+}
+
+static void clips_task(void * arg){
+    while(true){
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if(!download.busy){
+            continue;
+        }
+        int64_t next = 0;
+        while(clip_step(&next)){
+        }
+        close(download.file);
+        download.file = -1;
+        xSemaphoreTake(download_lock, portMAX_DELAY);
+        int fd = download.fd;
+        download.fd = -1;
+        xSemaphoreGive(download_lock);
+        if(fd >= 0){
+            httpd_trigger_sess_close(clips_server, fd);
+        }
+        download.busy = false;
+    }
+}
+
+void clip_server_start(httpd_handle_t server){
+    if(!RECORDER_SD || clips_task_handle){
+        return;
+    }
+    clips_server = server;
+    chunk = (uint8_t *)heap_caps_malloc(CLIP_CHUNK, MALLOC_CAP_DMA);
+    download_lock = xSemaphoreCreateMutex();
+    task_plan_create(TASK_CLIPS, clips_task, NULL, &clips_task_handle);
+}
+
+void clip_server_forget(int fd){
+    if(!download_lock){
+        return;
+    }
+    xSemaphoreTake(download_lock, portMAX_DELAY);
+    if(download.fd == fd){
+        download.fd = -1;
+    }
+    xSemaphoreGive(download_lock);
+}
+
+// Lista de RECORD_DIR, una entrada por trozo de la respuesta
+static esp_err_t clip_list(httpd_req_t * req){
+    char entry[96];
+    char path[64];
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    if(httpd_resp_send_chunk(req, "{\"clips\":[", 10) != ESP_OK){
+        return ESP_FAIL;
+    }
+    DIR * dir = opendir(RECORD_DIR);
+    bool first = true;
+    struct dirent * e;
+    while(dir && (e = readdir(dir))){
+        struct stat st;
+        if(!clip_name_ok(e->d_name)){
+            continue;
+        }
+        // clip_name_ok ya ha dejado fuera los nombres de mas de 31
+        snprintf(path, sizeof(path), RECORD_DIR "/%.31s", e->d_name);
+        if(stat(path, &st) != 0){
+            continue;
+        }
+        int n = snprintf(entry, sizeof(entry), "%s{\"name\":\"%s\",\"bytes\":%u}", first ? "" : ",", e->d_name, (unsigned)st.st_size);
+        first = false;
+        if(httpd_resp_send_chunk(req, entry, n) != ESP_OK){
+            closedir(dir);
+            return ESP_FAIL;
+        }
+    }
+    if(dir){
+        closedir(dir);
+    }
+    if(httpd_resp_send_chunk(req, "]}", 2) != ESP_OK){
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+esp_err_t clip_server_handler(httpd_req_t * req){
+    char query[64];
+    char name[32] = "";
+    size_t query_len = httpd_req_get_url_query_len(req) + 1;
+    if(query_len > 1 && query_len <= sizeof(query) && httpd_req_get_url_query_str(req, query, query_len) == ESP_OK){
+        httpd_query_key_value(query, "file", name, sizeof(name));
+    }
+    if(!clips_task_handle || !chunk || !recorder_mount()){
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        return httpd_resp_send(req, NULL, 0);
+    }
+    if(!name[0]){
+        return clip_list(req);
+    }
+    if(!clip_name_ok(name)){
+        httpd_resp_set_status(req, "400 Bad Request");
+        return httpd_resp_send(req, NULL, 0);
+    }
+    // El que se esta grabando aun no tiene su tamano ni su indice en el directorio
+    record_status_t record;
+    recorder_status(&record);
+    if(record.state != RECORD_IDLE && !strcmp(record.name, name)){
+        httpd_resp_set_status(req, "409 Conflict");
+        return httpd_resp_send(req, NULL, 0);
+    }
+    if(download.busy){
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_hdr(req, "Retry-After", "10");
+        return httpd_resp_send(req, NULL, 0);
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), RECORD_DIR "/%s", name);
+    int file = open(path, O_RDONLY);
+    struct stat st;
+    if(file < 0 || fstat(file, &st) != 0){
+        if(file >= 0){
+            close(file);
+        }
+        return httpd_resp_send_404(req);
+    }
+    uint32_t size = st.st_size;
+    uint32_t start = 0;
+    uint32_t len = size;
+    int partial = 0;
+    char range[48];
+    if(httpd_req_get_hdr_value_str(req, "Range", range, sizeof(range)) == ESP_OK){
+        partial = clip_parse_range(range, size, &start, &len);
+    }
+    if(partial < 0){
+        close(file);
+        snprintf(range, sizeof(range), "bytes */%u", size);
+        httpd_resp_set_status(req, "416 Range Not Satisfiable");
+        httpd_resp_set_hdr(req, "Content-Range", range);
+        return httpd_resp_send(req, NULL, 0);
+    }
+    if(start && lseek(file, start, SEEK_SET) != (off_t)start){
+        close(file);
+        return httpd_resp_send_500(req);
+    }
+
+    // Cabeceras a mano con el tamano exacto, para que el navegador sepa cuanto falta y pueda saltar
+    const char * type = strstr(name, ".avi") ? "video/x-msvideo" : "application/octet-stream";
+    char head[320];
+    int n = snprintf(head, sizeof(head), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %u\r\nAccept-Ranges: bytes\r\n",
+                     partial ? "206 Partial Content" : "200 OK", type, len);
+    if(partial){
+        n += snprintf(head + n, sizeof(head) - n, "Content-Range: bytes %u-%u/%u\r\n", start, start + len - 1, size);
+    }
+    n += snprintf(head + n, sizeof(head) - n, "Access-Control-Allow-Origin: *\r\nConnection: close\r\n\r\n");
+    if(httpd_send(req, head, n) != n){
+        close(file);
+        return ESP_FAIL;
+    }
+    if(!len){
+        // Sin cuerpo no pasa por la tarea, pero ha dicho Connection: close y el cliente espera el cierre
+        close(file);
+        httpd_trigger_sess_close(clips_server, httpd_req_to_sockfd(req));
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(download_lock, portMAX_DELAY);
+    download.fd = httpd_req_to_sockfd(req);
+    download.file = file;
+    download.left = len;
+    download.busy = true;
+    downloads++;
+    xSemaphoreGive(download_lock);
+    xTaskNotifyGive(clips_task_handle);
+    return ESP_OK;
+}
+
+void clip_server_set_rate(int kbps){
+    rate_kbps = kbps;
+}
+
+void clip_server_stats(uint32_t * downloads_out, uint32_t * bytes_out){
+    *downloads_out = downloads;
+    *bytes_out = sent_bytes;
+}
@@ -0,0 +1,32 @@
+#ifndef CLIP_SERVER_H
+#define CLIP_SERVER_H
+
+#include "esp_http_server.h"
+
+// Descarga de las grabaciones de la SD (recorder.h) desde camera_httpd:
+//   /clips                 lista en JSON de RECORD_DIR
+//   /clips?file=<nombre>   el archivo, con Range: bytes=a-b para reanudar o saltar dentro del video
+// Como el stream, el handler manda las cabeceras y el socket pasa a una tarea de baja prioridad que lee
+// la tarjeta a un buffer fijo y lo envia con un tope de velocidad: una descarga larga no deja a
+// /control esperando detras ni se come el ancho de banda de /stream.
+
+#define CLIP_CHUNK 8192                 // lectura de la tarjeta y envio, en RAM interna por el DMA del SDMMC
+#define CLIP_RATE_KBPS 256              // por defecto, /control?var=cliprate&val=<KB/s>, 0 sin tope
+#define CLIP_SEND_TIMEOUT_MS 10000      // sin avanzar en este tiempo la descarga se corta
+
+void clip_server_start(httpd_handle_t server);
+
+esp_err_t clip_server_handler(httpd_req_t * req);
+
+// Desde el close_fn de camera_httpd; no cierra el socket
+void clip_server_forget(int fd);
+
+void clip_server_set_rate(int kbps);
+
+void clip_server_stats(uint32_t * downloads, uint32_t * bytes);
+
+// Cabecera Range contra un archivo de size bytes. Un solo rango (a-b, a- o -n).
+// 0 sin Range o con uno que no se entiende (se manda entero), 1 con *start y *len, -1 fuera del archivo (416).
+int clip_parse_range(const char * range, uint32_t size, uint32_t * start, uint32_t * len);
+
+#endif
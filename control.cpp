@@ -0,0 +1,339 @@
+#include "control.h"
+#include "actuators.h"
+#include "servo_motion.h"
+#include "failsafe.h"
+#include "mjpeg_stream.h"
+#include "device_state.h"
+#include "event_stream.h"
+#include "motion_stage.h"
+#include "clip_server.h"
+#include "esp_camera.h"
+#include "Arduino.h"
+
+// Registro de comandos de /control (y del canal WebSocket).
+// Tabla ordenada por nombre y busqueda binaria: un actuador nuevo es una linea mas en la tabla,
+// con su rango y su canal LEDC, sin otra rama en una cadena de strcmp.
+
+int speed = 255;
+int noStop = 0;
+
+enum state {fwd,rev,stp};
+state actstate = stp;
+
+static int servo_max_speed = SERVO_MAX_SPEED;
+static int servo_max_accel = SERVO_MAX_ACCEL;
+
+// Ultima posicion del joystick de conduccion, llega eje a eje (arg de la tabla)
+enum drive_axis {DRIVE_X, DRIVE_Y};
+static int drive_axes[2] = {0, 0};
+
+static int control_framesize(const control_cmd_t * cmd, int val){
+    sensor_t * s = esp_camera_sensor_get();
+    if(s->pixformat != PIXFORMAT_JPEG){
+        return 0;
+    }
+    // Lo que elige el usuario es el maximo, el control de bitrate solo baja desde ahi
+    mjpeg_stream_abr_ceiling(-1, val);
+    if(s->set_framesize(s, (framesize_t)val)){
+        return -1;
+    }
+    state_set(STATE_FRAMESIZE, val);
+    return 0;
+}
+
+static int control_quality(const control_cmd_t * cmd, int val){
+    sensor_t * s = esp_camera_sensor_get();
+    mjpeg_stream_abr_ceiling(val, -1);
+    if(s->set_quality(s, val)){
+        return -1;
+    }
+    state_set(STATE_QUALITY, val);
+    return 0;
+}
+
+// Control de bitrate automatico del stream (1 por defecto)
+static int control_abr(const control_cmd_t * cmd, int val){
+    mjpeg_stream_abr_enable(val);
+    return 0;
+}
+
+// Periodo de /events en ms
+static int control_events(const control_cmd_t * cmd, int val){
+    event_stream_set_period(val);
+    return 0;
+}
+
+// Plazo del failsafe en ms, 0 lo apaga. Por debajo del minimo saltaria entre dos latidos de la pagina.
+static int control_failsafe(const control_cmd_t * cmd, int val){
+    if(val && val < FAILSAFE_MIN_MS){
+        return -1;
+    }
+    actuators_set_failsafe(val);
+    return 0;
+}
+
+// Latido de la pagina cuando no hay WebSocket: no hace nada, control_run ya ha rearmado el failsafe
+static int control_heartbeat(const control_cmd_t * cmd, int val){
+    return 0;
+}
+
+// Modo centinela: deteccion de movimiento sobre la captura. Sin PSRAM no hay analisis que encender
+static int control_motion(const control_cmd_t * cmd, int val){
+    return motion_stage_enable(val) ? 0 : -1;
+}
+
+static int control_motion_threshold(const control_cmd_t * cmd, int val){
+    motion_stage_set_threshold(val);
+    return 0;
+}
+
+// Tope de velocidad de las descargas de /clips en KB/s, 0 sin tope
+static int control_clip_rate(const control_cmd_t * cmd, int val){
+    clip_server_set_rate(val);
+    return 0;
+}
+
+// Flash: duty = val * scale en el canal de la tabla
+static int control_ledc(const control_cmd_t * cmd, int val){
+    ledcWrite(cmd->channel, cmd->scale * val);
+    state_set(STATE_FLASH, val);
+    return 0;
+}
+
+// Servos: no se escribe el duty de golpe, el planificador los lleva al objetivo poco a poco
+static int control_servo(const control_cmd_t * cmd, int val){
+    int index = cmd->channel - SERVO_FIRST_CHANNEL;
+    if(!servo_move(index, val)){
+        return -1;
+    }
+    state_set((state_field_t)(STATE_SERVO + index), val);
+    return 0;
+}
+
+static int control_servo_speed(const control_cmd_t * cmd, int val){
+    servo_max_speed = val;
+    servo_motion_set_limits(servo_max_speed, servo_max_accel);
+    return 0;
+}
+
+static int control_servo_accel(const control_cmd_t * cmd, int val){
+    servo_max_accel = val;
+    servo_motion_set_limits(servo_max_speed, servo_max_accel);
+    return 0;
+}
+
+static int control_speed(const control_cmd_t * cmd, int val){
+    speed = val;
+    state_set(STATE_SPEED, val);
+    return 0;
+}
+
+static int control_nostop(const control_cmd_t * cmd, int val){
+    noStop = val;
+    state_set(STATE_NOSTOP, val);
+    return 0;
+}
+
+static int control_car(const control_cmd_t * cmd, int val){
+    // Los duty van en orden de canal: 3 (pin 12), 4 (pin 13), 5 (pin 14), 6 (pin 15)
+    motor_cmd_t m = {{0, 0, 0, 0}, 0, noStop == 1 ? MOTOR_EXPIRY_HOLD : MOTOR_EXPIRY_STOP};
+    if (val==1) {
+      //Serial.println("Forward");
+      actstate = fwd;
+      m.duty[1] = speed;
+      m.duty[2] = speed;
+      m.duration_ms = 200;
+    }
+    else if (val==2) {
+      //Serial.println("TurnLeft");
+      if      (actstate == fwd) { m.duty[1] = speed; }
+      else if (actstate == rev) { m.duty[3] = speed; }
+      else                      { m.duty[1] = speed; m.duty[3] = speed; }
+      m.duration_ms = 100;
+    }
+    else if (val==3) {
+      //Serial.println("Stop");
+      actstate = stp;
+    }
+    else if (val==4) {
+      //Serial.println("TurnRight");
+      if      (actstate == fwd) { m.duty[2] = speed; }
+      else if (actstate == rev) { m.duty[0] = speed; }
+      else                      { m.duty[0] = speed; m.duty[2] = speed; }
+      m.duration_ms = 100;
+    }
+    else if (val==5) {
+      //Serial.println("Backward");
+      actstate = rev;
+      m.duty[0] = speed;
+      m.duty[3] = speed;
+      m.duration_ms = 200;
+    }
+    state_set(STATE_ACTSTATE, actstate);
+    // Sin delay(): la tarea de motores corta el pulso al acabar (salvo noStop) y el handler vuelve ya
+    return motor_enqueue(&m) ? 0 : -1;
+}
+
+static int control_drive(const control_cmd_t * cmd, int val){
+    drive_axes[cmd->arg] = val;
+    state_set(STATE_DRIVEX, drive_axes[DRIVE_X]);
+    state_set(STATE_DRIVEY, drive_axes[DRIVE_Y]);
+    return motor_drive(drive_axes[DRIVE_X], drive_axes[DRIVE_Y], speed) ? 0 : -1;
+}
+
+// Ordenada por nombre (lo comprueba el static_assert de abajo).
+// min/max: con clamp el valor se recorta a ese rango, sin clamp fuera de rango es un error.
+// Servos: 50 Hz con 16 bits, 3250..6500 de duty son 325..650 (el planificador multiplica por 10).
+// Remote Control Car: no usar los canales 1 y 2.
+static constexpr control_cmd_t control_table[] = {
+    //  nombre        handler             min    max  clamp   canal  scale    arg
+    { "abr",        control_abr,          0,     1,  true,     -1,    0,       0 },
+    { "car",        control_car,          1,     5,  false,    -1,    0,       0 },
+    { "cliprate",   control_clip_rate,    0,  4096,  true,     -1,    0,       0 },
+    { "drivex",     control_drive,     -100,   100,  true,     -1,    0, DRIVE_X },
+    { "drivey",     control_drive,     -100,   100,  true,     -1,    0, DRIVE_Y },
+    { "events",     control_events,     100,  5000,  true,     -1,    0,       0 },
+    { "failsafe",   control_failsafe,     0, 10000,  true,     -1,    0,       0 },
+    { "flash",      control_ledc,         0,   255,  true,      7,    1,       0 },
+    { "framesize",  control_framesize,    0,  FRAMESIZE_INVALID - 1, true, -1, 0,       0 },
+    { "heartbeat",  control_heartbeat,    0,     1,  true,     -1,    0,       0 },
+    { "motion",     control_motion,       0,     1,  true,     -1,    0,       0 },
+    { "motionthreshold", control_motion_threshold, 1, 255, true, -1,  0,       0 },
+    { "nostop",     control_nostop,       0,     1,  true,     -1,    0,       0 },
+    { "quality",    control_quality,      0,    63,  true,     -1,    0,       0 },
+    { "servo",      control_servo,      325,   650,  true,      8,   10,       0 },
+    { "servo3",     control_servo,      325,   650,  true,     10,   10,       0 },
+    { "servoaccel", control_servo_accel, 50, 20000,  true,     -1,    0,       0 },
+    { "servopan",   control_servo,      325,   650,  true,      9,   10,       0 },
+    { "servospeed", control_servo_speed, 10,  5000,  true,     -1,    0,       0 },
+    { "speed",      control_speed,        0,   255,  true,     -1,    0,       0 },
+};
+
+#define CONTROL_COMMANDS (sizeof(control_table) / sizeof(control_table[0]))
+
+constexpr int control_strcmp(const char * a, const char * b){
+    return (*a != *b || !*a) ? (*a - *b) : control_strcmp(a + 1, b + 1);
+}
+
+constexpr bool control_table_sorted(const control_cmd_t * t, size_t n){
+    return n < 2 || (control_strcmp(t[0].name, t[1].name) < 0 && control_table_sorted(t + 1, n - 1));
+}
+
+static_assert(control_table_sorted(control_table, CONTROL_COMMANDS), "control_table tiene que estar ordenada por nombre");
+
+const control_cmd_t * control_find(const char * variable){
+    int lo = 0;
+    int hi = CONTROL_COMMANDS - 1;
+    while(lo <= hi){
+        int mid = (lo + hi) / 2;
+        int c = strcmp(variable, control_table[mid].name);
+        if(!c){
+            return &control_table[mid];
+        }
+        if(c < 0){
+            hi = mid - 1;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+static int control_run(const control_cmd_t * cmd, int val){
+    // Cualquier comando, aunque sea invalido, demuestra que el operador sigue conectado
+    actuators_heartbeat();
+    if (val < cmd->min || val > cmd->max) {
+        if (!cmd->clamp) return -1;
+        val = val > cmd->max ? cmd->max : cmd->min;
+    }
+    return cmd->handler(cmd, val);
+}
+
+int control_apply(const char * variable, int val)
+{
+    const control_cmd_t * cmd = control_find(variable);
+    if(!cmd){
+        //Serial.println("variable");
+        return -1;
+    }
+    return control_run(cmd, val);
+}
+
+// Entero decimal con signo opcional. Sin atoi: un valor vacio o con basura es un error, no un 0.
+static bool control_parse_int(const char * p, int * out){
+    bool neg = false;
+    int v = 0;
+    int digits = 0;
+    if(*p == '-' || *p == '+'){
+        neg = *p == '-';
+        p++;
+    }
+    while(*p >= '0' && *p <= '9'){
+        if(++digits > 6){
+            return false;
+        }
+        v = v * 10 + (*p++ - '0');
+    }
+    if(!digits || *p){
+        return false;
+    }
+    *out = neg ? -v : v;
+    return true;
+}
+
+static int control_apply_str(const char * variable, const char * value){
+    int val;
+    if(!control_parse_int(value, &val)){
+        return -1;
+    }
+    return control_apply(variable, val);
+}
+
+int control_apply_query(char * query, int * applied)
+{
+    const char * var = NULL;
+    const char * val = NULL;
+    int res = 0;
+    char * p = query;
+
+    *applied = 0;
+    while(true){
+        char * key = p;
+        char * value = NULL;
+        while(*p && *p != '&'){
+            if(*p == '=' && !value){
+                *p = 0;
+                value = p + 1;
+            }
+            p++;
+        }
+        bool last = !*p;
+        *p = 0;
+
+        if(value){
+            if(!strcmp(key, "var")){
+                var = value;
+            } else if(!strcmp(key, "val")){
+                val = value;
+            } else {
+                const control_cmd_t * cmd = control_find(key);
+                int v;
+                if(cmd){
+                    res |= control_parse_int(value, &v) ? control_run(cmd, v) : -1;
+                    (*applied)++;
+                }
+            }
+        }
+        if(var && val){
+            res |= control_apply_str(var, val);
+            (*applied)++;
+            var = val = NULL;
+        }
+
+        if(last){
+            break;
+        }
+        p++;
+    }
+    return res;
+}
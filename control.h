@@ -0,0 +1,34 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+
+typedef struct control_cmd control_cmd_t;
+typedef int (*control_fn_t)(const control_cmd_t * cmd, int val);
+
+struct control_cmd {
+        const char * name;
+        control_fn_t handler;
+        int16_t min;
+        int16_t max;
+        bool clamp;
+        int8_t channel;         // canal LEDC, -1 si no usa ninguno
+        int16_t scale;          // duty = val * scale
+        int8_t arg;             // lo que distingue a las entradas que comparten handler (eje de drivex/drivey)
+};
+
+const control_cmd_t * control_find(const char * variable);
+
+// Aplica un comando de /control (var, val). 0 si se aplico, distinto de 0 si no existe o fallo.
+int control_apply(const char * variable, int val);
+
+// Query mas larga que se acepta en /control
+#define CONTROL_QUERY_MAX 256
+
+// Aplica todos los comandos de una query en una sola pasada, partiendola en el propio buffer.
+// var=X&val=Y es un comando; cualquier otra clave del registro va como nombre=valor,
+// asi ?servo=500&servopan=400&speed=200 mueve varias cosas con una peticion. Las claves desconocidas se ignoran.
+// applied: comandos encontrados. Devuelve 0 si todos se aplicaron bien.
+int control_apply_query(char * query, int * applied);
+
+#endif
@@ -0,0 +1,71 @@
+#include "device_state.h"
+#include "metrics.h"
+#include "Arduino.h"
+
+// Mismo orden que state_field_t, son las claves del JSON (y los id de la pagina)
+static const char * const state_names[STATE_FIELDS] = {
+    "framesize", "quality", "flash", "speed", "nostop", "actstate",
+    "drivex", "drivey", "servo", "servopan", "servo3", "failsafe",
+    "motion", "motionevents", "motionx", "motiony", "motionw", "motionh", "recording"
+};
+
+static int32_t values[STATE_FIELDS] = {
+    0, 0, 0, 255, 0, 2, 0, 0, STATE_UNKNOWN, STATE_UNKNOWN, STATE_UNKNOWN, 0,
+    0, 0, STATE_UNKNOWN, STATE_UNKNOWN, STATE_UNKNOWN, STATE_UNKNOWN, 0
+};
+static uint32_t version = 1;
+static portMUX_TYPE state_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// 19 campos de como mucho 11 caracteres de valor, con clave y comillas caben de sobra
+static char json[608];
+static size_t json_len = 0;
+static uint32_t json_version = 0;
+
+void state_set(state_field_t field, int32_t value){
+    portENTER_CRITICAL(&state_mux);
+    if(values[field] != value){
+        values[field] = value;
+        version++;
+    }
+    portEXIT_CRITICAL(&state_mux);
+}
+
+uint32_t state_version(){
+    return version;
+}
+
+uint32_t state_snapshot(int32_t * out){
+    uint32_t v;
+    portENTER_CRITICAL(&state_mux);
+    memcpy(out, values, sizeof(values));
+    v = version;
+    portEXIT_CRITICAL(&state_mux);
+    return v;
+}
+
+size_t state_format(char * buf, size_t len, uint32_t v, const int32_t * snapshot, const int32_t * prev){
+    size_t used = snprintf(buf, len, "{\"version\":%u", v);
+    for(int i = 0; i < STATE_FIELDS && used < len; i++){
+        if(snapshot[i] != STATE_UNKNOWN && (!prev || prev[i] != snapshot[i])){
+            used += snprintf(buf + used, len - used, ",\"%s\":%d", state_names[i], snapshot[i]);
+        }
+    }
+    if(used + 2 > len){
+        return 0;
+    }
+    buf[used++] = '}';
+    buf[used] = 0;
+    return used;
+}
+
+const char * state_json(size_t * len){
+    if(json_version != version){
+        int32_t snapshot[STATE_FIELDS];
+        uint32_t snapshot_version = state_snapshot(snapshot);
+        json_len = state_format(json, sizeof(json), snapshot_version, snapshot, NULL);
+        json_version = snapshot_version;
+        metric_add(&metric_status_renders, 1);
+    }
+    *len = json_len;
+    return json;
+}
@@ -0,0 +1,50 @@
+#ifndef DEVICE_STATE_H
+#define DEVICE_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Estado de actuadores y camara que se publica en /status.
+// Cada escritura que cambia algo sube la version; /status solo vuelve a generar el JSON
+// si la version ha cambiado desde la ultima vez, y con ?since=<version> contesta "sin cambios".
+
+typedef enum {
+        STATE_FRAMESIZE,
+        STATE_QUALITY,
+        STATE_FLASH,
+        STATE_SPEED,
+        STATE_NOSTOP,
+        STATE_ACTSTATE,         // 0 adelante, 1 atras, 2 parado (enum state de control.cpp)
+        STATE_DRIVEX,
+        STATE_DRIVEY,
+        STATE_SERVO,            // objetivo de cada servo, en unidades de /control
+        STATE_SERVOPAN,
+        STATE_SERVO3,
+        STATE_FAILSAFE,         // 1 si el failsafe ha parado el coche, hasta el siguiente comando
+        STATE_MOTION,           // 1 mientras dura un evento de movimiento (motion_stage.h)
+        STATE_MOTION_EVENTS,
+        STATE_MOTION_X,         // ultimo rectangulo con movimiento, en pixeles del sensor
+        STATE_MOTION_Y,
+        STATE_MOTION_W,
+        STATE_MOTION_H,
+        STATE_RECORDING,        // 1 desde /recording?action=start hasta cerrar el archivo (recorder.h)
+        STATE_FIELDS
+} state_field_t;
+
+// Un servo no tiene posicion hasta su primer comando; no sale en el JSON
+#define STATE_UNKNOWN INT32_MIN
+
+// Desde cualquier tarea
+void state_set(state_field_t field, int32_t value);
+uint32_t state_version();
+
+// JSON del estado, regenerado solo si ha cambiado. Solo desde la tarea de camera_httpd.
+const char * state_json(size_t * len);
+
+// Copia de todos los campos de una vez; devuelve su version
+uint32_t state_snapshot(int32_t * out);
+// JSON de una copia. Con prev solo salen los campos que han cambiado respecto a ella.
+// Devuelve la longitud, 0 si no cabe.
+size_t state_format(char * buf, size_t len, uint32_t version, const int32_t * values, const int32_t * prev);
+
+#endif
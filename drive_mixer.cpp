@@ -0,0 +1,51 @@
+#include "drive_mixer.h"
+#include "actuators.h"
+
+// Todo en punto fijo Q10 (1024 = 100% del recorrido), sin float en el tick de control.
+// Rueda derecha: canal 4 avance, canal 3 atras. Rueda izquierda: canal 5 avance, canal 6 atras.
+
+#define Q10 1024
+
+// Zona muerta y expo sobre un eje; devuelve Q10 con signo
+static int32_t drive_shape(int v){
+    int a = v < 0 ? -v : v;
+    if(a > 100){
+        a = 100;
+    }
+    if(a <= DRIVE_DEADBAND){
+        return 0;
+    }
+    // Lo que queda fuera de la zona muerta vuelve a ocupar todo el rango
+    int32_t n = (int32_t)(a - DRIVE_DEADBAND) * Q10 / (100 - DRIVE_DEADBAND);
+    int32_t cube = n * n / Q10 * n / Q10;
+    int32_t e = DRIVE_EXPO * Q10 / 100;
+    int32_t out = (n * (Q10 - e) + cube * e) / Q10;
+    return v < 0 ? -out : out;
+}
+
+static void drive_wheel(int32_t q, int max_duty, uint8_t * fwd, uint8_t * rev){
+    int32_t d = (q < 0 ? -q : q) * max_duty / Q10;
+    *fwd = q > 0 ? d : 0;
+    *rev = q < 0 ? d : 0;
+}
+
+void drive_mixer_mix(int x, int y, int max_duty, uint8_t * duty){
+    int32_t turn = drive_shape(x);
+    int32_t thr = drive_shape(y);
+    int32_t left = thr + turn;
+    int32_t right = thr - turn;
+
+    // Si una rueda se sale de rango se escalan las dos, asi no cambia el radio de giro
+    int32_t peak = left < 0 ? -left : left;
+    int32_t r = right < 0 ? -right : right;
+    if(r > peak){
+        peak = r;
+    }
+    if(peak > Q10){
+        left = left * Q10 / peak;
+        right = right * Q10 / peak;
+    }
+
+    drive_wheel(right, max_duty, &duty[4 - MOTOR_FIRST_CHANNEL], &duty[3 - MOTOR_FIRST_CHANNEL]);
+    drive_wheel(left, max_duty, &duty[5 - MOTOR_FIRST_CHANNEL], &duty[6 - MOTOR_FIRST_CHANNEL]);
+}
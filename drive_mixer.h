@@ -0,0 +1,15 @@
+#ifndef DRIVE_MIXER_H
+#define DRIVE_MIXER_H
+
+#include <stdint.h>
+
+// Porcentaje del recorrido del joystick que se ignora alrededor del centro
+#define DRIVE_DEADBAND 8
+// Curva expo: 0 lineal, 100 cubica (mas finura cerca del centro)
+#define DRIVE_EXPO 40
+
+// Mezcla arcade: y avance/retroceso, x giro, ambos de -100 a 100.
+// Deja el duty de cada canal de motor (3, 4, 5, 6) en duty[], limitado a max_duty.
+void drive_mixer_mix(int x, int y, int max_duty, uint8_t * duty);
+
+#endif
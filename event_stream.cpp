@@ -0,0 +1,200 @@
+#include "event_stream.h"
+#include "device_state.h"
+#include "mjpeg_stream.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "Arduino.h"
+#include "freertos/semphr.h"
+#include "lwip/sockets.h"
+
+// Una sola tarea genera cada tick un mensaje con lo que ha cambiado y lo manda tal cual a todos.
+// El que se conecta recibe primero el estado completo; a partir de ahi solo diferencias.
+// Si un cliente no admite el envio entero se le cierra: con SSE un mensaje a medias corrompe el resto.
+
+// Sin nada que contar, un comentario cada tanto para que los proxies no corten y se note si el cliente se fue
+#define EVENTS_KEEPALIVE_US 15000000
+
+typedef struct {
+        int fd;
+        bool synced;            // ya tiene el estado completo, le valen las diferencias
+} event_client_t;
+
+static event_client_t clients[EVENTS_MAX_CLIENTS];
+static SemaphoreHandle_t clients_lock = NULL;
+static TaskHandle_t events_task_handle = NULL;
+static httpd_handle_t events_server = NULL;
+static volatile int period_ms = EVENTS_PERIOD_MS;
+static uint32_t client_count = 0;
+static uint32_t ticks = 0;
+
+// Mensaje compartido del tick y el de estado completo para los recien llegados
+static char message[1024];
+static char full[640];
+
+static void client_close(event_client_t * c){
+    int fd = c->fd;
+    c->fd = -1;
+    client_count--;
+    httpd_trigger_sess_close(events_server, fd);
+}
+
+// true solo si ha salido el mensaje entero
+static bool client_send(event_client_t * c, const char * data, size_t len){
+    int w = send(c->fd, data, len, MSG_DONTWAIT);
+    if(w == (int)len){
+        return true;
+    }
+    if(w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+        // No ha salido nada: se salta este tick y la proxima vez recibe el estado completo
+        c->synced = false;
+        return false;
+    }
+    client_close(c);
+    return false;
+}
+
+// "event: stream" con fps y bytes/s desde el tick anterior, NULL si es igual al ultimo enviado
+static size_t stream_event(char * buf, size_t len, int64_t now){
+    static mjpeg_stream_stats_t last = {0,};
+    static int64_t last_time = 0;
+    static char last_data[128];
+    mjpeg_stream_stats_t st;
+    mjpeg_stream_stats(&st);
+    float secs = last_time ? (now - last_time) / 1000000.0 : 0;
+    float fps = secs > 0 ? (st.frames - last.frames) / secs : 0;
+    float kbps = secs > 0 ? (st.wire_bytes - last.wire_bytes) * 8 / 1000.0 / secs : 0;
+    last = st;
+    last_time = now;
+
+    char data[128];
+    snprintf(data, sizeof(data), "{\"viewers\":%u,\"fps\":%.1f,\"kbps\":%.0f,\"quality\":%d,\"framesize\":%d}",
+             st.viewers, fps, kbps, st.abr_quality, st.abr_framesize);
+    if(!strcmp(data, last_data)){
+        return 0;
+    }
+    strcpy(last_data, data);
+    int n = snprintf(buf, len, "event: stream\ndata: %s\n\n", data);
+    return n > 0 && (size_t)n < len ? n : 0;
+}
+
+static void events_task(void * arg){
+    int32_t prev[STATE_FIELDS];
+    int32_t cur[STATE_FIELDS];
+    uint32_t prev_version = state_snapshot(prev);
+    int64_t last_sent = esp_timer_get_time();
+    TickType_t wake = xTaskGetTickCount();
+
+    while(true){
+        if(!client_count){
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            wake = xTaskGetTickCount();
+        }
+        vTaskDelayUntil(&wake, period_ms / portTICK_PERIOD_MS);
+        int64_t now = esp_timer_get_time();
+        ticks++;
+
+        // Se serializa una vez por tick, no una por cliente
+        size_t len = 0;
+        uint32_t version = state_snapshot(cur);
+        if(version != prev_version){
+            len += snprintf(message, sizeof(message), "event: state\ndata: ");
+            size_t n = state_format(message + len, sizeof(message) - len - 2, version, cur, prev);
+            len = n ? len + n : 0;
+            if(len){
+                message[len++] = '\n';
+                message[len++] = '\n';
+            }
+            memcpy(prev, cur, sizeof(prev));
+            prev_version = version;
+        }
+        len += stream_event(message + len, sizeof(message) - len, now);
+        if(!len && now - last_sent > EVENTS_KEEPALIVE_US){
+            len = snprintf(message, sizeof(message), ": keepalive\n\n");
+        }
+
+        size_t full_len = 0;
+        xSemaphoreTake(clients_lock, portMAX_DELAY);
+        for(int i = 0; i < EVENTS_MAX_CLIENTS; i++){
+            event_client_t * c = &clients[i];
+            if(c->fd < 0){
+                continue;
+            }
+            if(!c->synced){
+                if(!full_len){
+                    full_len = snprintf(full, sizeof(full), "event: state\ndata: ");
+                    size_t n = state_format(full + full_len, sizeof(full) - full_len - 2, version, cur, NULL);
+                    full_len += n;
+                    full[full_len++] = '\n';
+                    full[full_len++] = '\n';
+                }
+                if(!client_send(c, full, full_len)){
+                    continue;
+                }
+                c->synced = true;
+                // Las diferencias de este tick repiten parte del estado completo, no hace dano
+            }
+            if(len){
+                client_send(c, message, len);
+            }
+        }
+        xSemaphoreGive(clients_lock);
+        if(len){
+            last_sent = now;
+        }
+    }
+}
+
+void event_stream_start(httpd_handle_t server){
+    if(events_task_handle){
+        return;
+    }
+    events_server = server;
+    for(int i = 0; i < EVENTS_MAX_CLIENTS; i++){
+        clients[i].fd = -1;
+    }
+    clients_lock = xSemaphoreCreateMutex();
+    task_plan_create(TASK_EVENTS, events_task, NULL, &events_task_handle);
+}
+
+bool event_stream_add_client(int fd){
+    bool added = false;
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for(int i = 0; i < EVENTS_MAX_CLIENTS; i++){
+        event_client_t * c = &clients[i];
+        if(c->fd >= 0){
+            continue;
+        }
+        c->fd = fd;
+        c->synced = false;
+        client_count++;
+        added = true;
+        break;
+    }
+    xSemaphoreGive(clients_lock);
+    if(added){
+        xTaskNotifyGive(events_task_handle);
+    }
+    return added;
+}
+
+void event_stream_close_fn(httpd_handle_t hd, int fd){
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for(int i = 0; i < EVENTS_MAX_CLIENTS; i++){
+        if(clients[i].fd == fd){
+            clients[i].fd = -1;
+            client_count--;
+        }
+    }
+    xSemaphoreGive(clients_lock);
+    // El socket no: en IDF 3.x httpd_sess_delete lo cierra despues de close_fn, y un segundo close()
+    // podria llevarse por delante un socket nuevo que lwip ya hubiera dado con el mismo numero
+}
+
+void event_stream_set_period(int ms){
+    period_ms = ms;
+}
+
+void event_stream_stats(uint32_t * clients_out, uint32_t * ticks_out){
+    *clients_out = client_count;
+    *ticks_out = ticks;
+}
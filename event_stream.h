@@ -0,0 +1,26 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include "esp_http_server.h"
+
+// Server-Sent Events en /events de camera_httpd: cambios de estado y medidas del stream
+// empujados a la pagina, en vez de que cada navegador pregunte por su cuenta.
+// Cada conexion ocupa un socket de camera_httpd para siempre, asi que pocas.
+#define EVENTS_MAX_CLIENTS 3
+
+// Periodo por defecto entre envios; se cambia con /control?var=events&val=<ms>
+#define EVENTS_PERIOD_MS 250
+
+void event_stream_start(httpd_handle_t server);
+
+// El socket pasa a la tarea de eventos, el handler ya ha mandado las cabeceras HTTP
+bool event_stream_add_client(int fd);
+
+// close_fn de camera_httpd: solo suelta el cliente, el socket lo cierra el servidor
+void event_stream_close_fn(httpd_handle_t hd, int fd);
+
+void event_stream_set_period(int period_ms);
+
+void event_stream_stats(uint32_t * clients, uint32_t * ticks);
+
+#endif
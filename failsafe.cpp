@@ -0,0 +1,40 @@
+#include "failsafe.h"
+
+// Los tiempos van en ms de 32 bits: las restas sin signo siguen valiendo al dar la vuelta (49 dias)
+
+void failsafe_init(failsafe_t * fs, uint32_t timeout_ms){
+    fs->timeout_ms = timeout_ms;
+    fs->last_feed = 0;
+    fs->armed = false;
+}
+
+void failsafe_feed(failsafe_t * fs, uint32_t now_ms){
+    fs->last_feed = now_ms;
+    fs->armed = true;
+}
+
+uint32_t failsafe_left(const failsafe_t * fs, uint32_t now_ms){
+    if(!fs->armed || !fs->timeout_ms){
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = now_ms - fs->last_feed;
+    return elapsed < fs->timeout_ms ? fs->timeout_ms - elapsed : 0;
+}
+
+bool failsafe_expired(failsafe_t * fs, uint32_t now_ms){
+    if(failsafe_left(fs, now_ms)){
+        return false;
+    }
+    fs->armed = false;
+    return true;
+}
+
+// Bajar de golpe un motor lanzado puede volcar el coche o hacerlo derrapar, se quita un escalon por tick
+bool failsafe_ramp(uint8_t * duty, int n){
+    bool running = false;
+    for(int i = 0; i < n; i++){
+        duty[i] = duty[i] > FAILSAFE_RAMP_STEP ? duty[i] - FAILSAFE_RAMP_STEP : 0;
+        running |= duty[i] != 0;
+    }
+    return running;
+}
@@ -0,0 +1,39 @@
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include <stdint.h>
+
+// Hombre muerto del coche: cualquier comando de control (o el latido de la pagina) lo arma.
+// Si pasa el plazo sin que llegue nada, la tarea de actuadores frena los motores en rampa
+// y aparca los servos. Con noStop o el joystick quieto el coche no sigue solo si se cae la Wi-Fi.
+// No depende de nada del ESP32, se puede simular en el PC con perdidas de paquetes.
+
+#define FAILSAFE_TIMEOUT_MS 500         // por defecto, /control?var=failsafe&val=<ms>, 0 lo apaga
+#define FAILSAFE_MIN_MS 300             // por debajo salta entre dos latidos de la pagina (150 ms)
+#define FAILSAFE_RAMP_STEP 64           // duty que se quita por tick al frenar
+
+// Donde se dejan servo, servopan y servo3 (unidades de /control)
+#define FAILSAFE_PARK {487, 487, 487}
+
+// Ticks de CONTROL_TICK_MS para frenar desde el duty maximo; el primero se aplica al vencer el plazo
+#define FAILSAFE_RAMP_TICKS ((255 + FAILSAFE_RAMP_STEP - 1) / FAILSAFE_RAMP_STEP)
+// Peor caso desde el ultimo comando hasta los motores parados
+#define FAILSAFE_REACTION_MS(timeout, tick_ms) ((timeout) + FAILSAFE_RAMP_TICKS * (tick_ms))
+
+typedef struct {
+        uint32_t timeout_ms;    // 0 apagado
+        uint32_t last_feed;     // ms del ultimo comando
+        bool armed;             // hay un operador; se desarma al saltar
+} failsafe_t;
+
+void failsafe_init(failsafe_t * fs, uint32_t timeout_ms);
+// Ha llegado un comando en now_ms
+void failsafe_feed(failsafe_t * fs, uint32_t now_ms);
+// ms que quedan de plazo, UINT32_MAX si no hay nada que vigilar
+uint32_t failsafe_left(const failsafe_t * fs, uint32_t now_ms);
+// true si el plazo acaba de vencer; queda desarmado hasta el siguiente comando
+bool failsafe_expired(failsafe_t * fs, uint32_t now_ms);
+// Un escalon de la rampa de frenado sobre n duty. true mientras quede alguno sin parar.
+bool failsafe_ramp(uint8_t * duty, int n);
+
+#endif
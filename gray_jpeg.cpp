@@ -0,0 +1,337 @@
+#include "gray_jpeg.h"
+#include <math.h>
+#include <string.h>
+
+// Escala de la DCT: coeficientes Q13. Tras las filas se deja Q2 (4x el valor real),
+// tras las columnas tambien Q2, y la cuantizacion divide por 4 q a la vez que por q.
+#define DCT_BITS 13
+#define ROW_SHIFT (DCT_BITS - 2)
+
+// Tablas del anexo K de la norma: cuantizacion de luminancia y Huffman de luminancia DC/AC
+static const uint8_t base_qt[64] = {
+    16, 11, 10, 16,  24,  40,  51,  61,
+    12, 12, 14, 19,  26,  58,  60,  55,
+    14, 13, 16, 24,  40,  57,  69,  56,
+    14, 17, 22, 29,  51,  87,  80,  62,
+    18, 22, 37, 56,  68, 109, 103,  77,
+    24, 35, 55, 64,  81, 104, 113,  92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103,  99
+};
+
+static const uint8_t zigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static const uint8_t dc_bits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+static const uint8_t dc_vals[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+static const uint8_t ac_bits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+static const uint8_t ac_vals[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+typedef struct {
+        uint16_t code[256];
+        uint8_t size[256];
+} huff_table_t;
+
+static huff_table_t dc_huff;
+static huff_table_t ac_huff;
+// dct_t[x][u] = C(u)/2 cos((2x+1) u pi / 16) en Q13, traspuesta: el bucle interno recorre u
+static int16_t dct_t[8][8];
+static bool tables_ready = false;
+
+typedef struct {
+        uint8_t * out;
+        size_t cap;
+        size_t len;
+        uint32_t bits;
+        int nbits;
+        bool overflow;
+} bit_writer_t;
+
+static void huff_build(const uint8_t * bits, const uint8_t * vals, huff_table_t * h){
+    uint16_t code = 0;
+    int k = 0;
+    for(int len = 1; len <= 16; len++){
+        for(int i = 0; i < bits[len - 1]; i++){
+            h->code[vals[k]] = code++;
+            h->size[vals[k]] = len;
+            k++;
+        }
+        code <<= 1;
+    }
+}
+
+// Una vez, en el primer frame: el coseno solo se usa aqui
+static void tables_init(){
+    if(tables_ready){
+        return;
+    }
+    for(int x = 0; x < 8; x++){
+        for(int u = 0; u < 8; u++){
+            double c = (u ? 0.5 : 0.5 / sqrt(2.0)) * cos((2 * x + 1) * u * M_PI / 16);
+            dct_t[x][u] = (int16_t)lround(c * (1 << DCT_BITS));
+        }
+    }
+    huff_build(dc_bits, dc_vals, &dc_huff);
+    huff_build(ac_bits, ac_vals, &ac_huff);
+    tables_ready = true;
+}
+
+void gray_from_rgb888(const uint8_t * rgb, uint8_t * y, int n){
+    for(int i = 0; i < n; i++){
+        y[i] = (77 * rgb[3 * i] + 150 * rgb[3 * i + 1] + 29 * rgb[3 * i + 2] + 128) >> 8;
+    }
+}
+
+size_t gray_jpeg_bound(int width, int height){
+    // Un byte por pixel: con ruido puro se queda en 0.8 a calidad 90, a 100 llega a 1.6; mas las cabeceras
+    return (size_t)((width + 7) & ~7) * ((height + 7) & ~7) + 1024;
+}
+
+static void put_byte(bit_writer_t * w, uint8_t b){
+    if(w->len >= w->cap){
+        w->overflow = true;
+        return;
+    }
+    w->out[w->len++] = b;
+}
+
+static void put_bytes(bit_writer_t * w, const uint8_t * b, size_t n){
+    if(w->len + n > w->cap){
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->out + w->len, b, n);
+    w->len += n;
+}
+
+static void put_u16(bit_writer_t * w, uint16_t v){
+    put_byte(w, v >> 8);
+    put_byte(w, v & 0xff);
+}
+
+// Datos de entropia: 0xFF lleva detras un 0x00 para no confundirse con un marcador
+static void put_bits(bit_writer_t * w, uint32_t code, int size){
+    w->bits = (w->bits << size) | (code & ((1u << size) - 1));
+    w->nbits += size;
+    while(w->nbits >= 8){
+        uint8_t b = w->bits >> (w->nbits - 8);
+        put_byte(w, b);
+        if(b == 0xff){
+            put_byte(w, 0);
+        }
+        w->nbits -= 8;
+    }
+    w->bits &= (1u << w->nbits) - 1;
+}
+
+static void flush_bits(bit_writer_t * w){
+    if(w->nbits){
+        put_bits(w, 0x7f, 8 - w->nbits);
+    }
+}
+
+static void write_headers(bit_writer_t * w, int width, int height, const uint8_t * qt){
+    static const uint8_t soi_app0[] = {
+        0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00
+    };
+    put_bytes(w, soi_app0, sizeof(soi_app0));
+
+    put_u16(w, 0xffdb);
+    put_u16(w, 2 + 1 + 64);
+    put_byte(w, 0x00);
+    for(int i = 0; i < 64; i++){
+        put_byte(w, qt[zigzag[i]]);
+    }
+
+    // SOF0 con un solo componente, sin submuestreo
+    put_u16(w, 0xffc0);
+    put_u16(w, 11);
+    put_byte(w, 8);
+    put_u16(w, height);
+    put_u16(w, width);
+    put_byte(w, 1);
+    put_byte(w, 1);
+    put_byte(w, 0x11);
+    put_byte(w, 0);
+
+    put_u16(w, 0xffc4);
+    put_u16(w, 2 + 1 + 16 + sizeof(dc_vals));
+    put_byte(w, 0x00);
+    put_bytes(w, dc_bits, sizeof(dc_bits));
+    put_bytes(w, dc_vals, sizeof(dc_vals));
+    put_u16(w, 0xffc4);
+    put_u16(w, 2 + 1 + 16 + sizeof(ac_vals));
+    put_byte(w, 0x10);
+    put_bytes(w, ac_bits, sizeof(ac_bits));
+    put_bytes(w, ac_vals, sizeof(ac_vals));
+
+    static const uint8_t sos[] = {0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00, 0x3f, 0x00};
+    put_bytes(w, sos, sizeof(sos));
+}
+
+// Bloque de 8x8 centrado en 0; fuera de la imagen se repite el borde
+static void block_load(const uint8_t * gray, int stride, int x0, int y0, int width, int height, int16_t * blk){
+    int cols[8];
+    for(int x = 0; x < 8; x++){
+        cols[x] = x0 + x < width ? x0 + x : width - 1;
+    }
+    for(int y = 0; y < 8; y++){
+        const uint8_t * row = gray + (size_t)(y0 + y < height ? y0 + y : height - 1) * stride;
+        if(x0 + 8 <= width){
+            for(int x = 0; x < 8; x++){
+                blk[y * 8 + x] = row[x0 + x] - 128;
+            }
+        } else {
+            for(int x = 0; x < 8; x++){
+                blk[y * 8 + x] = row[cols[x]] - 128;
+            }
+        }
+    }
+}
+
+// DCT 2D separable como dos productos de matrices. Cada acumulador es un carril: acc[u] += v * T[x][u].
+static void block_dct(const int16_t * blk, int32_t * coef){
+    int32_t rows[64];
+    for(int y = 0; y < 8; y++){
+        int32_t acc[8] = {0,};
+        for(int x = 0; x < 8; x++){
+            int32_t v = blk[y * 8 + x];
+            for(int u = 0; u < 8; u++){
+                acc[u] += v * dct_t[x][u];
+            }
+        }
+        for(int u = 0; u < 8; u++){
+            rows[y * 8 + u] = (acc[u] + (1 << (ROW_SHIFT - 1))) >> ROW_SHIFT;
+        }
+    }
+    int32_t acc[64] = {0,};
+    for(int y = 0; y < 8; y++){
+        for(int v = 0; v < 8; v++){
+            int32_t c = dct_t[y][v];
+            for(int u = 0; u < 8; u++){
+                acc[v * 8 + u] += c * rows[y * 8 + u];
+            }
+        }
+    }
+    for(int i = 0; i < 64; i++){
+        coef[i] = (acc[i] + (1 << (DCT_BITS - 1))) >> DCT_BITS;
+    }
+}
+
+// Redondeo al mas cercano con el inverso Q16 de 4 q; el signo aparte para que sea simetrico
+static void block_quantize(const int32_t * coef, const uint16_t * recip, int16_t * q){
+    int32_t out[64];
+    for(int i = 0; i < 64; i++){
+        int32_t c = coef[i];
+        int32_t a = c < 0 ? -c : c;
+        int32_t m = (a * recip[i] + (1 << 15)) >> 16;
+        out[i] = c < 0 ? -m : m;
+    }
+    for(int i = 0; i < 64; i++){
+        q[i] = out[zigzag[i]];
+    }
+}
+
+static int bit_count(int v){
+    int a = v < 0 ? -v : v;
+    int n = 0;
+    while(a){
+        n++;
+        a >>= 1;
+    }
+    return n;
+}
+
+static void put_value(bit_writer_t * w, int v, int size){
+    put_bits(w, v < 0 ? v + (1 << size) - 1 : v, size);
+}
+
+static void block_encode(bit_writer_t * w, const int16_t * q, int * prev_dc){
+    int diff = q[0] - *prev_dc;
+    *prev_dc = q[0];
+    int size = bit_count(diff);
+    put_bits(w, dc_huff.code[size], dc_huff.size[size]);
+    if(size){
+        put_value(w, diff, size);
+    }
+
+    int run = 0;
+    for(int i = 1; i < 64; i++){
+        if(!q[i]){
+            run++;
+            continue;
+        }
+        while(run > 15){
+            put_bits(w, ac_huff.code[0xf0], ac_huff.size[0xf0]);
+            run -= 16;
+        }
+        size = bit_count(q[i]);
+        int sym = (run << 4) | size;
+        put_bits(w, ac_huff.code[sym], ac_huff.size[sym]);
+        put_value(w, q[i], size);
+        run = 0;
+    }
+    if(run){
+        put_bits(w, ac_huff.code[0x00], ac_huff.size[0x00]);
+    }
+}
+
+size_t gray_jpeg_encode(const uint8_t * gray, int width, int height, int stride, int quality,
+                        uint8_t * out, size_t cap){
+    tables_init();
+    if(quality < 1){
+        quality = 1;
+    } else if(quality > 100){
+        quality = 100;
+    }
+
+    // Escalado de libjpeg sobre la tabla base
+    int scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+    uint8_t qt[64];
+    uint16_t recip[64];
+    for(int i = 0; i < 64; i++){
+        int q = (base_qt[i] * scale + 50) / 100;
+        q = q < 1 ? 1 : q > 255 ? 255 : q;
+        qt[i] = q;
+        recip[i] = (65536 + 2 * q) / (4 * q);
+    }
+
+    bit_writer_t w = {out, cap, 0, 0, 0, false};
+    write_headers(&w, width, height, qt);
+
+    int16_t blk[64];
+    int32_t coef[64];
+    int16_t q[64];
+    int prev_dc = 0;
+    for(int by = 0; by < height && !w.overflow; by += 8){
+        for(int bx = 0; bx < width; bx += 8){
+            block_load(gray, stride, bx, by, width, height, blk);
+            block_dct(blk, coef);
+            block_quantize(coef, recip, q);
+            block_encode(&w, q, &prev_dc);
+        }
+    }
+    flush_bits(&w);
+    put_u16(&w, 0xffd9);
+    return w.overflow ? 0 : w.len;
+}
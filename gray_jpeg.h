@@ -0,0 +1,28 @@
+#ifndef GRAY_JPEG_H
+#define GRAY_JPEG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Codificador JPEG de un solo canal (luminancia) para la vista previa de /stream?preview=gray.
+// Todo en punto fijo: DCT por producto de matrices 8x8 con coeficientes Q13, cuantizacion
+// multiplicando por el inverso y Huffman con las tablas estandar. Los bucles internos son de
+// longitud fija y sin ramas para que el compilador los pueda vectorizar.
+// No depende de nada del ESP32, se puede medir en el PC contra fmt2jpg.
+
+// Calidad por defecto de la vista previa (1..100, como libjpeg: mas alto = mejor)
+#define GRAY_JPEG_QUALITY 50
+
+// RGB888 a luminancia, n pixeles: Y = (77 R + 150 G + 29 B) / 256
+void gray_from_rgb888(const uint8_t * rgb, uint8_t * y, int n);
+
+// Cota del JPEG de una imagen de width x height hasta calidad 90, para reservar la salida.
+// Por encima, con mucho detalle, puede no caber y gray_jpeg_encode devuelve 0.
+size_t gray_jpeg_bound(int width, int height);
+
+// Codifica gray (stride bytes por fila) en out. Devuelve la longitud, 0 si no cabe en cap.
+// Los bordes que no llenan un bloque de 8x8 repiten la ultima fila o columna.
+size_t gray_jpeg_encode(const uint8_t * gray, int width, int height, int stride, int quality,
+                        uint8_t * out, size_t cap);
+
+#endif
@@ -0,0 +1,387 @@
+// CANAL DE CONTROL POR WEBSOCKET (puerto 82), SI NO ESTA ABIERTO SE USA /control
+      // Trama de 8 bytes little-endian: opcode, canal, valor int16, secuencia uint32
+      var ctlChannels = ['framesize','quality','flash','speed','nostop','servo','servopan','servo3','car','drivex','drivey'];
+      var ctlSocket = null, ctlSeq = 0, ctlSent = {}, ctlRtt = [], ctlCount = 0;
+
+      function ctlConnect()
+      {
+        var ws = new WebSocket('ws://' + document.location.hostname + ':82/');
+        ws.binaryType = 'arraybuffer';
+        ws.onopen = function() { ctlSocket = ws; };
+        ws.onclose = function() { ctlSocket = null; setTimeout(ctlConnect, 2000); };
+        ws.onmessage = function(e)
+        {
+          var d = new DataView(e.data);
+          for (var i = 0; i + 8 <= d.byteLength; i += 8)
+          {
+            var seq = d.getUint32(i + 4, true);
+            if (ctlSent[seq] !== undefined)
+            {
+              ctlRtt.push(performance.now() - ctlSent[seq]);
+              if (ctlRtt.length > 50) ctlRtt.shift();
+              delete ctlSent[seq];
+            }
+          }
+        };
+      }
+
+      // Escribe una trama SET en la posicion off del DataView
+      function ctlFrame(d, off, ch, val)
+      {
+        ctlSeq = (ctlSeq + 1) >>> 0;
+        d.setUint8(off, 1);
+        d.setUint8(off + 1, ch);
+        d.setInt16(off + 2, parseInt(val), true);
+        d.setUint32(off + 4, ctlSeq, true);
+        ctlSent[ctlSeq] = performance.now();
+        delete ctlSent[ctlSeq - 100];
+      }
+
+      function sendControl(name, val)
+      {
+        var ch = ctlChannels.indexOf(name);
+        ctlCount++;
+        if (ctlSocket && ch >= 0)
+        {
+          var d = new DataView(new ArrayBuffer(8));
+          ctlFrame(d, 0, ch, val);
+          ctlSocket.send(d.buffer);
+        }
+        else
+        {
+          fetch(document.location.origin + '/control?var=' + name + '&val=' + val);
+        }
+      }
+
+      // Joystick de conduccion: los dos ejes van juntos y solo cuando cambian
+      var driveLast = '';
+      function sendDrive(x, y)
+      {
+        var key = x + ',' + y;
+        if (key === driveLast) return;
+        driveLast = key;
+        ctlCount += 2;
+        if (ctlSocket)
+        {
+          var d = new DataView(new ArrayBuffer(16));
+          ctlFrame(d, 0, ctlChannels.indexOf('drivex'), x);
+          ctlFrame(d, 8, ctlChannels.indexOf('drivey'), y);
+          ctlSocket.send(d.buffer);
+        }
+        else
+        {
+          fetch(document.location.origin + '/control?drivex=' + x + '&drivey=' + y);
+        }
+      }
+
+      // Comandos por segundo y mediana de ida y vuelta de las ultimas 50 respuestas
+      setInterval(function()
+      {
+        var el = document.getElementById('ctlstat');
+        var s = ctlRtt.slice().sort(function(a, b) { return a - b; });
+        if (el) el.innerHTML = (ctlSocket ? 'WS ' : 'HTTP ') + ctlCount + ' cmd/s' + (s.length ? ', mediana ' + s[s.length >> 1].toFixed(1) + ' ms' : '');
+        ctlCount = 0;
+      }, 1000);
+
+      // Latido para el failsafe de la placa: con el joystick fuera del centro se repite su posicion
+      // (si el coche se paro por un corte, vuelve a andar), si no, un PING. Menos de 1/3 del plazo.
+      setInterval(function()
+      {
+        if (driveLast !== '' && driveLast !== '0,0') { driveLast = ''; return; }
+        if (ctlSocket)
+        {
+          var d = new DataView(new ArrayBuffer(8));
+          ctlSeq = (ctlSeq + 1) >>> 0;
+          d.setUint8(0, 2);
+          d.setUint32(4, ctlSeq, true);
+          ctlSocket.send(d.buffer);
+        }
+        else
+        {
+          fetch(document.location.origin + '/control?var=heartbeat&val=1');
+        }
+      }, 150);
+
+      ctlConnect();
+
+// TELEMETRIA POR SERVER-SENT EVENTS (/events), LA PLACA AVISA DE LOS CAMBIOS
+      var telemetry = {};
+      function telemetryShow()
+      {
+        var el = document.getElementById('telemetry');
+        if (!el) return;
+        el.innerHTML = (telemetry.fps !== undefined ? telemetry.fps + ' fps, ' + telemetry.kbps + ' kbit/s, ' + telemetry.viewers + ' viendo. ' : '') +
+                       'Speed ' + telemetry.speed + ', servos ' + telemetry.servo + '/' + telemetry.servopan + '/' + telemetry.servo3 +
+                       (telemetry.failsafe ? '. FAILSAFE: parado por falta de comandos' : '') +
+                       (telemetry.motion ? '. MOVIMIENTO en ' + telemetry.motionx + ',' + telemetry.motiony + ' ' + telemetry.motionw + 'x' + telemetry.motionh : '');
+      }
+      function telemetryConnect()
+      {
+        if (!window.EventSource) return;
+        var es = new EventSource(document.location.origin + '/events');
+        es.addEventListener('state', function(e)
+        {
+          var d = JSON.parse(e.data);
+          for (var k in d)
+          {
+            telemetry[k] = d[k];
+            // Los controles siguen lo que hace la placa (otro navegador, el control de bitrate), salvo el que se esta tocando
+            var el = document.getElementById(k);
+            if (!el || el === document.activeElement) continue;
+            if (el.type === 'checkbox') el.checked = !!d[k];
+            else if (el.type === 'range') el.value = d[k];
+          }
+          telemetryShow();
+        });
+        es.addEventListener('stream', function(e)
+        {
+          var d = JSON.parse(e.data);
+          telemetry.fps = d.fps;
+          telemetry.kbps = d.kbps;
+          telemetry.viewers = d.viewers;
+          telemetryShow();
+        });
+      }
+      telemetryConnect();
+
+// VIDEO LEIDO CON FETCH: CADA PARTE DEL MJPEG TRAE X-Timestamp (CAPTURA, us) Y X-Frame-Seq
+      // Cada frame se pinta en el <img> como blob. Una vez por segundo se devuelve el X-Timestamp del frame
+      // pintado a /latency: su edad menos media ida y vuelta es la latencia de la captura a la pantalla.
+      // Sin fetch con streams se usa el <img> directamente, como antes, y no hay medida.
+      var videoAbort = null, videoUrl = null, videoLastSeq = 0, videoProbeAt = 0;
+      var videoLatency = null, videoDropped = 0, videoDroppedTotal = 0;
+
+      function videoShow()
+      {
+        var el = document.getElementById('videostat');
+        if (el) el.innerHTML = 'Latencia ' + (videoLatency === null ? '-' : videoLatency.toFixed(0) + ' ms') + ', ' + videoDroppedTotal + ' frames perdidos';
+      }
+
+      function videoProbe(ts, t0)
+      {
+        var dropped = videoDropped;
+        videoDropped = 0;
+        fetch(document.location.origin + '/latency?ts=' + ts + '&dropped=' + dropped).then(function(r) { return r.json(); }).then(function(d)
+        {
+          videoLatency = Math.max(0, d.age_us / 1000 - (performance.now() - t0) / 2);
+          videoShow();
+        }).catch(function() {});
+      }
+
+      function videoFrame(img, jpeg, head)
+      {
+        var ts = /X-Timestamp: (\d+)/i.exec(head), seq = /X-Frame-Seq: (\d+)/i.exec(head);
+        seq = seq ? parseInt(seq[1]) : 0;
+        if (videoLastSeq && seq > videoLastSeq + 1)
+        {
+          videoDropped += seq - videoLastSeq - 1;
+          videoDroppedTotal += seq - videoLastSeq - 1;
+        }
+        videoLastSeq = seq;
+        // Si el anterior aun no se habia pintado, se descarta
+        if (videoUrl) URL.revokeObjectURL(videoUrl);
+        videoUrl = URL.createObjectURL(new Blob([jpeg], { type: 'image/jpeg' }));
+        img.onload = function()
+        {
+          var now = performance.now();
+          if (ts && now - videoProbeAt > 1000)
+          {
+            videoProbeAt = now;
+            videoProbe(ts[1], now);
+          }
+        };
+        img.src = videoUrl;
+      }
+
+      // Fin de la cabecera de una parte (\r\n\r\n) a partir de off, -1 si aun no ha llegado
+      function videoHeaderEnd(buf, off, len)
+      {
+        for (var i = off; i + 3 < len; i++)
+          if (buf[i] === 13 && buf[i + 1] === 10 && buf[i + 2] === 13 && buf[i + 3] === 10) return i;
+        return -1;
+      }
+
+      function videoStop()
+      {
+        if (videoAbort) videoAbort.abort();
+        videoAbort = null;
+        videoLastSeq = 0;
+      }
+
+      function videoStart(img, url)
+      {
+        videoStop();
+        if (!window.fetch || !window.AbortController || !window.ReadableStream) { img.src = url; return; }
+        var ctl = new AbortController();
+        videoAbort = ctl;
+        fetch(url, { signal: ctl.signal }).then(function(r)
+        {
+          var reader = r.body.getReader();
+          var buf = new Uint8Array(65536), len = 0;
+          function pump()
+          {
+            return reader.read().then(function(res)
+            {
+              if (res.done) return;
+              var v = res.value;
+              if (len + v.length > buf.length)
+              {
+                var grown = new Uint8Array(Math.max(buf.length * 2, len + v.length));
+                grown.set(buf.subarray(0, len));
+                buf = grown;
+              }
+              buf.set(v, len);
+              len += v.length;
+              // Cabecera y cuerpo por Content-Length; la boundary queda delante de la siguiente cabecera
+              var off = 0;
+              while (true)
+              {
+                var end = videoHeaderEnd(buf, off, len);
+                if (end < 0) break;
+                var head = String.fromCharCode.apply(null, buf.subarray(off, end));
+                var m = /Content-Length: (\d+)/i.exec(head);
+                if (!m) { off = end + 4; continue; }
+                var size = parseInt(m[1]);
+                if (end + 4 + size > len) break;
+                if (ctl === videoAbort) videoFrame(img, buf.slice(end + 4, end + 4 + size), head);
+                off = end + 4 + size;
+              }
+              buf.copyWithin(0, off, len);
+              len -= off;
+              return pump();
+            });
+          }
+          return pump();
+        }).catch(function() {});
+      }
+
+// VARIABLES JOYSTICKS
+          // Create JoyStick object into the DIV 'joy1Div'
+          var Joy1 = new JoyStick('joy1Div');
+
+          var joy1IinputPosX = document.getElementById("joy1PosizioneX");
+          var joy1InputPosY = document.getElementById("joy1PosizioneY");
+          var joy1Direzione = document.getElementById("joy1Direzione");
+          var joy1X = document.getElementById("joy1X");
+          var joy1Y = document.getElementById("joy1Y");
+
+          var joy1Speed = document.getElementById("joy1Speed");             /*SPEED*/
+
+          setInterval(function(){ joy1IinputPosX.value=Joy1.GetPosX(); }, 50);
+          setInterval(function(){ joy1InputPosY.value=Joy1.GetPosY(); }, 50);
+          setInterval(function(){ joy1Direzione.value=Joy1.GetDir(); }, 50);
+          setInterval(function(){ joy1X.value=Joy1.GetX(); }, 50);
+          setInterval(function(){ joy1Y.value=Joy1.GetY(); }, 50);
+
+          setInterval(function(){ joy1Speed.value=Joy1.GetSpeed(); }, 50);    /*SPEED*/
+
+          // El joystick 1 conduce el coche, el mezclado de ruedas lo hace la placa
+          setInterval(function(){ sendDrive(parseInt(Joy1.GetX()), parseInt(Joy1.GetY())); }, 50);
+
+          // Create JoyStick object into the DIV 'joy2Div'
+          var joy2Param = { "title": "joystick2", "autoReturnToCenter": false };
+          var Joy2 = new JoyStick('joy2Div', joy2Param);
+
+          var joy2IinputPosX = document.getElementById("joy2PosizioneX");
+          var joy2InputPosY = document.getElementById("joy2PosizioneY");
+          var joy2Direzione = document.getElementById("joy2Direzione");
+          var joy2X = document.getElementById("joy2X");
+          var joy2Y = document.getElementById("joy2Y");
+          
+          var joy2Speed = document.getElementById("joy2Speed");             /*SPEED*/
+
+          setInterval(function(){ joy2IinputPosX.value=Joy2.GetPosX(); }, 50);
+          setInterval(function(){ joy2InputPosY.value=Joy2.GetPosY(); }, 50);
+          setInterval(function(){ joy2Direzione.value=Joy2.GetDir(); }, 50);
+          setInterval(function(){ joy2X.value=Joy2.GetX(); }, 50);
+          setInterval(function(){ joy2Y.value=Joy2.GetY(); }, 50);
+          
+          setInterval(function(){ joy2Speed.value=Joy2.GetSpeed(); }, 50);    /*SPEED*/
+
+// ESTE ES EL ORIGINAL, AUN NO SE POR DONDE METERLE MANO
+          document.addEventListener('DOMContentLoaded',
+      
+      function()
+          {function b(B)
+          {let C;switch(B.type)
+          {case'checkbox':C=B.checked?1:0;
+           break;
+           case'range':case'select-one':C=B.value;
+           break;
+           case'button':case'submit':C='1';
+           break;
+           default:return;}
+           
+           const D=`${c}/control?var=${B.id}&val=${C}`;
+           fetch(D).then(E=>{console.log(`request to ${D} finished, status: ${E.status}`)})
+           }
+           
+           var c=document.location.origin;
+           const e=B=>{B.classList.add('hidden')},
+           f=B=>{B.classList.remove('hidden')},
+           g=B=>{B.classList.add('disabled'),
+           B.disabled=!0},
+           h=B=>{B.classList.remove('disabled'),
+           B.disabled=!1},
+           i=(B,C,D)=>{D=!(null!=D)||D;let E;
+           'checkbox'===B.type?(E=B.checked,
+                      C=!!C,B.checked=C):
+                      
+                     (E=B.value,B.value=C),
+                      D&&E!==C?b(B):
+                      
+                      !D&&('aec'===B.id?C?e(v):                     
+                      f(v):'agc'===B.id?C?(f(t),
+                      e(s)):
+                      (e(t),f(s)):
+                      'awb_gain'===B.id?C?f(x):
+                      e(x):
+                      'face_recognize'===B.id&&(C?h(n):
+                      g(n)))};
+                      document.querySelectorAll('.close').forEach(B=>{B.onclick=()=>{e(B.parentNode)}}),
+                      fetch(`${c}/status`).then(function(B){return B.json()}).then(function(B){document.querySelectorAll('.default-action').forEach(C=>{i(C,B[C.id],!1)})});
+                      
+                      const j=document.getElementById('stream'),
+                        k=document.getElementById('stream-container'),
+                        l=document.getElementById('get-still'),
+                        m=document.getElementById('toggle-stream'),
+                        n=document.getElementById('face_enroll'),
+                        o=document.getElementById('close-stream'),
+                        
+                        p=()=>{window.stop(),videoStop(),m.innerHTML='Start Stream'},
+                        
+                        q=()=>{videoStart(j,`${c+':81'}/stream`),
+                        f(k),m.innerHTML='Stop Stream'};
+                        
+                        l.onclick=()=>{p(),
+                        j.src=`${c}/capture?_cb=${Date.now()}`,
+                        f(k)},
+                        o.onclick=()=>{p(),
+                        e(k)},
+                        m.onclick=()=>{const B='Stops Stream'===m.innerHTML;
+                        B?p():q()},
+                        n.onclick=()=>{b(n)},
+                        document.querySelectorAll('.default-action').forEach(B=>{B.onchange=()=>b(B)});
+                        const r=document.getElementById('agc'),
+                        s=document.getElementById('agc_gain-group'),
+                        t=document.getElementById('gainceiling-group');
+                        r.onchange=()=>{b(r),
+                        r.checked?(f(t),e(s)):(e(t),f(s))};
+                        const u=document.getElementById('aec'),
+                        v=document.getElementById('aec_value-group');
+                        u.onchange=()=>{b(u),
+                        u.checked?e(v):f(v)};
+                        const w=document.getElementById('awb_gain'),
+                        x=document.getElementById('wb_mode-group');
+                        w.onchange=()=>{b(w),
+                        w.checked?f(x):e(x)};
+                        const y=document.getElementById('face_detect'),
+                        z=document.getElementById('face_recognize'),
+                        A=document.getElementById('framesize');
+                        A.onchange=()=>{b(A),
+                        5<A.value&&(i(y,!1),
+                        i(z,!1))},
+                        y.onchange=()=>{return 5<A.value?(alert('Please select CIF or lower resolution before enabling this feature!'),
+                        void i(y,!1)):void(b(y),!y.checked&&(g(n),i(z,!1)))},
+                        z.onchange=()=>{return 5<A.value?(alert('Please select CIF or lower resolution before enabling this feature!'),
+                        void i(z,!1)):void(b(z),z.checked?(h(n),i(y,!0)):g(n))}});
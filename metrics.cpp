@@ -0,0 +1,201 @@
+#include "metrics.h"
+#include <stdio.h>
+#include <string.h>
+
+#define US 1000000
+
+static const uint32_t frame_us_bounds[] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, 2000000};
+static const uint32_t control_us_bounds[] = {20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 50000};
+static const uint32_t frame_bytes_bounds[] = {2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144};
+static const uint32_t failsafe_us_bounds[] = {100000, 250000, 500000, 600000, 750000, 1000000, 2000000, 5000000, 10000000};
+
+#define BUCKETS(b) (sizeof(b) / sizeof(b[0]))
+
+static uint32_t capture_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t send_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t preview_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t motion_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t display_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t record_write_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t snapshot_counts[BUCKETS(frame_us_bounds) + 1];
+static uint32_t frame_bytes_counts[BUCKETS(frame_bytes_bounds) + 1];
+static uint32_t control_http_counts[BUCKETS(control_us_bounds) + 1];
+static uint32_t control_ws_counts[BUCKETS(control_us_bounds) + 1];
+static uint32_t failsafe_counts[BUCKETS(failsafe_us_bounds) + 1];
+
+#define HISTOGRAM(name, help, labels, scale, bounds, counts) \
+    { name, help, labels, METRIC_HISTOGRAM, scale, bounds, BUCKETS(bounds), counts, 0 }
+#define SCALAR(name, help, type, scale) \
+    { name, help, NULL, type, scale, NULL, 0, NULL, 0 }
+
+metric_t metric_capture_us = HISTOGRAM("esp32cam_capture_seconds",
+    "Tiempo para obtener un frame del driver y copiarlo al anillo", NULL, US, frame_us_bounds, capture_counts);
+metric_t metric_frame_bytes = HISTOGRAM("esp32cam_frame_bytes",
+    "Tamano de los JPEG capturados", NULL, 1, frame_bytes_bounds, frame_bytes_counts);
+metric_t metric_send_us = HISTOGRAM("esp32cam_stream_send_seconds",
+    "Tiempo de envio de un frame a un cliente del stream", NULL, US, frame_us_bounds, send_counts);
+metric_t metric_preview_us = HISTOGRAM("esp32cam_preview_encode_seconds",
+    "Tiempo de generar un frame de la vista previa en gris", NULL, US, frame_us_bounds, preview_counts);
+metric_t metric_motion_us = HISTOGRAM("esp32cam_motion_seconds",
+    "Tiempo de analizar un frame en busca de movimiento", NULL, US, frame_us_bounds, motion_counts);
+metric_t metric_display_age_us = HISTOGRAM("esp32cam_display_age_seconds",
+    "Edad del frame que la pagina acaba de pintar, de la captura a /latency", NULL, US, frame_us_bounds, display_counts);
+metric_t metric_record_write_us = HISTOGRAM("esp32cam_record_write_seconds",
+    "Tiempo de escribir un buffer de la grabacion en la tarjeta SD", NULL, US, frame_us_bounds, record_write_counts);
+metric_t metric_snapshot_us = HISTOGRAM("esp32cam_snapshot_seconds",
+    "Duracion de las peticiones a /capture", NULL, US, frame_us_bounds, snapshot_counts);
+metric_t metric_control_http_us = HISTOGRAM("esp32cam_control_seconds",
+    "Latencia de aplicar comandos de control", "transport=\"http\"", US, control_us_bounds, control_http_counts);
+metric_t metric_control_ws_us = HISTOGRAM("esp32cam_control_seconds",
+    "Latencia de aplicar comandos de control", "transport=\"ws\"", US, control_us_bounds, control_ws_counts);
+metric_t metric_failsafe_reaction_us = HISTOGRAM("esp32cam_failsafe_reaction_seconds",
+    "Del ultimo comando a los motores parados cuando salta el failsafe", NULL, US, failsafe_us_bounds, failsafe_counts);
+
+metric_t metric_frames_captured = SCALAR("esp32cam_frames_captured_total", "Frames recibidos del sensor", METRIC_COUNTER, 1);
+metric_t metric_frames_dropped = SCALAR("esp32cam_frames_dropped_total", "Frames perdidos sin hueco en el anillo", METRIC_COUNTER, 1);
+metric_t metric_frames_skipped = SCALAR("esp32cam_stream_frames_skipped_total", "Frames que un cliente lento no llego a ver", METRIC_COUNTER, 1);
+metric_t metric_frames_sent = SCALAR("esp32cam_stream_frames_sent_total", "Frames enviados completos, todos los clientes", METRIC_COUNTER, 1);
+metric_t metric_stream_bytes = SCALAR("esp32cam_stream_bytes_total", "Bytes escritos en los sockets del stream", METRIC_COUNTER, 1);
+metric_t metric_stream_viewers = SCALAR("esp32cam_stream_viewers", "Clientes conectados al stream", METRIC_GAUGE, 1);
+metric_t metric_control_requests = SCALAR("esp32cam_control_requests_total", "Peticiones a /control", METRIC_COUNTER, 1);
+metric_t metric_display_dropped = SCALAR("esp32cam_display_dropped_total", "Frames que las paginas no llegaron a pintar", METRIC_COUNTER, 1);
+metric_t metric_snapshot_reused = SCALAR("esp32cam_snapshot_reused_total", "Peticiones a /capture servidas con el ultimo frame del stream", METRIC_COUNTER, 1);
+metric_t metric_status_requests = SCALAR("esp32cam_status_requests_total", "Peticiones a /status", METRIC_COUNTER, 1);
+metric_t metric_status_renders = SCALAR("esp32cam_status_renders_total", "JSON de /status regenerados por cambios de estado", METRIC_COUNTER, 1);
+metric_t metric_ws_commands = SCALAR("esp32cam_ws_commands_total", "Comandos recibidos por el canal WebSocket", METRIC_COUNTER, 1);
+metric_t metric_events_clients = SCALAR("esp32cam_events_clients", "Navegadores conectados a /events", METRIC_GAUGE, 1);
+metric_t metric_record_frames = SCALAR("esp32cam_record_frames_total", "Frames copiados a la grabacion en SD", METRIC_COUNTER, 1);
+metric_t metric_record_dropped = SCALAR("esp32cam_record_dropped_total", "Frames sin grabar porque la tarjeta no daba abasto", METRIC_COUNTER, 1);
+metric_t metric_clip_bytes = SCALAR("esp32cam_clip_bytes_total", "Bytes de grabaciones descargados por /clips", METRIC_COUNTER, 1);
+metric_t metric_motion_events = SCALAR("esp32cam_motion_events_total", "Eventos de movimiento detectados", METRIC_COUNTER, 1);
+metric_t metric_heap_free = SCALAR("esp32cam_heap_free_bytes", "Heap interno libre", METRIC_GAUGE, 1);
+metric_t metric_heap_min_free = SCALAR("esp32cam_heap_min_free_bytes", "Minimo de heap libre desde el arranque", METRIC_GAUGE, 1);
+metric_t metric_psram_free = SCALAR("esp32cam_psram_free_bytes", "PSRAM libre", METRIC_GAUGE, 1);
+metric_t metric_psram_largest = SCALAR("esp32cam_psram_largest_free_bytes", "Mayor bloque libre de PSRAM, baja si se fragmenta", METRIC_GAUGE, 1);
+metric_t metric_buffer_allocs = SCALAR("esp32cam_frame_buffer_allocs_total", "Reservas de memoria para los buffers del anillo de frames", METRIC_COUNTER, 1);
+metric_t metric_buffer_bytes = SCALAR("esp32cam_frame_buffer_bytes", "Memoria de los buffers del anillo de frames", METRIC_GAUGE, 1);
+metric_t metric_uptime = SCALAR("esp32cam_uptime_seconds", "Tiempo desde el arranque", METRIC_GAUGE, US);
+
+// Las de la misma familia (mismo nombre, distintas etiquetas) van seguidas
+static metric_t * const registry[] = {
+    &metric_capture_us,
+    &metric_frame_bytes,
+    &metric_send_us,
+    &metric_preview_us,
+    &metric_motion_us,
+    &metric_snapshot_us,
+    &metric_display_age_us,
+    &metric_record_write_us,
+    &metric_control_http_us,
+    &metric_control_ws_us,
+    &metric_failsafe_reaction_us,
+    &metric_frames_captured,
+    &metric_frames_dropped,
+    &metric_frames_skipped,
+    &metric_frames_sent,
+    &metric_stream_bytes,
+    &metric_stream_viewers,
+    &metric_control_requests,
+    &metric_snapshot_reused,
+    &metric_display_dropped,
+    &metric_status_requests,
+    &metric_status_renders,
+    &metric_ws_commands,
+    &metric_events_clients,
+    &metric_motion_events,
+    &metric_record_frames,
+    &metric_record_dropped,
+    &metric_clip_bytes,
+    &metric_heap_free,
+    &metric_heap_min_free,
+    &metric_psram_free,
+    &metric_psram_largest,
+    &metric_buffer_allocs,
+    &metric_buffer_bytes,
+    &metric_uptime,
+};
+
+#define METRICS (sizeof(registry) / sizeof(registry[0]))
+
+void metric_add(metric_t * m, uint32_t n){
+    m->value += n;
+}
+
+void metric_set(metric_t * m, uint64_t v){
+    m->value = v;
+}
+
+void metric_observe(metric_t * m, uint32_t v){
+    int i = 0;
+    while(i < m->buckets && v > m->bounds[i]){
+        i++;
+    }
+    m->counts[i]++;
+    m->value += v;
+}
+
+int metrics_count(){
+    return METRICS;
+}
+
+static const char * type_name(metric_type_t type){
+    return type == METRIC_COUNTER ? "counter" : type == METRIC_GAUGE ? "gauge" : "histogram";
+}
+
+// Valor guardado en las unidades de Prometheus
+static int format_value(char * buf, size_t len, uint64_t v, uint32_t scale){
+    if(scale == 1){
+        return snprintf(buf, len, "%llu", (unsigned long long)v);
+    }
+    return snprintf(buf, len, "%.6f", (double)v / scale);
+}
+
+#define APPEND(...) do { \
+        int n = snprintf(buf + used, len - used, __VA_ARGS__); \
+        if(n < 0 || (size_t)n >= len - used) return 0; \
+        used += n; \
+    } while(0)
+
+size_t metrics_format(int index, char * buf, size_t len){
+    const metric_t * m = registry[index];
+    size_t used = 0;
+    char value[24];
+    if(!index || strcmp(registry[index - 1]->name, m->name)){
+        APPEND("# HELP %s %s\n# TYPE %s %s\n", m->name, m->help, m->name, type_name(m->type));
+    }
+
+    if(m->type != METRIC_HISTOGRAM){
+        format_value(value, sizeof(value), m->value, m->scale);
+        if(m->labels){
+            APPEND("%s{%s} %s\n", m->name, m->labels, value);
+        } else {
+            APPEND("%s %s\n", m->name, value);
+        }
+        return used;
+    }
+
+    // Se copian antes de escribir para que _count coincida con el cubo +Inf aunque siga llegando trafico
+    uint32_t counts[METRIC_MAX_BUCKETS + 1];
+    uint32_t count = 0;
+    for(int i = 0; i <= m->buckets && i <= METRIC_MAX_BUCKETS; i++){
+        counts[i] = m->counts[i];
+        count += counts[i];
+    }
+    uint64_t sum = m->value;
+    const char * sep = m->labels ? "," : "";
+    const char * labels = m->labels ? m->labels : "";
+    uint32_t acc = 0;
+    for(int i = 0; i < m->buckets; i++){
+        acc += counts[i];
+        snprintf(value, sizeof(value), "%g", (double)m->bounds[i] / m->scale);
+        APPEND("%s_bucket{%s%sle=\"%s\"} %u\n", m->name, labels, sep, value, acc);
+    }
+    APPEND("%s_bucket{%s%sle=\"+Inf\"} %u\n", m->name, labels, sep, count);
+    format_value(value, sizeof(value), sum, m->scale);
+    if(m->labels){
+        APPEND("%s_sum{%s} %s\n%s_count{%s} %u\n", m->name, labels, value, m->name, labels, count);
+    } else {
+        APPEND("%s_sum %s\n%s_count %u\n", m->name, value, m->name, count);
+    }
+    return used;
+}
@@ -0,0 +1,81 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Registro de metricas para /metrics en formato de texto de Prometheus.
+// Sin cerrojos: cada metrica la escribe una sola tarea (la que la mide, o /metrics al leer
+// los contadores de otros modulos), y quien lee solo puede ver un valor de 64 bits a medias
+// en el acarreo entre palabras, que en un scrape no importa.
+
+typedef enum {
+        METRIC_COUNTER,
+        METRIC_GAUGE,
+        METRIC_HISTOGRAM
+} metric_type_t;
+
+typedef struct {
+        const char * name;
+        const char * help;
+        const char * labels;        // p. ej. "transport=\"ws\"", NULL sin etiquetas
+        metric_type_t type;
+        uint32_t scale;             // el valor guardado se divide por esto al exponerlo (us -> s: 1000000)
+        const uint32_t * bounds;    // histograma: limite superior de cada cubo, en las unidades guardadas
+        uint8_t buckets;
+        uint32_t * counts;          // buckets + 1, el ultimo es +Inf
+        uint64_t value;             // contador o gauge; en un histograma, la suma
+} metric_t;
+
+#define METRIC_MAX_BUCKETS 15
+
+// Escriben solo desde la tarea duena de la metrica
+void metric_add(metric_t * m, uint32_t n);
+void metric_set(metric_t * m, uint64_t v);
+void metric_observe(metric_t * m, uint32_t v);
+
+// Cuantas metricas hay y el texto de la i-esima (con HELP/TYPE si empieza familia).
+// Devuelve la longitud escrita, o 0 si no cabe en len.
+int metrics_count();
+size_t metrics_format(int index, char * buf, size_t len);
+
+// Latencias, en microsegundos
+extern metric_t metric_capture_us;          // tarea de captura: pedir el frame al driver y copiarlo al anillo
+extern metric_t metric_frame_bytes;         // tarea de captura: tamano del JPEG
+extern metric_t metric_send_us;             // tarea de stream: de asignar el frame a un cliente al ultimo byte
+extern metric_t metric_motion_us;           // tarea de movimiento: decodificar a 1/8 y comparar con el fondo
+extern metric_t metric_preview_us;          // tarea de stream: decodificar, pasar a gris y codificar un frame de vista previa
+extern metric_t metric_snapshot_us;         // camera_httpd: /capture completo
+extern metric_t metric_control_http_us;     // camera_httpd: /control
+extern metric_t metric_control_ws_us;       // ws_control: un comando
+extern metric_t metric_control_requests;    // camera_httpd: peticiones a /control
+extern metric_t metric_record_write_us;     // grabador: un buffer de RECORD_BUFFER_SIZE a la tarjeta
+extern metric_t metric_display_age_us;      // camera_httpd: de la captura a la respuesta de /latency, con el frame pintado
+extern metric_t metric_display_dropped;     // camera_httpd: frames que las paginas no llegaron a pintar, segun /latency
+extern metric_t metric_snapshot_reused;     // camera_httpd: /capture servidos con un frame que ya estaba en el anillo
+extern metric_t metric_status_requests;     // camera_httpd: peticiones a /status
+extern metric_t metric_status_renders;      // camera_httpd: veces que /status ha tenido que regenerar el JSON
+extern metric_t metric_failsafe_reaction_us; // actuadores: del ultimo comando a los motores parados, cada vez que salta el failsafe
+
+// Los rellena /metrics justo antes de escribirlos
+extern metric_t metric_frames_captured;
+extern metric_t metric_frames_dropped;
+extern metric_t metric_frames_skipped;
+extern metric_t metric_frames_sent;
+extern metric_t metric_stream_bytes;
+extern metric_t metric_stream_viewers;
+extern metric_t metric_ws_commands;
+extern metric_t metric_events_clients;
+extern metric_t metric_motion_events;
+extern metric_t metric_record_frames;
+extern metric_t metric_record_dropped;
+extern metric_t metric_clip_bytes;
+extern metric_t metric_heap_free;
+extern metric_t metric_heap_min_free;
+extern metric_t metric_psram_free;
+extern metric_t metric_psram_largest;
+extern metric_t metric_buffer_allocs;
+extern metric_t metric_buffer_bytes;
+extern metric_t metric_uptime;
+
+#endif
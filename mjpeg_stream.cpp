@@ -0,0 +1,383 @@
+#include "mjpeg_stream.h"
+#include "camera_pipeline.h"
+#include "stream_abr.h"
+#include "stream_preview.h"
+#include "metrics.h"
+#include "device_state.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "Arduino.h"
+#include "freertos/semphr.h"
+#include "lwip/sockets.h"
+
+// Una sola captura para todos los que miran el video.
+// stream_handler manda las cabeceras y deja aqui el socket; esta tarea reparte cada frame
+// con envios no bloqueantes, cada cliente con su propio cursor y su referencia al frame.
+// Un cliente lento no retiene buffers: cuando acaba su frame coge el mas reciente y se salta el resto.
+
+static const char* _STREAM_BOUNDARY = "\r\n--" PART_BOUNDARY "\r\n";
+// X-Timestamp: esp_timer_get_time() al recibir el frame del sensor, en us. X-Frame-Seq: numero de frame de la captura,
+// los huecos son frames que este cliente no ha visto. La pagina devuelve el X-Timestamp a /latency.
+static const char* _STREAM_PART = "Content-Type: image/jpeg\r\nContent-Length: %u\r\nX-Timestamp: %lld\r\nX-Frame-Seq: %u\r\n\r\n";
+
+// Si un cliente no acepta ni un byte en este tiempo se le cierra
+#define STREAM_STALL_TIMEOUT_US 5000000
+
+typedef struct {
+        int fd;
+        frame_t * frame;
+        int preview_scale;      // 0 el JPEG del anillo, si no la vista previa en gris
+        preview_buf_t preview;  // del cliente, se reutiliza frame a frame
+        const uint8_t * body;   // lo que se envia de este frame: el JPEG del anillo o la vista previa
+        size_t body_len;
+        char head[128];
+        size_t head_len;
+        size_t sent;
+        uint32_t last_seq;
+        int64_t last_frame;
+        int64_t last_progress;
+        int64_t frame_start;
+        bool encoding;          // la tarea de envio esta codificando su vista previa fuera de clients_lock
+} stream_client_t;
+
+void perf_frame(size_t len, uint32_t frame_ms);   // en app_httpd.cpp
+
+static stream_client_t clients[MJPEG_MAX_CLIENTS];
+static SemaphoreHandle_t clients_lock = NULL;
+static TaskHandle_t stream_task_handle = NULL;
+static httpd_handle_t stream_server = NULL;
+static mjpeg_stream_stats_t stats = {0,};
+
+// Escalera de resoluciones del control de bitrate, sin las que no son 4:3 (QQVGA2 es vertical)
+static const framesize_t abr_sizes[] = {
+    FRAMESIZE_QQVGA, FRAMESIZE_QCIF, FRAMESIZE_HQVGA, FRAMESIZE_QVGA, FRAMESIZE_CIF,
+    FRAMESIZE_VGA, FRAMESIZE_SVGA, FRAMESIZE_XGA, FRAMESIZE_SXGA, FRAMESIZE_UXGA
+};
+#define ABR_SIZES (sizeof(abr_sizes) / sizeof(abr_sizes[0]))
+
+static stream_abr_t abr;
+static stream_abr_window_t abr_window = {0,};
+static int64_t abr_window_start = 0;
+static bool abr_enabled = true;
+// Lo que llega de /control, la tarea de envio lo recoge al cerrar la ventana
+static portMUX_TYPE abr_mux = portMUX_INITIALIZER_UNLOCKED;
+static int abr_pending_quality = -1;
+static int abr_pending_size = -1;
+static int abr_pending_enable = -1;
+
+static int abr_size_level(int framesize){
+    int level = 0;
+    for(int i = 0; i < (int)ABR_SIZES; i++){
+        if(abr_sizes[i] <= framesize){
+            level = i;
+        }
+    }
+    return level;
+}
+
+static void abr_apply(){
+    sensor_t * s = esp_camera_sensor_get();
+    if(s->status.quality != abr.quality){
+        s->set_quality(s, abr.quality);
+    }
+    if(s->pixformat == PIXFORMAT_JPEG && abr_size_level(s->status.framesize) != abr.size){
+        s->set_framesize(s, abr_sizes[abr.size]);
+    }
+    stats.abr_quality = abr.quality;
+    stats.abr_framesize = abr_sizes[abr.size];
+    state_set(STATE_QUALITY, s->status.quality);
+    state_set(STATE_FRAMESIZE, s->status.framesize);
+}
+
+// Una vez por ventana: recoge lo pedido por el usuario y decide con lo medido
+static void abr_tick(int64_t now){
+    if(now - abr_window_start < ABR_WINDOW_MS * 1000LL){
+        return;
+    }
+    portENTER_CRITICAL(&abr_mux);
+    int quality = abr_pending_quality;
+    int size = abr_pending_size;
+    int enable = abr_pending_enable;
+    abr_pending_quality = abr_pending_size = abr_pending_enable = -1;
+    portEXIT_CRITICAL(&abr_mux);
+
+    bool changed = false;
+    if(quality >= 0 || size >= 0 || enable >= 0){
+        if(enable >= 0){
+            abr_enabled = enable;
+        }
+        stream_abr_set_ceiling(&abr, quality >= 0 ? quality : abr.quality_best,
+                               size >= 0 ? abr_size_level(size) : abr.size_best);
+        changed = true;
+    } else if(abr_enabled){
+        changed = stream_abr_update(&abr, &abr_window);
+    }
+    if(changed){
+        stats.abr_changes++;
+        abr_apply();
+    }
+    abr_window.frames = 0;
+    abr_window.send_us = 0;
+    abr_window_start = now;
+}
+
+static void client_release(stream_client_t * c){
+    frame_release(c->frame);
+    c->frame = NULL;
+    // El frame que se esta codificando es de la tarea de envio, lo suelta ella al volver
+    c->encoding = false;
+    c->fd = -1;
+    stats.viewers--;
+    camera_pipeline_unsubscribe();
+}
+
+// 1 frame completo, 0 el socket no admite mas de momento, -1 error
+// Cabecera, JPEG y boundary salen en una sola escritura con tres iovec, sin copiar el JPEG
+static int client_send(stream_client_t * c){
+    const size_t boundary_len = strlen(_STREAM_BOUNDARY);
+    const size_t seg_len[3] = {c->head_len, c->body_len, boundary_len};
+    const uint8_t * seg[3] = {(const uint8_t *)c->head, c->body, (const uint8_t *)_STREAM_BOUNDARY};
+    const size_t total = seg_len[0] + seg_len[1] + seg_len[2];
+
+    while(c->sent < total){
+        struct iovec iov[3];
+        int iovcnt = 0;
+        size_t skip = c->sent;
+        for(int i = 0; i < 3; i++){
+            if(skip >= seg_len[i]){
+                skip -= seg_len[i];
+                continue;
+            }
+            iov[iovcnt].iov_base = (void *)(seg[i] + skip);
+            iov[iovcnt].iov_len = seg_len[i] - skip;
+            iovcnt++;
+            skip = 0;
+            if(MJPEG_SEND_PARTS){
+                break;
+            }
+        }
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovcnt;
+        int w = sendmsg(c->fd, &msg, MSG_DONTWAIT);
+        if(w < 0){
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        stats.writes++;
+        stats.wire_bytes += w;
+        c->sent += w;
+        c->last_progress = esp_timer_get_time();
+    }
+    return 1;
+}
+
+// Pone el frame en marcha para el cliente: cabecera y envio desde el principio
+static void client_start_frame(stream_client_t * c, frame_t * f, const uint8_t * body, size_t body_len){
+    c->frame = f;
+    c->body = body;
+    c->body_len = body_len;
+    c->sent = 0;
+    c->head_len = snprintf(c->head, sizeof(c->head), _STREAM_PART, body_len, (long long)f->timestamp, f->seq);
+}
+
+// Vista previa pendiente de un cliente: el frame lo retiene la tarea de envio mientras codifica
+typedef struct {
+        frame_t * frame;
+        int scale;
+} preview_job_t;
+
+// Las vistas previas se codifican sin clients_lock (decenas de ms): mientras, close_fn y add_client
+// no esperan. Si el cliente se va entretanto el frame se suelta y el resultado se tira.
+// false si no habia ninguna
+static bool stream_encode_previews(preview_job_t * jobs){
+    bool any = false;
+    bool ok[MJPEG_MAX_CLIENTS];
+    for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+        if(jobs[i].frame){
+            // Solo esta tarea toca preview, tambien si el hueco pasa a otro cliente
+            ok[i] = stream_preview_encode(jobs[i].frame, jobs[i].scale, &clients[i].preview);
+            any = true;
+        }
+    }
+    if(!any){
+        return false;
+    }
+
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+        stream_client_t * c = &clients[i];
+        if(!jobs[i].frame){
+            continue;
+        }
+        if(c->encoding && ok[i]){
+            metric_observe(&metric_preview_us, esp_timer_get_time() - c->frame_start);
+            client_start_frame(c, jobs[i].frame, c->preview.buf, c->preview.len);
+        } else {
+            frame_release(jobs[i].frame);
+        }
+        c->encoding = false;
+        jobs[i].frame = NULL;
+    }
+    xSemaphoreGive(clients_lock);
+    return true;
+}
+
+static void stream_task(void * arg){
+    uint32_t seen_seq = 0;
+    preview_job_t jobs[MJPEG_MAX_CLIENTS] = {{NULL, 0},};
+    while(true){
+        if(!stats.viewers){
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        bool busy = false;
+        xSemaphoreTake(clients_lock, portMAX_DELAY);
+        for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+            stream_client_t * c = &clients[i];
+            if(c->fd < 0){
+                continue;
+            }
+            if(!c->frame){
+                frame_t * f = frame_acquire_latest(c->last_seq, 0);
+                if(f){
+                    if(c->last_seq && f->seq > c->last_seq + 1){
+                        stats.skipped += f->seq - c->last_seq - 1;
+                    }
+                    c->last_seq = f->seq;
+                    c->last_progress = c->frame_start = esp_timer_get_time();
+                    seen_seq = f->seq;
+                    if(c->preview_scale){
+                        // Se codifica despues de soltar el cerrojo; el frame sigue retenido hasta acabar el envio
+                        c->encoding = true;
+                        jobs[i].frame = f;
+                        jobs[i].scale = c->preview_scale;
+                        continue;
+                    }
+                    client_start_frame(c, f, f->buf, f->len);
+                }
+            }
+            if(!c->frame){
+                continue;
+            }
+            int r = client_send(c);
+            if(r < 0 || esp_timer_get_time() - c->last_progress > STREAM_STALL_TIMEOUT_US){
+                int fd = c->fd;
+                client_release(c);
+                httpd_trigger_sess_close(stream_server, fd);
+                continue;
+            }
+            if(r == 0){
+                busy = true;
+                continue;
+            }
+            int64_t fr_end = esp_timer_get_time();
+            perf_frame(c->body_len, (uint32_t)((fr_end - c->last_frame) / 1000));
+            stats.frames++;
+            // La vista previa no dice nada del enlace del stream completo, no entra en el control de bitrate
+            if(!c->preview_scale){
+                abr_window.frames++;
+                abr_window.send_us += fr_end - c->frame_start;
+            }
+            metric_observe(&metric_send_us, fr_end - c->frame_start);
+            c->last_frame = fr_end;
+            frame_release(c->frame);
+            c->frame = NULL;
+        }
+        xSemaphoreGive(clients_lock);
+        abr_tick(esp_timer_get_time());
+
+        if(stream_encode_previews(jobs)){
+            // Lo recien codificado sale en la siguiente vuelta, sin esperar a otro frame
+            continue;
+        }
+        if(busy){
+            // Algun socket esta lleno, se vuelve a probar en cuanto haya hueco
+            vTaskDelay(1);
+        } else {
+            frame_t * f = frame_acquire_latest(seen_seq, 100);
+            frame_release(f);
+        }
+    }
+}
+
+void mjpeg_stream_start(httpd_handle_t server){
+    if(stream_task_handle){
+        return;
+    }
+    stream_server = server;
+    for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+        clients[i].fd = -1;
+        clients[i].frame = NULL;
+        clients[i].encoding = false;
+        clients[i].preview.buf = NULL;
+        clients[i].preview.capacity = 0;
+    }
+    clients_lock = xSemaphoreCreateMutex();
+    // Lo que se fijo en setup() es el techo de partida
+    sensor_t * s = esp_camera_sensor_get();
+    stream_abr_init(&abr, s->status.quality, abr_size_level(s->status.framesize), 0);
+    stats.abr_quality = abr.quality;
+    stats.abr_framesize = abr_sizes[abr.size];
+    task_plan_create(TASK_STREAM, stream_task, NULL, &stream_task_handle);
+}
+
+bool mjpeg_stream_add_client(int fd, int preview_scale){
+    bool added = false;
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+        stream_client_t * c = &clients[i];
+        if(c->fd >= 0){
+            continue;
+        }
+        c->fd = fd;
+        c->frame = NULL;
+        c->encoding = false;
+        c->preview_scale = preview_scale;
+        c->last_seq = 0;
+        c->last_frame = c->last_progress = esp_timer_get_time();
+        stats.viewers++;
+        camera_pipeline_subscribe();
+        added = true;
+        break;
+    }
+    xSemaphoreGive(clients_lock);
+    if(added){
+        xTaskNotifyGive(stream_task_handle);
+    }
+    return added;
+}
+
+void mjpeg_stream_close_fn(httpd_handle_t hd, int fd){
+    xSemaphoreTake(clients_lock, portMAX_DELAY);
+    for(int i = 0; i < MJPEG_MAX_CLIENTS; i++){
+        if(clients[i].fd == fd){
+            client_release(&clients[i]);
+        }
+    }
+    xSemaphoreGive(clients_lock);
+    // El socket lo cierra el servidor al volver (httpd_sess_delete de IDF 3.x), aqui no
+}
+
+void mjpeg_stream_stats(mjpeg_stream_stats_t * out){
+    *out = stats;
+}
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){
+    portENTER_CRITICAL(&abr_mux);
+    if(quality >= 0){
+        abr_pending_quality = quality;
+    }
+    if(framesize >= 0){
+        abr_pending_size = framesize;
+    }
+    portEXIT_CRITICAL(&abr_mux);
+}
+
+void mjpeg_stream_abr_enable(bool enable){
+    portENTER_CRITICAL(&abr_mux);
+    abr_pending_enable = enable;
+    portEXIT_CRITICAL(&abr_mux);
+}
@@ -0,0 +1,44 @@
+#ifndef MJPEG_STREAM_H
+#define MJPEG_STREAM_H
+
+#include "esp_http_server.h"
+
+// Con el limite de sockets de lwip (10) y los dos servidores, no caben muchos mas
+#define MJPEG_MAX_CLIENTS 4
+
+#define PART_BOUNDARY "123456789000000000000987654321"
+
+// Solo para comparar en bench_stream_parts: 1 manda cabecera, JPEG y boundary con un envio cada uno
+// en lugar de los tres juntos en un sendmsg
+#ifndef MJPEG_SEND_PARTS
+#define MJPEG_SEND_PARTS 0
+#endif
+
+void mjpeg_stream_start(httpd_handle_t server);
+
+// El socket pasa a la tarea de envio, stream_handler ya ha mandado las cabeceras HTTP.
+// preview_scale 0 es el JPEG del sensor tal cual; 1, 2, 4 u 8 la vista previa en gris (stream_preview.h).
+bool mjpeg_stream_add_client(int fd, int preview_scale);
+
+// close_fn del servidor de stream: solo suelta el cliente, el socket lo cierra el servidor
+void mjpeg_stream_close_fn(httpd_handle_t hd, int fd);
+
+typedef struct {
+        uint32_t viewers;
+        uint32_t skipped;       // frames que un cliente lento no llego a ver
+        uint32_t frames;        // frames enviados completos, sumando todos los clientes
+        uint32_t writes;        // llamadas a sendmsg
+        uint64_t wire_bytes;
+        int abr_quality;        // lo que ha dejado el control de bitrate
+        int abr_framesize;
+        uint32_t abr_changes;
+} mjpeg_stream_stats_t;
+
+void mjpeg_stream_stats(mjpeg_stream_stats_t * out);
+
+// Control de bitrate (stream_abr.h): lo que pide el usuario desde /control es el techo, -1 deja el valor como esta
+void mjpeg_stream_abr_ceiling(int quality, int framesize);
+// Apagado se queda en el techo
+void mjpeg_stream_abr_enable(bool enable);
+
+#endif
@@ -0,0 +1,79 @@
+#include "motion_detect.h"
+
+void motion_detect_init(motion_detector_t * m, uint16_t * bg, size_t capacity, int threshold){
+    m->bg = bg;
+    m->capacity = capacity;
+    m->threshold = threshold;
+    motion_detect_reset(m);
+}
+
+void motion_detect_reset(motion_detector_t * m){
+    m->width = 0;
+    m->height = 0;
+    m->primed = false;
+}
+
+// Suma de |y - fondo| de una fila de un bloque; longitud fija y sin ramas para que se vectorice
+static uint32_t row_sad(const uint8_t * y, const uint16_t * bg){
+    uint32_t sad = 0;
+    for(int i = 0; i < MOTION_BLOCK; i++){
+        int d = y[i] - (bg[i] >> 8);
+        sad += d < 0 ? -d : d;
+    }
+    return sad;
+}
+
+static void bg_update(const uint8_t * y, uint16_t * bg, size_t n){
+    for(size_t i = 0; i < n; i++){
+        int32_t b = bg[i];
+        bg[i] = b + (((int32_t)y[i] * 256 - b) >> MOTION_BG_SHIFT);
+    }
+}
+
+int motion_detect(motion_detector_t * m, const uint8_t * y, int width, int height, motion_box_t * box){
+    size_t n = (size_t)width * height;
+    if(n > m->capacity){
+        return -1;
+    }
+    if(!m->primed || width != m->width || height != m->height){
+        for(size_t i = 0; i < n; i++){
+            m->bg[i] = y[i] << 8;
+        }
+        m->width = width;
+        m->height = height;
+        m->primed = true;
+        return 0;
+    }
+
+    // Los pixeles que no llenan un bloque al borde derecho o inferior no se miran
+    int bw = width / MOTION_BLOCK;
+    int bh = height / MOTION_BLOCK;
+    uint32_t limit = (uint32_t)m->threshold * MOTION_BLOCK * MOTION_BLOCK;
+    int active = 0;
+    int x0 = bw, y0 = bh, x1 = -1, y1 = -1;
+    for(int by = 0; by < bh; by++){
+        for(int bx = 0; bx < bw; bx++){
+            uint32_t sad = 0;
+            size_t base = (size_t)by * MOTION_BLOCK * width + bx * MOTION_BLOCK;
+            for(int r = 0; r < MOTION_BLOCK; r++){
+                sad += row_sad(y + base + r * width, m->bg + base + r * width);
+            }
+            if(sad > limit){
+                active++;
+                x0 = bx < x0 ? bx : x0;
+                y0 = by < y0 ? by : y0;
+                x1 = bx > x1 ? bx : x1;
+                y1 = by > y1 ? by : y1;
+            }
+        }
+    }
+    bg_update(y, m->bg, n);
+
+    if(active){
+        box->x = x0;
+        box->y = y0;
+        box->w = x1 - x0 + 1;
+        box->h = y1 - y0 + 1;
+    }
+    return active;
+}
@@ -0,0 +1,41 @@
+#ifndef MOTION_DETECT_H
+#define MOTION_DETECT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Deteccion de movimiento sobre una imagen de luminancia pequena (el frame a 1/8).
+// Fondo como media movil en Q8 por pixel; la imagen se parte en bloques y un bloque
+// esta activo si la diferencia media con el fondo pasa del umbral. Todo con enteros.
+// No depende de nada del ESP32, se puede medir en el PC con clips grabados.
+
+#define MOTION_BLOCK 4              // lado del bloque, en pixeles de la imagen analizada
+#define MOTION_THRESHOLD 12         // diferencia media por pixel (0..255) para que un bloque cuente
+#define MOTION_MIN_BLOCKS 2         // bloques activos para que haya movimiento
+#define MOTION_BG_SHIFT 4           // el fondo se acerca 1/16 a cada imagen
+
+typedef struct {
+        int x;                      // en bloques
+        int y;
+        int w;
+        int h;
+} motion_box_t;
+
+typedef struct {
+        uint16_t * bg;              // Q8, lo reserva quien lo usa
+        size_t capacity;            // pixeles que caben en bg
+        int width;
+        int height;
+        bool primed;                // con un tamano nuevo la primera imagen solo siembra el fondo
+        int threshold;
+} motion_detector_t;
+
+void motion_detect_init(motion_detector_t * m, uint16_t * bg, size_t capacity, int threshold);
+// Vuelve a sembrar el fondo con la siguiente imagen
+void motion_detect_reset(motion_detector_t * m);
+
+// Compara y actualiza el fondo. Devuelve los bloques activos y en box el rectangulo que los contiene.
+// -1 si la imagen no cabe en bg.
+int motion_detect(motion_detector_t * m, const uint8_t * y, int width, int height, motion_box_t * box);
+
+#endif
@@ -0,0 +1,137 @@
+#include "motion_stage.h"
+#include "motion_detect.h"
+#include "stream_preview.h"
+#include "device_state.h"
+#include "metrics.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "Arduino.h"
+#include "freertos/queue.h"
+
+static QueueHandle_t motion_queue = NULL;
+static TaskHandle_t motion_task_handle = NULL;
+static volatile bool enabled = false;
+static volatile bool reset_pending = false;
+static volatile int threshold = MOTION_THRESHOLD;
+static int64_t last_offer = 0;
+static uint32_t analyzed = 0;
+static uint32_t events = 0;
+
+// Solo la tarea de movimiento
+static uint16_t * background = NULL;
+static uint8_t * luma = NULL;
+static size_t luma_capacity = 0;
+static motion_detector_t detector;
+
+static void motion_report(bool active, const motion_box_t * box){
+    state_set(STATE_MOTION, active);
+    if(box){
+        // De bloques de la imagen analizada a pixeles del sensor
+        const int px = MOTION_BLOCK * MOTION_SCALE;
+        state_set(STATE_MOTION_X, box->x * px);
+        state_set(STATE_MOTION_Y, box->y * px);
+        state_set(STATE_MOTION_W, box->w * px);
+        state_set(STATE_MOTION_H, box->h * px);
+    }
+}
+
+static void motion_task(void * arg){
+    bool active = false;
+    int quiet = 0;
+    motion_detect_init(&detector, background, MOTION_MAX_PIXELS, threshold);
+
+    while(true){
+        // Se mira sin sacarlo: con la cola llena motion_stage_offer suelta los frames que lleguen
+        // hasta que este analisis acaba y lo saca. Un flag aparte dejaba una ventana con dos retenidos.
+        frame_t * f = NULL;
+        xQueuePeek(motion_queue, &f, portMAX_DELAY);
+        int64_t start = esp_timer_get_time();
+        int width = 0, height = 0;
+        bool decoded = enabled && stream_preview_decode(f, MOTION_SCALE, &luma, &luma_capacity, &width, &height);
+        frame_release(f);
+        if(!decoded){
+            xQueueReceive(motion_queue, &f, 0);
+            continue;
+        }
+
+        if(reset_pending){
+            reset_pending = false;
+            motion_detect_reset(&detector);
+            active = false;
+            quiet = 0;
+        }
+        detector.threshold = threshold;
+        motion_box_t box;
+        int blocks = motion_detect(&detector, luma, width, height, &box);
+        if(blocks >= MOTION_MIN_BLOCKS){
+            quiet = 0;
+            if(!active){
+                active = true;
+                events++;
+                state_set(STATE_MOTION_EVENTS, events);
+            }
+            motion_report(true, &box);
+        } else if(active && ++quiet >= MOTION_HOLD){
+            active = false;
+            motion_report(false, NULL);
+        }
+        analyzed++;
+        metric_observe(&metric_motion_us, esp_timer_get_time() - start);
+        xQueueReceive(motion_queue, &f, 0);
+    }
+}
+
+void motion_stage_start(){
+    if(motion_task_handle){
+        return;
+    }
+    background = (uint16_t *)heap_caps_malloc(MOTION_MAX_PIXELS * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if(!background){
+        return;
+    }
+    motion_queue = xQueueCreate(1, sizeof(frame_t *));
+    // Por debajo de la captura y del envio: si no da tiempo se analizan menos frames, el video no se entera
+    task_plan_create(TASK_MOTION, motion_task, NULL, &motion_task_handle);
+}
+
+bool motion_stage_enable(bool enable){
+    if(!motion_task_handle){
+        return !enable;
+    }
+    if(enable == enabled){
+        return true;
+    }
+    if(enable){
+        reset_pending = true;
+        enabled = true;
+        camera_pipeline_subscribe();
+    } else {
+        enabled = false;
+        camera_pipeline_unsubscribe();
+    }
+    state_set(STATE_MOTION, 0);
+    return true;
+}
+
+void motion_stage_set_threshold(int value){
+    threshold = value;
+}
+
+bool motion_stage_due(int64_t timestamp){
+    return enabled && timestamp - last_offer >= MOTION_PERIOD_MS * 1000LL;
+}
+
+void motion_stage_offer(frame_t * f){
+    // Como mucho una referencia en manos del analisis, para no quitarle huecos del anillo al stream
+    if(!f || xQueueSend(motion_queue, &f, 0) != pdTRUE){
+        frame_release(f);
+        return;
+    }
+    last_offer = f->timestamp;
+}
+
+void motion_stage_stats(uint32_t * analyzed_out, uint32_t * events_out){
+    *analyzed_out = analyzed;
+    *events_out = events;
+}
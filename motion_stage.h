@@ -0,0 +1,30 @@
+#ifndef MOTION_STAGE_H
+#define MOTION_STAGE_H
+
+#include "camera_pipeline.h"
+
+// Modo centinela: la tarea de captura pasa un frame de vez en cuando a una tarea de baja prioridad
+// que lo decodifica a 1/8 en gris y busca movimiento (motion_detect.h). Los eventos y el rectangulo
+// salen en /status y /events (device_state.h). Apagado no cuesta nada: ni se decodifica ni se despierta.
+
+#define MOTION_PERIOD_MS 200            // un analisis cada tanto, no cada frame
+#define MOTION_SCALE 8                  // QVGA se analiza en 40x30, UXGA en 200x150
+#define MOTION_MAX_PIXELS (200 * 150)
+#define MOTION_HOLD 5                   // analisis seguidos sin movimiento para dar el evento por acabado
+
+void motion_stage_start();
+
+// /control?var=motion&val=1. Encendido mantiene la captura en marcha aunque nadie mire el stream.
+// false si se pide encender y no hay tarea (sin PSRAM para el fondo)
+bool motion_stage_enable(bool enable);
+void motion_stage_set_threshold(int threshold);
+
+// Desde la tarea de captura: true si toca analizar un frame recibido en timestamp
+bool motion_stage_due(int64_t timestamp);
+// Desde la tarea de captura: se queda la referencia, o la suelta si el analisis anterior no ha acabado.
+// El frame ocupa la cola hasta el final de su analisis, asi nunca hay mas de uno retenido.
+void motion_stage_offer(frame_t * f);
+
+void motion_stage_stats(uint32_t * analyzed, uint32_t * events);
+
+#endif
@@ -0,0 +1,363 @@
+#include "recorder.h"
+#include "avi.h"
+#include "device_state.h"
+#include "metrics.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "Arduino.h"
+#include "freertos/queue.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#if RECORDER_SD
+#include "esp_vfs_fat.h"
+#include "driver/sdmmc_host.h"
+#include "sdmmc_cmd.h"
+#endif
+
+typedef struct {
+        uint8_t * data;             // RECORD_BUFFER_SIZE en RAM interna: el DMA del SDMMC no llega a la PSRAM
+        uint8_t * index;            // RECORD_MAX_ENTRIES entradas de idx1 de los frames que acaban aqui
+        size_t len;
+        int entries;
+        volatile bool busy;         // entregado al grabador; lo suelta vacio
+} record_buf_t;
+
+typedef struct {
+        int buf;
+        bool final;
+} record_msg_t;
+
+static QueueHandle_t write_queue = NULL;
+static TaskHandle_t recorder_task_handle = NULL;
+static record_buf_t bufs[2];
+static volatile record_state_t state = RECORD_IDLE;
+static volatile record_error_t last_error = RECORD_OK;
+static bool mounted = false;
+static char name[16] = "";
+static int fd = -1;
+static int idx_fd = -1;
+
+// Solo la tarea de captura mientras graba; el grabador los lee despues del ultimo buffer
+static int active = 0;
+static uint32_t movi_bytes = 0;
+static uint32_t max_chunk = 0;
+static uint32_t width = 0;
+static uint32_t height = 0;
+static int64_t first_ts = 0;
+static int64_t last_ts = 0;
+static volatile uint32_t frames = 0;
+static volatile uint32_t dropped = 0;
+static volatile uint32_t total_frames = 0;
+static volatile uint32_t total_dropped = 0;
+
+// Solo el grabador
+static volatile uint32_t written = 0;
+static volatile int64_t write_us = 0;
+static int64_t started = 0;
+static int64_t ended = 0;
+
+static void record_free_buffers(){
+    for(int i = 0; i < 2; i++){
+        heap_caps_free(bufs[i].data);
+        heap_caps_free(bufs[i].index);
+        bufs[i].data = bufs[i].index = NULL;
+    }
+}
+
+static void record_handoff(bool final){
+    record_msg_t msg = {active, final};
+    bufs[active].busy = true;
+    xQueueSend(write_queue, &msg, 0);
+    active ^= 1;
+}
+
+// Copia al buffer activo y entrega cada uno que se llena; quien llama ya ha visto que cabe
+static void record_put(const uint8_t * data, size_t n){
+    while(n){
+        record_buf_t * b = &bufs[active];
+        size_t k = RECORD_BUFFER_SIZE - b->len < n ? RECORD_BUFFER_SIZE - b->len : n;
+        memcpy(b->data + b->len, data, k);
+        b->len += k;
+        data += k;
+        n -= k;
+        if(b->len == RECORD_BUFFER_SIZE){
+            record_handoff(false);
+        }
+    }
+}
+
+void recorder_tee(const frame_t * f){
+    if(state == RECORD_STOPPING){
+        // El grabador cierra el archivo detras del ultimo buffer y deja RECORD_IDLE: el estado se
+        // cambia antes de entregarlo para no pisar el suyo
+        state = RECORD_FINISHING;
+        record_handoff(true);
+        return;
+    }
+    if(state != RECORD_RUNNING){
+        return;
+    }
+
+    size_t need = avi_chunk_size(f->len);
+    if(movi_bytes + need > RECORD_MAX_BYTES){
+        state = RECORD_STOPPING;
+        return;
+    }
+    // Los datos van seguidos: solo se puede seguir en el otro buffer si el activo no esta en la tarjeta
+    record_buf_t * a = &bufs[active];
+    // Mas grande que lo que queda en el activo mas el otro no cabria nunca, y con frames grandes el
+    // activo no se llena: se entrega a medias y el frame empieza en el otro, vacio
+    if(!a->busy && a->len && !bufs[active ^ 1].busy && need > 2 * RECORD_BUFFER_SIZE - a->len){
+        record_handoff(false);
+        a = &bufs[active];
+    }
+    size_t room = 0;
+    if(!a->busy){
+        room = RECORD_BUFFER_SIZE - a->len + (bufs[active ^ 1].busy ? 0 : RECORD_BUFFER_SIZE);
+    }
+    // La entrada de idx1 va con el buffer donde acaba el frame: asi llega al .idx despues de su ultimo byte
+    record_buf_t * e = need <= RECORD_BUFFER_SIZE - a->len ? a : &bufs[active ^ 1];
+    if(need > room || e->entries >= RECORD_MAX_ENTRIES){
+        dropped++;
+        total_dropped++;
+        return;
+    }
+
+    if(!frames){
+        width = f->width;
+        height = f->height;
+        first_ts = f->timestamp;
+    }
+    uint8_t head[AVI_CHUNK_HEADER];
+    avi_index_entry(e->index + e->entries * AVI_INDEX_ENTRY, AVI_HEADER_SIZE + movi_bytes, f->len);
+    e->entries++;
+    avi_chunk_header(head, f->len);
+    record_put(head, sizeof(head));
+    record_put(f->buf, f->len);
+    if(f->len & 1){
+        uint8_t pad = 0;
+        record_put(&pad, 1);
+    }
+    movi_bytes += need;
+    max_chunk = need > max_chunk ? need : max_chunk;
+    last_ts = f->timestamp;
+    frames++;
+    total_frames++;
+    // Si el siguiente es como el mas grande hasta ahora ya no va a caber: el activo se entrega ahora, y
+    // cuando llegue el frame los dos buffers han tenido un periodo entero para llegar a la tarjeta
+    a = &bufs[active];
+    if(!a->busy && a->len && max_chunk > 2 * RECORD_BUFFER_SIZE - a->len){
+        record_handoff(false);
+    }
+}
+
+static bool write_all(int file, const uint8_t * data, size_t len){
+    return !len || write(file, data, len) == (ssize_t)len;
+}
+
+// Detras del ultimo buffer: idx1 con lo que hay en el .idx y la cabecera con los totales
+static void record_finish(){
+    bool ok = last_error == RECORD_OK;
+    uint32_t entries = 0;
+    if(ok){
+        struct stat st;
+        entries = fstat(idx_fd, &st) == 0 ? st.st_size / AVI_INDEX_ENTRY : 0;
+        uint8_t head[8];
+        avi_index_header(head, entries);
+        ok = write_all(fd, head, sizeof(head)) && lseek(idx_fd, 0, SEEK_SET) == 0;
+        // Los dos buffers estan libres: el primero hace de intermedio
+        uint32_t left = entries * AVI_INDEX_ENTRY;
+        while(ok && left){
+            size_t n = left < RECORD_BUFFER_SIZE ? left : RECORD_BUFFER_SIZE;
+            ok = read(idx_fd, bufs[0].data, n) == (ssize_t)n && write_all(fd, bufs[0].data, n);
+            left -= n;
+        }
+    }
+    avi_info_t info;
+    info.width = width;
+    info.height = height;
+    info.frames = frames;
+    info.usec_per_frame = frames > 1 ? (last_ts - first_ts) / (frames - 1) : 0;
+    info.movi_bytes = movi_bytes;
+    info.max_chunk = max_chunk;
+    info.indexed = ok && entries == frames;
+    avi_header(bufs[0].data, &info);
+    if(lseek(fd, 0, SEEK_SET) != 0 || !write_all(fd, bufs[0].data, AVI_HEADER_SIZE)){
+        last_error = RECORD_ERR_WRITE;
+    }
+    close(fd);
+    close(idx_fd);
+    fd = idx_fd = -1;
+    // Sin idx1 completo el .idx se queda para reconstruirlo
+    if(info.indexed){
+        char path[48];
+        snprintf(path, sizeof(path), RECORD_DIR "/%.*s.idx", (int)strlen(name) - 4, name);
+        unlink(path);
+    }
+
+    record_free_buffers();
+    camera_pipeline_unsubscribe();
+    ended = esp_timer_get_time();
+    state = RECORD_IDLE;
+    state_set(STATE_RECORDING, 0);
+}
+
+static void recorder_task(void * arg){
+    int64_t last_sync = 0;
+    while(true){
+        record_msg_t msg;
+        xQueueReceive(write_queue, &msg, portMAX_DELAY);
+        record_buf_t * b = &bufs[msg.buf];
+        if(last_error == RECORD_OK){
+            int64_t t0 = esp_timer_get_time();
+            // Datos antes que su indice: el .idx nunca va por delante del AVI
+            if(!write_all(fd, b->data, b->len) || !write_all(idx_fd, b->index, b->entries * AVI_INDEX_ENTRY)){
+                last_error = RECORD_ERR_WRITE;
+                if(state == RECORD_RUNNING){
+                    state = RECORD_STOPPING;
+                }
+            }
+            int64_t now = esp_timer_get_time();
+            if(now - last_sync >= RECORD_SYNC_MS * 1000LL){
+                fsync(fd);
+                fsync(idx_fd);
+                last_sync = esp_timer_get_time();
+            }
+            written += b->len;
+            write_us += now - t0;
+            metric_observe(&metric_record_write_us, now - t0);
+        }
+        b->len = 0;
+        b->entries = 0;
+        b->busy = false;
+        if(msg.final){
+            record_finish();
+        }
+    }
+}
+
+void recorder_start(){
+    if(recorder_task_handle){
+        return;
+    }
+    // Como mucho los dos buffers y el final
+    write_queue = xQueueCreate(3, sizeof(record_msg_t));
+    task_plan_create(TASK_RECORDER, recorder_task, NULL, &recorder_task_handle);
+}
+
+bool recorder_mount(){
+#if RECORDER_SD
+    if(mounted){
+        return true;
+    }
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.flags = SDMMC_HOST_FLAG_1BIT;
+    sdmmc_slot_config_t slot = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot.width = 1;
+    esp_vfs_fat_sdmmc_mount_config_t config = {};
+    config.format_if_mount_failed = false;
+    config.max_files = 4;
+    sdmmc_card_t * card;
+    if(esp_vfs_fat_sdmmc_mount(RECORD_MOUNT, &host, &slot, &config, &card) != ESP_OK){
+        return false;
+    }
+    mkdir(RECORD_DIR, 0777);
+    mounted = true;
+#endif
+    return mounted;
+}
+
+// clipNNNN.avi con el siguiente numero a los que ya hay
+static void record_next_name(){
+    unsigned last = 0;
+    DIR * dir = opendir(RECORD_DIR);
+    if(dir){
+        struct dirent * e;
+        while((e = readdir(dir))){
+            unsigned n;
+            if(sscanf(e->d_name, "clip%u.avi", &n) == 1 && n > last){
+                last = n;
+            }
+        }
+        closedir(dir);
+    }
+    snprintf(name, sizeof(name), "clip%04u.avi", last + 1);
+}
+
+record_error_t recorder_begin(){
+    if(!RECORDER_SD){
+        return RECORD_ERR_DISABLED;
+    }
+    if(!recorder_task_handle || state != RECORD_IDLE){
+        return RECORD_ERR_BUSY;
+    }
+    if(!recorder_mount()){
+        return last_error = RECORD_ERR_NO_CARD;
+    }
+    for(int i = 0; i < 2; i++){
+        bufs[i].data = (uint8_t *)heap_caps_malloc(RECORD_BUFFER_SIZE, MALLOC_CAP_DMA);
+        bufs[i].index = (uint8_t *)heap_caps_malloc(RECORD_MAX_ENTRIES * AVI_INDEX_ENTRY, MALLOC_CAP_8BIT);
+        bufs[i].len = 0;
+        bufs[i].entries = 0;
+        bufs[i].busy = false;
+    }
+    if(!bufs[0].data || !bufs[1].data || !bufs[0].index || !bufs[1].index){
+        record_free_buffers();
+        return last_error = RECORD_ERR_NO_MEMORY;
+    }
+
+    char path[48];
+    record_next_name();
+    snprintf(path, sizeof(path), RECORD_DIR "/%s", name);
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    snprintf(path, sizeof(path), RECORD_DIR "/%.*s.idx", (int)strlen(name) - 4, name);
+    idx_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || idx_fd < 0){
+        if(fd >= 0) close(fd);
+        if(idx_fd >= 0) close(idx_fd);
+        fd = idx_fd = -1;
+        record_free_buffers();
+        return last_error = RECORD_ERR_FILE;
+    }
+
+    // Cabecera provisional, sin totales: al parar se reescribe
+    avi_info_t info = {0, 0, 0, 0, 0, 0, false};
+    avi_header(bufs[0].data, &info);
+    bufs[0].len = AVI_HEADER_SIZE;
+    active = 0;
+    movi_bytes = 0;
+    max_chunk = 0;
+    frames = 0;
+    dropped = 0;
+    written = 0;
+    write_us = 0;
+    started = esp_timer_get_time();
+    last_error = RECORD_OK;
+    state = RECORD_RUNNING;
+    state_set(STATE_RECORDING, 1);
+    camera_pipeline_subscribe();
+    return RECORD_OK;
+}
+
+void recorder_end(){
+    if(state == RECORD_RUNNING){
+        state = RECORD_STOPPING;
+    }
+}
+
+void recorder_status(record_status_t * out){
+    out->state = state;
+    strncpy(out->name, name, sizeof(out->name));
+    out->frames = frames;
+    out->dropped = dropped;
+    out->bytes = written;
+    // Parado, lo que duro la ultima
+    out->seconds = started ? ((state == RECORD_IDLE ? ended : esp_timer_get_time()) - started) / 1000000 : 0;
+    out->write_kbps = write_us ? (uint64_t)written * 1000 / 1024 * 1000 / write_us : 0;
+    out->error = last_error;
+    out->total_frames = total_frames;
+    out->total_dropped = total_dropped;
+}
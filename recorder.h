@@ -0,0 +1,76 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include "camera_pipeline.h"
+
+// Grabacion en la tarjeta SD: los JPEG que ya salen de la captura se copian tal cual a un AVI (avi.h)
+// que solo crece. La copia la hace la tarea de captura en uno de dos buffers; cuando se llena pasa
+// entero a la tarea del grabador, que lo escribe de una vez mientras se llena el otro. Si el otro
+// aun no se ha escrito el frame no se graba y se cuenta: la captura y el stream no esperan a la tarjeta.
+// Cada buffer lleva el indice de los frames que acaban en el, y va a un .idx aparte despues de sus datos;
+// se sincroniza cada RECORD_SYNC_MS, asi que tras un corte de luz el .idx nunca apunta a frames que no
+// estan. Al parar se pega como idx1.
+
+// En la AI-Thinker la ranura SD en modo 1 bit usa GPIO 14 (CLK), 15 (CMD) y 2 (D0): los mismos que
+// los motores y el servo de GPIO 2 de este montaje. Solo con esos movidos a otros pines.
+#ifndef RECORDER_SD
+#define RECORDER_SD 0
+#endif
+
+// Las pruebas del PC montan la "tarjeta" en una carpeta suya
+#ifndef RECORD_MOUNT
+#define RECORD_MOUNT "/sdcard"
+#endif
+#ifndef RECORD_DIR
+#define RECORD_DIR RECORD_MOUNT "/clips"
+#endif
+#define RECORD_BUFFER_SIZE 32768        // 64 sectores: escrituras grandes y alineadas en el archivo
+#define RECORD_MAX_ENTRIES 64           // frames que pueden acabar en un buffer (de 512 bytes de media)
+#define RECORD_SYNC_MS 2000
+#define RECORD_MAX_BYTES (1000UL * 1024 * 1024)    // un AVI de los de antes no pasa de 1 GB; se para ahi
+
+typedef enum {
+        RECORD_IDLE,
+        RECORD_RUNNING,
+        RECORD_STOPPING,            // pedido parar, la captura aun no ha entregado el ultimo buffer
+        RECORD_FINISHING            // el grabador escribe idx1 y la cabecera final
+} record_state_t;
+
+typedef enum {
+        RECORD_OK,
+        RECORD_ERR_DISABLED,        // compilado sin RECORDER_SD
+        RECORD_ERR_NO_CARD,
+        RECORD_ERR_BUSY,
+        RECORD_ERR_NO_MEMORY,
+        RECORD_ERR_FILE,
+        RECORD_ERR_WRITE            // la tarjeta fallo o se lleno a mitad; el archivo se cierra igual
+} record_error_t;
+
+typedef struct {
+        record_state_t state;
+        char name[16];              // ultimo archivo, dentro de RECORD_DIR
+        uint32_t frames;            // copiados a los buffers
+        uint32_t dropped;           // llegaron sin sitio en los buffers
+        uint32_t bytes;             // escritos en la tarjeta
+        uint32_t seconds;
+        uint32_t write_kbps;        // de la tarjeta, contando solo el tiempo dentro de write()
+        record_error_t error;
+        uint32_t total_frames;      // desde el arranque, todas las grabaciones
+        uint32_t total_dropped;
+} record_status_t;
+
+void recorder_start();
+
+// Monta la tarjeta la primera vez; false sin tarjeta o sin RECORDER_SD
+bool recorder_mount();
+
+// /recording?action=start y stop. Empezar mantiene la captura en marcha aunque nadie mire.
+record_error_t recorder_begin();
+void recorder_end();
+
+// Desde la tarea de captura, con el frame recien publicado
+void recorder_tee(const frame_t * f);
+
+void recorder_status(record_status_t * out);
+
+#endif
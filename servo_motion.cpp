@@ -0,0 +1,102 @@
+#include "servo_motion.h"
+#include "actuators.h"
+#include "Arduino.h"
+
+// Perfil trapezoidal en punto fijo Q8 (unidades de /control * 256), un paso por tick.
+// La velocidad deseada es la menor entre la maxima y la que todavia permite frenar a tiempo
+// (v^2 = 2*a*d), y la real se acerca a ella como mucho accel_step por tick.
+// Asi ningun paso mueve el servo mas de max_step: esa es la cota del salto de duty entre dos periodos.
+
+#define Q8 256
+
+typedef struct {
+        int32_t pos;            // Q8
+        int32_t vel;            // Q8 por tick
+        int32_t target;         // Q8
+        bool known;             // hasta el primer comando no se sabe donde esta el servo
+} servo_state_t;
+
+static servo_state_t servos[SERVO_COUNT];
+static int32_t max_step = SERVO_MAX_SPEED * Q8 * CONTROL_TICK_MS / 1000;
+static int32_t accel_step = (int32_t)((int64_t)SERVO_MAX_ACCEL * Q8 * CONTROL_TICK_MS * CONTROL_TICK_MS / 1000000);
+
+static int32_t isqrt(uint32_t v){
+    uint32_t r = 0;
+    uint32_t bit = 1UL << 30;
+    while(bit > v){
+        bit >>= 2;
+    }
+    while(bit){
+        if(v >= r + bit){
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+static void servo_write(int index){
+    ledcWrite(SERVO_FIRST_CHANNEL + index, (servos[index].pos * 10 + Q8 / 2) / Q8);
+}
+
+void servo_motion_set_limits(int max_speed, int max_accel){
+    int32_t step = (int64_t)max_speed * Q8 * CONTROL_TICK_MS / 1000;
+    int32_t accel = (int64_t)max_accel * Q8 * CONTROL_TICK_MS * CONTROL_TICK_MS / 1000000;
+    max_step = step > 0 ? step : 1;
+    accel_step = accel > 0 ? accel : 1;
+}
+
+void servo_motion_set_target(int index, int target){
+    servo_state_t * s = &servos[index];
+    s->target = target * Q8;
+    if(!s->known){
+        // Primera orden: no hay posicion de partida desde la que interpolar
+        s->pos = s->target;
+        s->vel = 0;
+        s->known = true;
+        servo_write(index);
+    }
+}
+
+bool servo_motion_known(int index){
+    return servos[index].known;
+}
+
+bool servo_motion_step(){
+    bool moving = false;
+    for(int i = 0; i < SERVO_COUNT; i++){
+        servo_state_t * s = &servos[i];
+        int32_t err = s->target - s->pos;
+        if(!s->known || (!err && !s->vel)){
+            continue;
+        }
+
+        int32_t dist = err < 0 ? -err : err;
+        int32_t cap = isqrt(2 * accel_step * dist);
+        if(cap > max_step){
+            cap = max_step;
+        }
+        int32_t want = err < 0 ? -cap : cap;
+        int32_t v = s->vel;
+        if(v < want){
+            v = v + accel_step < want ? v + accel_step : want;
+        } else if(v > want){
+            v = v - accel_step > want ? v - accel_step : want;
+        }
+
+        // El ultimo paso cae justo en el objetivo
+        if((err > 0 && v >= err) || (err < 0 && v <= err) || !err){
+            s->pos = s->target;
+            s->vel = 0;
+        } else {
+            s->pos += v;
+            s->vel = v;
+            moving = true;
+        }
+        servo_write(i);
+    }
+    return moving;
+}
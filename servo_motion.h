@@ -0,0 +1,24 @@
+#ifndef SERVO_MOTION_H
+#define SERVO_MOTION_H
+
+#include <stdint.h>
+
+// Servos en los canales 8 (servo), 9 (servopan) y 10 (servo3), 50 Hz con 16 bits
+#define SERVO_FIRST_CHANNEL 8
+#define SERVO_COUNT 3
+
+// Limites por defecto en unidades de /control (325..650 = 3250..6500 de duty)
+#define SERVO_MAX_SPEED 400     // unidades/s, todo el recorrido en algo menos de 1 s
+#define SERVO_MAX_ACCEL 2000    // unidades/s^2, velocidad maxima en 0.2 s
+
+// Solo la tarea de actuadores toca la posicion de los servos
+void servo_motion_set_target(int index, int target);
+// Desde cualquier tarea, el siguiente tick ya usa los limites nuevos
+void servo_motion_set_limits(int max_speed, int max_accel);
+// false hasta el primer comando del servo
+bool servo_motion_known(int index);
+
+// Un paso de CONTROL_TICK_MS (un periodo de la PWM de 50 Hz). true mientras quede algun servo en movimiento.
+bool servo_motion_step();
+
+#endif
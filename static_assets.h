@@ -0,0 +1,17 @@
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Un fichero de la pagina ya comprimido con gzip. La tabla la genera tools/embed_html.py en camera_index.h.
+typedef struct {
+        const char * path;      // ruta en camera_httpd; CSS y JS llevan el hash del contenido en el nombre
+        const char * mime;
+        const uint8_t * gz;
+        size_t len;
+        const char * etag;      // entre comillas, listo para la cabecera
+        bool immutable;         // nombre con hash: el contenido de esa ruta no cambia nunca
+} static_asset_t;
+
+#endif
@@ -0,0 +1,84 @@
+#include "stream_abr.h"
+
+#define ABR_BUDGET_US (1000000 / ABR_TARGET_FPS)
+#define ABR_MAX_BACKOFF 3
+
+void stream_abr_init(stream_abr_t * abr, int quality, int size, int size_min){
+    abr->size_min = size_min;
+    stream_abr_set_ceiling(abr, quality, size);
+}
+
+void stream_abr_set_ceiling(stream_abr_t * abr, int quality, int size){
+    abr->quality_best = abr->quality = quality;
+    abr->size_best = abr->size = size < abr->size_min ? abr->size_min : size;
+    abr->calm = 0;
+    abr->backoff = 0;
+    abr->since_up = -1;
+}
+
+// Primero la calidad, que es lo que menos se nota; la resolucion solo con la calidad ya al minimo
+static bool abr_step_down(stream_abr_t * abr){
+    int worst = abr->quality_best > ABR_QUALITY_WORST ? abr->quality_best : ABR_QUALITY_WORST;
+    if(abr->quality < worst){
+        abr->quality = abr->quality + ABR_QUALITY_STEP < worst ? abr->quality + ABR_QUALITY_STEP : worst;
+        return true;
+    }
+    if(abr->size > abr->size_min){
+        abr->size--;
+        return true;
+    }
+    return false;
+}
+
+// Al reves que al bajar: primero se recupera la resolucion y luego la calidad
+static bool abr_step_up(stream_abr_t * abr){
+    if(abr->size < abr->size_best){
+        abr->size++;
+        return true;
+    }
+    if(abr->quality > abr->quality_best){
+        abr->quality = abr->quality - ABR_QUALITY_STEP > abr->quality_best ? abr->quality - ABR_QUALITY_STEP : abr->quality_best;
+        return true;
+    }
+    return false;
+}
+
+bool stream_abr_update(stream_abr_t * abr, const stream_abr_window_t * w){
+    if(!w->frames){
+        // Sin frames completos no hay medida; un envio atascado ya contara cuando acabe
+        return false;
+    }
+    uint32_t send_us = w->send_us / w->frames;
+
+    if(send_us > ABR_BUDGET_US){
+        abr->calm = 0;
+        if(abr->since_up >= 0 && abr->backoff < ABR_MAX_BACKOFF){
+            abr->backoff++;
+        }
+        abr->since_up = -1;
+        return abr_step_down(abr);
+    }
+
+    if(abr->since_up >= 0 && ++abr->since_up >= ABR_CALM_WINDOWS){
+        // La ultima subida ha aguantado
+        abr->since_up = -1;
+        if(abr->backoff > 0){
+            abr->backoff--;
+        }
+    }
+
+    // Subir un escalon puede doblar los bytes por frame, hace falta que quepan dos veces en el presupuesto
+    if(send_us * 2 > ABR_BUDGET_US){
+        abr->calm = 0;
+        return false;
+    }
+    if(++abr->calm < (ABR_CALM_WINDOWS << abr->backoff)){
+        return false;
+    }
+    abr->calm = 0;
+    if(!abr_step_up(abr)){
+        return false;
+    }
+    abr->since_up = 0;
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef STREAM_ABR_H
+#define STREAM_ABR_H
+
+#include <stdint.h>
+
+// Control de bitrate del stream: si los frames tardan en salir mas de lo que permite el objetivo
+// de fps se baja la calidad JPEG y, si ya esta al minimo, la resolucion. Con margen se deshace en orden inverso.
+// No depende de nada del ESP32 ni de la camara, se puede probar en el PC con una traza de ancho de banda.
+
+#define ABR_TARGET_FPS 15           // presupuesto de envio por frame: 1000 / fps ms
+#define ABR_WINDOW_MS 1000          // cada cuanto se decide
+#define ABR_QUALITY_WORST 40        // calidad JPEG (mas alto = peor) a la que se llega antes de bajar resolucion
+#define ABR_QUALITY_STEP 5
+#define ABR_CALM_WINDOWS 3          // ventanas seguidas con margen antes de subir
+
+// Resolucion como nivel de una escalera (0 = la mas pequena), la traduccion a framesize_t va aparte
+typedef struct {
+        int quality_best;       // lo que ha pedido el usuario, el techo
+        int size_best;
+        int size_min;
+        int quality;            // lo que se esta usando
+        int size;
+        int calm;               // ventanas seguidas con margen
+        int backoff;            // cada bajada justo despues de una subida dobla la espera para volver a subir
+        int since_up;           // ventanas sin congestion desde la ultima subida, -1 si ya se dio por buena
+} stream_abr_t;
+
+// Lo que han tardado en salir los frames completados en una ventana, sumando todos los clientes
+typedef struct {
+        uint32_t frames;
+        uint64_t send_us;       // desde que el frame se asigna al cliente hasta el ultimo byte
+} stream_abr_window_t;
+
+void stream_abr_init(stream_abr_t * abr, int quality, int size, int size_min);
+// El usuario ha tocado calidad o resolucion: pasa a ser el techo y se vuelve a partir de ahi
+void stream_abr_set_ceiling(stream_abr_t * abr, int quality, int size);
+// true si cambia quality o size
+bool stream_abr_update(stream_abr_t * abr, const stream_abr_window_t * w);
+
+#endif
@@ -0,0 +1,94 @@
+#include "stream_preview.h"
+#include "gray_jpeg.h"
+#include "esp_jpg_decode.h"
+#include "esp_heap_caps.h"
+#include "Arduino.h"
+
+typedef struct {
+        const frame_t * frame;
+        uint8_t ** gray;
+        size_t * capacity;
+        int width;
+        int height;
+        bool ok;
+} preview_decode_t;
+
+// Luminancia del frame a la escala pedida, la de la tarea del stream
+static uint8_t * gray = NULL;
+static size_t gray_capacity = 0;
+
+// Como ring_grow: en PSRAM, solo crece y no conserva el contenido
+static bool preview_grow(uint8_t ** buf, size_t * capacity, size_t len){
+    if(*capacity >= len){
+        return true;
+    }
+    heap_caps_free(*buf);
+    *capacity = 0;
+    *buf = (uint8_t *)heap_caps_malloc(len, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if(!*buf){
+        *buf = (uint8_t *)malloc(len);
+    }
+    if(!*buf){
+        return false;
+    }
+    *capacity = len;
+    return true;
+}
+
+static uint32_t preview_read(void * arg, size_t index, uint8_t * buf, size_t len){
+    preview_decode_t * d = (preview_decode_t *)arg;
+    if(buf){
+        memcpy(buf, d->frame->buf + index, len);
+    }
+    return len;
+}
+
+// tjpgd entrega bloques RGB888 ya escalados; cada fila pasa a gris directamente a su sitio
+static bool preview_write(void * arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t * data){
+    preview_decode_t * d = (preview_decode_t *)arg;
+    if(!data){
+        if(!x && !y){
+            // Primera llamada: tamano de la salida
+            d->width = w;
+            d->height = h;
+            d->ok = preview_grow(d->gray, d->capacity, (size_t)w * h);
+            return d->ok;
+        }
+        return true;
+    }
+    int n = x + w > d->width ? d->width - x : w;
+    for(int row = 0; row < h && y + row < d->height; row++){
+        gray_from_rgb888(data + row * w * 3, *d->gray + (size_t)(y + row) * d->width + x, n);
+    }
+    return true;
+}
+
+static jpg_scale_t preview_jpg_scale(int scale){
+    return scale == 8 ? JPG_SCALE_8X : scale == 4 ? JPG_SCALE_4X : scale == 2 ? JPG_SCALE_2X : JPG_SCALE_NONE;
+}
+
+bool stream_preview_scale_ok(int scale){
+    return scale == 1 || scale == 2 || scale == 4 || scale == 8;
+}
+
+bool stream_preview_decode(const frame_t * f, int scale, uint8_t ** buf, size_t * capacity, int * width, int * height){
+    preview_decode_t d = {f, buf, capacity, 0, 0, false};
+    if(esp_jpg_decode(f->len, preview_jpg_scale(scale), preview_read, preview_write, &d) != ESP_OK || !d.ok){
+        return false;
+    }
+    *width = d.width;
+    *height = d.height;
+    return true;
+}
+
+bool stream_preview_encode(const frame_t * f, int scale, preview_buf_t * out){
+    int width, height;
+    if(!stream_preview_decode(f, scale, &gray, &gray_capacity, &width, &height)){
+        return false;
+    }
+    if(!preview_grow(&out->buf, &out->capacity, gray_jpeg_bound(width, height))){
+        return false;
+    }
+    out->len = gray_jpeg_encode(gray, width, height, width, GRAY_JPEG_QUALITY, out->buf, out->capacity);
+    return out->len > 0;
+}
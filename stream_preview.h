@@ -0,0 +1,29 @@
+#ifndef STREAM_PREVIEW_H
+#define STREAM_PREVIEW_H
+
+#include "camera_pipeline.h"
+
+// Vista previa de poco ancho de banda: /stream?preview=gray&scale=N (1, 2, 4 u 8).
+// El JPEG del anillo se decodifica ya reducido (el IDCT de tjpgd escala al descomprimir, sin filtrar despues)
+// y se vuelve a codificar en gris con gray_jpeg. Solo lo paga quien la pide.
+
+#define PREVIEW_DEFAULT_SCALE 2
+
+typedef struct {
+        uint8_t * buf;
+        size_t len;
+        size_t capacity;
+} preview_buf_t;
+
+// true si scale es una de las que admite el decodificador
+bool stream_preview_scale_ok(int scale);
+
+// Luminancia del JPEG de f a 1/scale en *buf (crece si hace falta, en PSRAM), sin pasar por un RGB entero.
+// Desde cualquier tarea, cada una con su buffer.
+bool stream_preview_decode(const frame_t * f, int scale, uint8_t ** buf, size_t * capacity, int * width, int * height);
+
+// Solo desde la tarea del stream: el buffer de gris intermedio es uno para todos los clientes.
+// out crece si hace falta y se reutiliza frame a frame.
+bool stream_preview_encode(const frame_t * f, int scale, preview_buf_t * out);
+
+#endif
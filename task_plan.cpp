@@ -0,0 +1,176 @@
+#include "task_plan.h"
+#include "Arduino.h"
+
+typedef struct {
+        const char * name;
+        uint32_t stack;
+        UBaseType_t priority;
+        BaseType_t core;
+} task_plan_entry_t;
+
+// El plan. Wi-Fi (23) y lwip (18) van en el nucleo 0 y por encima de todo esto, lo decide el SDK.
+// Los actuadores por encima de la tarea del driver de la camara: su trabajo son microsegundos y el
+// tick tiene que salir a su hora. Captura sobre el grabador, y este sobre movimiento, que solo
+// aprovecha lo que sobra: la tarjeta tiene dos buffers de margen, el analisis ninguno.
+// En el nucleo 0, ws_control por delante de lo demas para que un comando no espere a un frame.
+// En el orden de task_id_t
+static const task_plan_entry_t plan[TASK_PLAN_COUNT] = {
+    {"actuators",    2048, 12, 1},
+    {"cam_capture",  4096,  6, 1},
+    {"motion",       4096,  2, 1},
+    {"recorder",     4096,  4, 1},
+    {"ws_control",   4096,  7, 0},
+    {"httpd",        4096,  5, 0},
+    {"httpd_stream", 4096,  4, 0},
+    // Pila para la vista previa: los bloques de gray_jpeg y las llamadas de tjpgd van sobre esta tarea
+    {"mjpeg_stream", 6144,  5, 0},
+    {"events",       3072,  3, 0},
+    // Por debajo de todo lo de red: una descarga solo usa lo que sobra
+    {"clips",        3072,  2, 0},
+    // La crea Arduino, aqui solo para las medidas
+    {"loopTask",     8192,  1, 1},
+};
+
+// La CPU se mide muestreando desde una interrupcion de timer que tarea ocupa cada nucleo: no depende
+// de que el SDK venga compilado con las estadisticas de FreeRTOS y tambien cuenta los httpd.
+// Periodo primo con el tick de 1 ms para no caer siempre en la misma fase de las tareas periodicas.
+#define SAMPLE_PERIOD_US 997
+#define SAMPLE_TIMER 3
+
+static TaskHandle_t handles[TASK_PLAN_COUNT];
+// Protege handles frente a task_plan_exit: no se lee la pila de una tarea ya borrada
+static portMUX_TYPE handles_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool unpinned[TASK_PLAN_COUNT];
+static TaskHandle_t idle_handles[portNUM_PROCESSORS];
+static volatile uint32_t samples[TASK_PLAN_COUNT];
+static volatile uint32_t idle_samples[portNUM_PROCESSORS];
+static volatile uint32_t ticks = 0;
+static hw_timer_t * sample_timer = NULL;
+
+// Solo loop()
+static uint32_t window_ticks = 0;
+static uint32_t window_samples[TASK_PLAN_COUNT];
+static uint32_t window_idle[portNUM_PROCESSORS];
+static uint16_t permille[TASK_PLAN_COUNT];
+static uint16_t idle_permille[portNUM_PROCESSORS];
+static uint32_t stack_free[TASK_PLAN_COUNT];
+
+static void IRAM_ATTR sample_isr(){
+    ticks++;
+    for(int c = 0; c < portNUM_PROCESSORS; c++){
+        TaskHandle_t current = xTaskGetCurrentTaskHandleForCPU(c);
+        if(current == idle_handles[c]){
+            idle_samples[c]++;
+            continue;
+        }
+        for(int i = 0; i < TASK_PLAN_COUNT; i++){
+            if(handles[i] == current){
+                samples[i]++;
+                break;
+            }
+        }
+    }
+}
+
+bool task_plan_create(task_id_t id, TaskFunction_t fn, void * arg, TaskHandle_t * handle){
+    const task_plan_entry_t * p = &plan[id];
+    // FreeRTOS apunta el handle antes de que la tarea corra; copiarlo despues podria dejar en handles
+    // una tarea que ya ha pasado por task_plan_exit. Si ya ha terminado *handle sale NULL
+    if(xTaskCreatePinnedToCore(fn, p->name, p->stack, arg, p->priority, &handles[id], p->core) != pdPASS){
+        return false;
+    }
+    *handle = handles[id];
+    return true;
+}
+
+// core_id llega a httpd_config_t con IDF 3.3 (core 1.0.3); con el 1.0.2 no hay donde ponerlo
+template<typename T>
+static auto httpd_set_core(T * config, BaseType_t core) -> decltype(config->core_id = core, true){
+    config->core_id = core;
+    return true;
+}
+
+static bool httpd_set_core(...){
+    return false;
+}
+
+void task_plan_httpd(task_id_t id, httpd_config_t * config){
+    config->stack_size = plan[id].stack;
+    config->task_priority = plan[id].priority;
+    unpinned[id] = !httpd_set_core(config, plan[id].core);
+}
+
+static void httpd_register_self(void * arg){
+    handles[(intptr_t)arg] = xTaskGetCurrentTaskHandle();
+}
+
+void task_plan_httpd_started(task_id_t id, httpd_handle_t server){
+    // Las dos tareas se llaman "httpd"; el handle se coge desde dentro
+    httpd_queue_work(server, httpd_register_self, (void *)(intptr_t)id);
+}
+
+void task_plan_register(task_id_t id, TaskHandle_t handle){
+    handles[id] = handle;
+}
+
+void task_plan_exit(task_id_t id){
+    portENTER_CRITICAL(&handles_mux);
+    handles[id] = NULL;
+    portEXIT_CRITICAL(&handles_mux);
+    vTaskDelete(NULL);
+}
+
+void task_plan_start(){
+    if(sample_timer){
+        return;
+    }
+    for(int c = 0; c < portNUM_PROCESSORS; c++){
+        idle_handles[c] = xTaskGetIdleTaskHandleForCPU(c);
+    }
+    // 80 MHz / 80: cuenta en microsegundos
+    sample_timer = timerBegin(SAMPLE_TIMER, 80, true);
+    timerAttachInterrupt(sample_timer, sample_isr, true);
+    timerAlarmWrite(sample_timer, SAMPLE_PERIOD_US, true);
+    timerAlarmEnable(sample_timer);
+}
+
+void task_plan_sample(){
+    uint32_t now = ticks;
+    uint32_t elapsed = now - window_ticks;
+    if(!elapsed){
+        return;
+    }
+    for(int i = 0; i < TASK_PLAN_COUNT; i++){
+        uint32_t s = samples[i];
+        permille[i] = (uint64_t)(s - window_samples[i]) * 1000 / elapsed;
+        window_samples[i] = s;
+        portENTER_CRITICAL(&handles_mux);
+        if(handles[i]){
+            stack_free[i] = uxTaskGetStackHighWaterMark(handles[i]);
+        }
+        portEXIT_CRITICAL(&handles_mux);
+    }
+    for(int c = 0; c < portNUM_PROCESSORS; c++){
+        uint32_t s = idle_samples[c];
+        idle_permille[c] = (uint64_t)(s - window_idle[c]) * 1000 / elapsed;
+        window_idle[c] = s;
+    }
+    window_ticks = now;
+}
+
+void task_plan_stats(task_id_t id, task_stats_t * out){
+    const task_plan_entry_t * p = &plan[id];
+    out->name = p->name;
+    out->core = p->core == tskNO_AFFINITY || unpinned[id] ? -1 : p->core;
+    out->priority = p->priority;
+    out->stack = p->stack;
+    out->stack_free = stack_free[id];
+    out->cpu_ms = (uint64_t)samples[id] * SAMPLE_PERIOD_US / 1000;
+    out->cpu_permille = permille[id];
+    out->running = handles[id] != NULL;
+}
+
+void task_plan_idle(uint16_t * core0, uint16_t * core1){
+    *core0 = idle_permille[0];
+    *core1 = portNUM_PROCESSORS > 1 ? idle_permille[1] : 0;
+}
@@ -0,0 +1,63 @@
+#ifndef TASK_PLAN_H
+#define TASK_PLAN_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_http_server.h"
+
+// Reparto de las tareas entre los dos nucleos, en un solo sitio (la tabla de task_plan.cpp).
+// Nucleo 0: Wi-Fi y lwip (los fija el SDK), los dos httpd, ws_control, el envio del stream, /events y
+// las descargas de /clips. Los httpd solo si el SDK trae core_id en httpd_config_t (core 1.0.3 o mas);
+// con el 1.0.2 van donde los ponga el planificador y /status dice nucleo -1.
+// Nucleo 1: captura y codificacion, movimiento, grabacion en SD, el tick de los actuadores y loop() de Arduino.
+// Asi una rafaga de red no retrasa la captura, y el tick de 20 ms no espera a nadie.
+
+typedef enum {
+        TASK_ACTUATORS,
+        TASK_CAPTURE,
+        TASK_MOTION,
+        TASK_RECORDER,
+        TASK_WS,
+        TASK_CAMERA_HTTPD,
+        TASK_STREAM_HTTPD,
+        TASK_STREAM,
+        TASK_EVENTS,
+        TASK_CLIPS,
+        TASK_LOOP,
+        TASK_PLAN_COUNT
+} task_id_t;
+
+// Ventana de las medidas de CPU; la cierra loop()
+#define TASK_SAMPLE_MS 1000
+
+typedef struct {
+        const char * name;
+        int core;
+        int priority;
+        uint32_t stack;             // bytes
+        uint32_t stack_free;        // minimo de pila libre desde el arranque, bytes
+        uint32_t cpu_ms;            // tiempo de CPU muestreado desde el arranque
+        uint16_t cpu_permille;      // de su nucleo, en la ultima ventana
+        bool running;
+} task_stats_t;
+
+// Crea la tarea con la pila, prioridad y nucleo del plan
+bool task_plan_create(task_id_t id, TaskFunction_t fn, void * arg, TaskHandle_t * handle);
+// Pila, prioridad y nucleo de un httpd; su tarea se registra sola al arrancar (task_plan_httpd_started)
+void task_plan_httpd(task_id_t id, httpd_config_t * config);
+void task_plan_httpd_started(task_id_t id, httpd_handle_t server);
+// Tareas que no crea el plan (loop() de Arduino)
+void task_plan_register(task_id_t id, TaskHandle_t handle);
+// Para una tarea del plan que termina ella sola: la quita de las medidas y se borra. No vuelve
+void task_plan_exit(task_id_t id);
+
+// Empieza a muestrear que tarea ocupa cada nucleo
+void task_plan_start();
+// Cierra la ventana de CPU y apunta la pila libre; cada TASK_SAMPLE_MS desde loop()
+void task_plan_sample();
+
+void task_plan_stats(task_id_t id, task_stats_t * out);
+// Libre de cada nucleo en la ultima ventana, en milesimas
+void task_plan_idle(uint16_t * core0, uint16_t * core1);
+
+#endif
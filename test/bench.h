@@ -0,0 +1,42 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Utilidades de los bancos: duracion desde la linea de comandos y percentiles de una muestra
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+// --seconds N (por defecto def); ctest los pasa cortos para comprobar que funcionan
+static inline double bench_seconds(int argc, char ** argv, double def){
+    for(int i = 1; i + 1 < argc; i++){
+        if(!strcmp(argv[i], "--seconds")){
+            return atof(argv[i + 1]);
+        }
+    }
+    return def;
+}
+
+// Valor de argv despues de name, o def
+static inline const char * bench_arg(int argc, char ** argv, const char * name, const char * def){
+    for(int i = 1; i + 1 < argc; i++){
+        if(!strcmp(argv[i], name)){
+            return argv[i + 1];
+        }
+    }
+    return def;
+}
+
+// p en 0..100; ordena la muestra
+static inline uint32_t bench_percentile(std::vector<uint32_t> & v, double p){
+    if(v.empty()){
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p / 100.0 * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+#endif
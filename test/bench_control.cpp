@@ -0,0 +1,62 @@
+#include "control.h"
+#include "actuators.h"
+#include "device_state.h"
+#include "esp_timer.h"
+#include "bench.h"
+#include <stdio.h>
+
+// Peticiones de /control por segundo: control_apply_query con el registro, los actuadores y su
+// cola de verdad (la tarea de actuadores corre en su hilo). Lo de fuera del coche no hace nada.
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){}
+void mjpeg_stream_abr_enable(bool enable){}
+void event_stream_set_period(int ms){}
+bool motion_stage_enable(bool enable){ return true; }
+void motion_stage_set_threshold(int threshold){}
+void clip_server_set_rate(int kbps){}
+
+// Lo que manda la pagina: joystick, servos, sliders, varios a la vez y el latido
+static const char * const queries[] = {
+    "drivex=40&drivey=-20",
+    "var=servo&val=500",
+    "servo=400&servopan=520&servo3=610",
+    "var=speed&val=200",
+    "var=flash&val=12",
+    "heartbeat=1",
+    "var=car&val=1",
+    "drivey=0",
+};
+#define QUERIES (sizeof(queries) / sizeof(queries[0]))
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 3);
+    actuators_start();
+
+    std::vector<uint32_t> lat;
+    uint64_t requests = 0;
+    uint64_t commands = 0;
+    uint64_t rejected = 0;
+    char buf[CONTROL_QUERY_MAX];
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    while(now < end){
+        for(size_t i = 0; i < QUERIES; i++){
+            strcpy(buf, queries[i]);
+            int applied;
+            int64_t t0 = esp_timer_get_time();
+            int res = control_apply_query(buf, &applied);
+            now = esp_timer_get_time();
+            lat.push_back(now - t0);
+            requests++;
+            commands += applied;
+            rejected += res != 0;
+        }
+    }
+    double secs = (now - start) / 1000000.0;
+    printf("control: %.0f peticiones/s, %.0f comandos/s, %llu rechazadas (cola de motores llena)\n",
+           requests / secs, commands / secs, (unsigned long long)rejected);
+    printf("control: latencia p50 %u us, p90 %u us, p99 %u us, max %u us\n",
+           bench_percentile(lat, 50), bench_percentile(lat, 90), bench_percentile(lat, 99), bench_percentile(lat, 100));
+    return requests ? 0 : 1;
+}
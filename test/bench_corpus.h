@@ -0,0 +1,66 @@
+#ifndef BENCH_CORPUS_H
+#define BENCH_CORPUS_H
+
+// Corpus de JPEG grabados para los bancos: --corpus dir carga los .jpg de dir en orden de nombre
+
+#include <stdio.h>
+#include <stdint.h>
+#include <dirent.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Medidas del SOF; false si no es un JPEG que se pueda leer
+static inline bool jpeg_size(const std::vector<uint8_t> & j, size_t * w, size_t * h){
+    for(size_t i = 2; i + 9 < j.size(); ){
+        if(j[i] != 0xFF){
+            return false;
+        }
+        uint8_t m = j[i + 1];
+        size_t len = (j[i + 2] << 8) | j[i + 3];
+        if(m == 0xC0 || m == 0xC1 || m == 0xC2){
+            *h = (j[i + 5] << 8) | j[i + 6];
+            *w = (j[i + 7] << 8) | j[i + 8];
+            return true;
+        }
+        i += 2 + len;
+    }
+    return false;
+}
+
+// Cuantos frames ha cargado; w y h son los del ultimo
+static inline size_t load_corpus(const char * dir, std::vector<std::vector<uint8_t> > & frames, size_t * w, size_t * h){
+    DIR * d = opendir(dir);
+    if(!d){
+        return 0;
+    }
+    std::vector<std::string> names;
+    struct dirent * e;
+    while((e = readdir(d))){
+        std::string n = e->d_name;
+        if(n.size() > 4 && (n.substr(n.size() - 4) == ".jpg" || n.substr(n.size() - 4) == ".JPG")){
+            names.push_back(std::string(dir) + "/" + n);
+        }
+    }
+    closedir(d);
+    std::sort(names.begin(), names.end());
+    for(size_t i = 0; i < names.size(); i++){
+        FILE * f = fopen(names[i].c_str(), "rb");
+        if(!f){
+            continue;
+        }
+        std::vector<uint8_t> j;
+        uint8_t buf[4096];
+        size_t n;
+        while((n = fread(buf, 1, sizeof(buf), f)) > 0){
+            j.insert(j.end(), buf, buf + n);
+        }
+        fclose(f);
+        if(jpeg_size(j, w, h)){
+            frames.push_back(j);
+        }
+    }
+    return frames.size();
+}
+
+#endif
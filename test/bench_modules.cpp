@@ -0,0 +1,120 @@
+#include "gray_jpeg.h"
+#include "motion_detect.h"
+#include "drive_mixer.h"
+#include "stream_abr.h"
+#include "avi.h"
+#include "device_state.h"
+#include "esp_timer.h"
+#include "bench.h"
+#include <stdio.h>
+
+// Los modulos que no dependen del ESP32, uno a uno: cuanto cuesta cada llamada en el PC.
+// En la placa (240 MHz, sin SIMD) es del orden de 10 a 30 veces mas; lo que importa es la tendencia
+// entre un cambio y el siguiente.
+//   bench_modules [--seconds 0.5]     tiempo de cada medida
+
+static volatile uint32_t sink;
+
+// Repite fn hasta gastar seconds y devuelve ns por llamada
+template<typename Fn>
+static double bench_ns(double seconds, Fn fn){
+    uint64_t calls = 0;
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    while(now < end){
+        for(int i = 0; i < 16; i++){
+            fn();
+        }
+        calls += 16;
+        now = esp_timer_get_time();
+    }
+    return (now - start) * 1000.0 / calls;
+}
+
+static void gray_image(uint8_t * y, int width, int height, int shift){
+    uint32_t seed = 7;
+    for(int r = 0; r < height; r++){
+        for(int c = 0; c < width; c++){
+            seed = seed * 1103515245 + 12345;
+            y[r * width + c] = ((c + shift) ^ r) + ((seed >> 16) & 15);
+        }
+    }
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 0.5);
+
+    static const int sizes[][2] = {{160, 120}, {320, 240}, {640, 480}};
+    for(int s = 0; s < 3; s++){
+        int w = sizes[s][0], h = sizes[s][1];
+        std::vector<uint8_t> gray(w * h);
+        std::vector<uint8_t> out(gray_jpeg_bound(w, h));
+        gray_image(gray.data(), w, h, 0);
+        size_t len = 0;
+        double ns = bench_ns(seconds, [&]{ len = gray_jpeg_encode(gray.data(), w, h, w, GRAY_JPEG_QUALITY, out.data(), out.size()); });
+        printf("gray_jpeg_encode %dx%d: %.0f us/frame, %.1f Mpixel/s, %u bytes\n", w, h, ns / 1000, w * h * 1000.0 / ns, (unsigned)len);
+    }
+
+    {
+        std::vector<uint8_t> rgb(640 * 3 * 8);
+        std::vector<uint8_t> y(640 * 8);
+        for(size_t i = 0; i < rgb.size(); i++){
+            rgb[i] = i * 31;
+        }
+        double ns = bench_ns(seconds, [&]{ gray_from_rgb888(rgb.data(), y.data(), 640 * 8); sink = y[5]; });
+        printf("gray_from_rgb888: %.2f ns/pixel\n", ns / (640 * 8));
+    }
+
+    {
+        const int w = 200, h = 150;
+        std::vector<uint16_t> bg(w * h);
+        std::vector<uint8_t> a(w * h), b(w * h);
+        gray_image(a.data(), w, h, 0);
+        gray_image(b.data(), w, h, 3);
+        motion_detector_t m;
+        motion_detect_init(&m, bg.data(), bg.size(), MOTION_THRESHOLD);
+        motion_box_t box;
+        motion_detect(&m, a.data(), w, h, &box);
+        int n = 0;
+        double ns = bench_ns(seconds, [&]{ sink = motion_detect(&m, (n++ & 1) ? a.data() : b.data(), w, h, &box); });
+        printf("motion_detect %dx%d (UXGA a 1/8): %.1f us/analisis\n", w, h, ns / 1000);
+    }
+
+    {
+        uint8_t duty[4];
+        int x = -100;
+        double ns = bench_ns(seconds, [&]{ drive_mixer_mix(x, 100 - x, 255, duty); x = x < 100 ? x + 1 : -100; sink = duty[0]; });
+        printf("drive_mixer_mix: %.1f ns/tick\n", ns);
+    }
+
+    {
+        stream_abr_t abr;
+        stream_abr_init(&abr, 10, 6, 0);
+        stream_abr_window_t slow = {10, 10 * 90000};
+        stream_abr_window_t fast = {15, 15 * 10000};
+        int n = 0;
+        double ns = bench_ns(seconds, [&]{ sink = stream_abr_update(&abr, (n++ & 4) ? &slow : &fast); });
+        printf("stream_abr_update: %.1f ns/ventana\n", ns);
+    }
+
+    {
+        uint8_t head[AVI_HEADER_SIZE];
+        avi_info_t info = {640, 480, 1200, 50000, 1200 * 20000, 30000, true};
+        double ns = bench_ns(seconds, [&]{ avi_header(head, &info); sink = head[40]; });
+        printf("avi_header: %.1f ns\n", ns);
+    }
+
+    {
+        int32_t values[STATE_FIELDS];
+        int32_t prev[STATE_FIELDS];
+        uint32_t v = state_snapshot(values);
+        memcpy(prev, values, sizeof(prev));
+        prev[STATE_SPEED] = 0;
+        char buf[640];
+        double full = bench_ns(seconds, [&]{ sink = state_format(buf, sizeof(buf), v, values, NULL); });
+        double diff = bench_ns(seconds, [&]{ sink = state_format(buf, sizeof(buf), v, values, prev); });
+        printf("state_format: %.0f ns completo, %.0f ns diferencias\n", full, diff);
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+#include "camera_pipeline.h"
+#include "img_converters.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "bench.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <deque>
+
+// Memoria de la captura con un sensor sin JPEG: heap_caps_malloc por frame y como queda la PSRAM
+// (libre, hueco mas grande) despues de N frames. Dos formas de hacerlo con el mismo patron de uso:
+//   malloc por frame: lo de antes. frame2jpg pide un bloque de 128 KB para cada frame, que pasa a ser
+//                     el del hueco del anillo, y se libera el que tenia.
+//   anillo:           camera_pipeline de verdad, codificando en el buffer que el hueco ya tiene.
+// En los dos un cliente lento se queda cada frame durante HOLD frames y otro modulo pide y suelta
+// bloques medianos entre frame y frame (la vista previa, el httpd), como en la placa.
+// La PSRAM es la del doble de heap_caps (host.h): primer hueco que cabe, como multi_heap.
+//   bench_pipeline [--frames 600] [--size vga|qvga] [--format rgb565|gray]
+
+void recorder_tee(const frame_t * f){}
+bool motion_stage_due(int64_t timestamp){ return false; }
+void motion_stage_offer(frame_t * f){ frame_release(f); }
+
+#define ENCODE_QUALITY 80
+#define FRAME2JPG_BUF (128 * 1024)      // lo que reserva fmt2jpg de esp32-camera para cada frame
+#define HOLD 3
+#define NEIGHBOR_BYTES (24 * 1024)
+#define NEIGHBOR_LIFE 5
+
+typedef struct {
+        const char * name;
+        uint32_t frames;
+        uint32_t dropped;
+        uint32_t allocs;
+        uint32_t seen;          // los que llegan al cliente
+        uint64_t bytes;
+        double secs;
+        size_t free_after;
+        size_t largest_after;
+} run_t;
+
+// Otro modulo de la placa: un bloque que vive NEIGHBOR_LIFE frames, de tamano variable. Sus reservas
+// no cuentan en heap_caps_malloc/frame
+typedef struct {
+        std::deque<void *> live;
+        uint32_t n;
+} neighbor_t;
+
+static void neighbor_step(neighbor_t * nb){
+    nb->live.push_back(heap_caps_malloc(NEIGHBOR_BYTES + (nb->n++ % 7) * 4096, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if(nb->live.size() > NEIGHBOR_LIFE){
+        heap_caps_free(nb->live.front());
+        nb->live.pop_front();
+    }
+}
+
+static void neighbor_clear(neighbor_t * nb){
+    while(!nb->live.empty()){
+        heap_caps_free(nb->live.front());
+        nb->live.pop_front();
+    }
+}
+
+typedef struct {
+        uint8_t * buf;
+        size_t len;
+        size_t capacity;
+} out_t;
+
+static size_t out_write(void * arg, size_t index, const void * data, size_t len){
+    out_t * o = (out_t *)arg;
+    if(o->len + len > o->capacity){
+        return 0;
+    }
+    memcpy(o->buf + o->len, data, len);
+    o->len += len;
+    return len;
+}
+
+// Lo de antes, con el mismo reparto de huecos que ring_reserve_slot: el primero sin referencias
+static run_t run_per_frame(const std::vector<std::vector<uint8_t> > & corpus, size_t w, size_t h, pixformat_t format, uint32_t frames){
+    run_t r = {"malloc por frame", 0, 0, 0, 0, 0, 0, 0, 0};
+    struct {
+            uint8_t * buf;
+            int refs;
+    } slots[FRAME_RING_SIZE] = {};
+    int latest = -1;
+    std::deque<int> held;
+    neighbor_t nb = {std::deque<void *>(), 0};
+    uint32_t allocs = host_heap_allocs();
+    int64_t start = esp_timer_get_time();
+    for(uint32_t i = 0; i < frames; i++){
+        camera_fb_t fb = {(uint8_t *)corpus[i % corpus.size()].data(), corpus[i % corpus.size()].size(), w, h, format};
+        int slot = -1;
+        for(int s = 0; s < FRAME_RING_SIZE && slot < 0; s++){
+            slot = slots[s].refs ? -1 : s;
+        }
+        out_t o = {(uint8_t *)heap_caps_malloc(FRAME2JPG_BUF, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT), 0, FRAME2JPG_BUF};
+        if(slot < 0 || !o.buf || !frame2jpg_cb(&fb, ENCODE_QUALITY, out_write, &o)){
+            heap_caps_free(o.buf);
+            r.dropped++;
+        } else {
+            heap_caps_free(slots[slot].buf);
+            slots[slot].buf = o.buf;
+            slots[slot].refs = 1;
+            if(latest >= 0){
+                slots[latest].refs--;
+            }
+            latest = slot;
+            slots[slot].refs++;
+            held.push_back(slot);
+            if(held.size() > HOLD){
+                slots[held.front()].refs--;
+                held.pop_front();
+            }
+            r.frames++;
+            r.seen++;
+            r.bytes += o.len;
+        }
+        neighbor_step(&nb);
+    }
+    r.secs = (esp_timer_get_time() - start) / 1000000.0;
+    r.allocs = host_heap_allocs() - allocs - nb.n;
+    r.free_after = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    r.largest_after = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    neighbor_clear(&nb);
+    for(int s = 0; s < FRAME_RING_SIZE; s++){
+        heap_caps_free(slots[s].buf);
+    }
+    return r;
+}
+
+static run_t run_ring(uint32_t frames){
+    run_t r = {"anillo", 0, 0, 0, 0, 0, 0, 0, 0};
+    std::deque<frame_t *> held;
+    neighbor_t nb = {std::deque<void *>(), 0};
+    uint32_t captured0, dropped0, captured, dropped;
+    camera_pipeline_stats(&captured0, &dropped0);
+    uint32_t allocs = host_heap_allocs();
+    uint32_t camera0 = host_camera_frames();
+    int64_t start = esp_timer_get_time();
+    camera_pipeline_subscribe();
+    uint32_t seq = 0;
+    // Cada frame que sale lo mira el cliente lento; los que se salta la captura no cuentan
+    while(host_camera_frames() - camera0 < frames){
+        frame_t * f = frame_acquire_latest(seq, 1000);
+        if(!f){
+            break;
+        }
+        seq = f->seq;
+        r.seen++;
+        r.bytes += f->len;
+        held.push_back(f);
+        if(held.size() > HOLD){
+            frame_release(held.front());
+            held.pop_front();
+        }
+        neighbor_step(&nb);
+    }
+    camera_pipeline_unsubscribe();
+    r.secs = (esp_timer_get_time() - start) / 1000000.0;
+    camera_pipeline_stats(&captured, &dropped);
+    r.frames = captured - captured0 - (dropped - dropped0);
+    r.dropped = dropped - dropped0;
+    r.allocs = host_heap_allocs() - allocs - nb.n;
+    r.free_after = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    r.largest_after = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    neighbor_clear(&nb);
+    while(!held.empty()){
+        frame_release(held.front());
+        held.pop_front();
+    }
+    return r;
+}
+
+static void report(const run_t * r){
+    uint32_t total = r->frames + r->dropped;
+    size_t used = HOST_PSRAM_SIZE - r->free_after;
+    printf("%-17s %5u frames %5.0f fps  %4u perdidos  %5.1f KB/frame  %5.2f heap_caps_malloc/frame  PSRAM usada %5zu KB"
+           "  hueco mayor %5zu KB  fragmentacion %4.1f%%\n",
+           r->name, r->frames, r->frames / r->secs, r->dropped, r->seen ? r->bytes / 1024.0 / r->seen : 0.0,
+           total ? (double)r->allocs / total : 0.0,
+           used / 1024, r->largest_after / 1024, r->free_after ? 100.0 * (1 - (double)r->largest_after / r->free_after) : 0.0);
+}
+
+int main(int argc, char ** argv){
+    uint32_t frames = atoi(bench_arg(argc, argv, "--frames", "600"));
+    bool vga = strcmp(bench_arg(argc, argv, "--size", "vga"), "qvga");
+    bool gray = !strcmp(bench_arg(argc, argv, "--format", "rgb565"), "gray");
+    size_t w = vga ? 640 : 320, h = vga ? 480 : 240, bpp = gray ? 1 : 2;
+    pixformat_t format = gray ? PIXFORMAT_GRAYSCALE : PIXFORMAT_RGB565;
+
+    // Escena con textura que se mueve un poco frame a frame; en RGB565 el mismo gris, big-endian como el sensor
+    std::vector<std::vector<uint8_t> > corpus;
+    for(int i = 0; i < 8; i++){
+        std::vector<uint8_t> img(w * h * bpp);
+        for(size_t p = 0; p < w * h; p++){
+            size_t x = p % w, y = p / w;
+            uint8_t v = (uint8_t)(x / 3 + y / 4 + ((x + i * 6) / 24 + y / 24) % 2 * 50);
+            if(gray){
+                img[p] = v;
+            } else {
+                uint16_t px = (v >> 3) << 11 | (v >> 2) << 5 | v >> 3;
+                img[p * 2] = px >> 8;
+                img[p * 2 + 1] = px & 0xff;
+            }
+        }
+        corpus.push_back(img);
+    }
+    printf("%zux%zu %s, %u frames, un cliente se queda %d frames, otro modulo pide %d-%d KB cada frame\n",
+           w, h, gray ? "gris" : "RGB565", frames, HOLD, NEIGHBOR_BYTES / 1024, NEIGHBOR_BYTES / 1024 + 24);
+    size_t free_before = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    printf("PSRAM al empezar: %zu KB libres, hueco mayor %zu KB\n", free_before / 1024,
+           heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM) / 1024);
+
+    run_t before = run_per_frame(corpus, w, h, format, frames);
+    report(&before);
+
+    esp_camera_sensor_get()->pixformat = format;
+    host_camera_corpus(corpus, w, h, 0);
+    camera_pipeline_start();
+    run_t after = run_ring(frames);
+    report(&after);
+
+    uint32_t buffer_allocs;
+    size_t buffer_bytes;
+    camera_pipeline_buffer_stats(&buffer_allocs, &buffer_bytes);
+    printf("anillo: %u reservas en total para %u huecos, %zu KB\n", buffer_allocs, FRAME_RING_SIZE, buffer_bytes / 1024);
+    fflush(stdout);
+    // La tarea de captura sigue en su hilo
+    _exit(before.frames && after.frames ? 0 : 1);
+}
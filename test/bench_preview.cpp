@@ -0,0 +1,172 @@
+#include "stream_preview.h"
+#include "gray_jpeg.h"
+#include "img_converters.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "bench.h"
+#include "bench_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// La vista previa de /stream contra lo que se haria con los conversores de esp32-camera, frame a frame
+// sobre el mismo corpus y a cada escala:
+//   generico:       fmt2rgb888 del frame entero, reducir el RGB y fmt2jpg en color
+//   generico gris:  igual pero codificando la luminancia: separa lo que ahorra decodificar ya reducido
+//   vista previa:   stream_preview_encode, decodificando a la escala y codificando en gris con gray_jpeg
+// Se mide el tiempo por frame, lo que pesa lo que sale y la memoria de trabajo que hace falta.
+//   bench_preview [--seconds 4] [--corpus dir_con_jpg]
+// Sin corpus: VGA en color con textura que se desplaza, codificado a calidad 80 como lo deja el sensor.
+
+typedef struct {
+        const char * name;
+        uint32_t frames;
+        uint64_t bytes;
+        size_t scratch;
+        double secs;
+} run_t;
+
+typedef struct {
+        std::vector<uint8_t> buf;
+} sink_t;
+
+static size_t sink_write(void * arg, size_t index, const void * data, size_t len){
+    sink_t * s = (sink_t *)arg;
+    s->buf.insert(s->buf.end(), (const uint8_t *)data, (const uint8_t *)data + len);
+    return len;
+}
+
+static void synth_corpus(std::vector<std::vector<uint8_t> > & frames, size_t * w, size_t * h){
+    const int width = 640, height = 480;
+    std::vector<uint8_t> rgb(width * height * 3);
+    uint32_t seed = 1;
+    for(int f = 0; f < 30; f++){
+        for(int y = 0; y < height; y++){
+            for(int x = 0; x < width; x++){
+                seed = seed * 1103515245 + 12345;
+                uint8_t * p = &rgb[(y * width + x) * 3];
+                uint8_t v = ((x + f * 8) ^ y) + ((seed >> 16) & 3);
+                p[0] = v;
+                p[1] = (x + y) / 5 + v / 4;
+                p[2] = 255 - v / 2;
+            }
+        }
+        camera_fb_t fb = {rgb.data(), rgb.size(), width, height, PIXFORMAT_RGB888};
+        sink_t s;
+        frame2jpg_cb(&fb, 80, sink_write, &s);
+        frames.push_back(s.buf);
+    }
+    *w = width;
+    *h = height;
+}
+
+// Media de cada bloque scale x scale, por canal
+static void shrink_rgb(const uint8_t * src, int width, int height, int scale, uint8_t * dst){
+    int w = width / scale, h = height / scale;
+    for(int y = 0; y < h; y++){
+        for(int x = 0; x < w; x++){
+            for(int c = 0; c < 3; c++){
+                int sum = 0;
+                for(int dy = 0; dy < scale; dy++){
+                    for(int dx = 0; dx < scale; dx++){
+                        sum += src[((y * scale + dy) * width + x * scale + dx) * 3 + c];
+                    }
+                }
+                dst[(y * w + x) * 3 + c] = sum / (scale * scale);
+            }
+        }
+    }
+}
+
+static run_t run_generic(const std::vector<std::vector<uint8_t> > & frames, int width, int height, int scale, bool gray, double seconds){
+    run_t r = {gray ? "generico gris" : "generico", 0, 0, 0, 0};
+    int w = width / scale, h = height / scale;
+    std::vector<uint8_t> rgb(width * height * 3);
+    std::vector<uint8_t> small(w * h * 3);
+    std::vector<uint8_t> y(w * h);
+    r.scratch = rgb.size() + (scale > 1 ? small.size() : 0) + (gray ? y.size() : 0);
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    for(size_t i = 0; esp_timer_get_time() < end; i++){
+        const std::vector<uint8_t> & j = frames[i % frames.size()];
+        if(!fmt2rgb888(j.data(), j.size(), PIXFORMAT_JPEG, rgb.data())){
+            break;
+        }
+        uint8_t * src = rgb.data();
+        if(scale > 1){
+            shrink_rgb(rgb.data(), width, height, scale, small.data());
+            src = small.data();
+        }
+        if(gray){
+            gray_from_rgb888(src, y.data(), w * h);
+        }
+        uint8_t * out = NULL;
+        size_t len = 0;
+        bool ok = gray ? fmt2jpg(y.data(), y.size(), w, h, PIXFORMAT_GRAYSCALE, GRAY_JPEG_QUALITY, &out, &len) :
+                         fmt2jpg(src, w * h * 3, w, h, PIXFORMAT_RGB888, GRAY_JPEG_QUALITY, &out, &len);
+        if(!ok){
+            break;
+        }
+        free(out);
+        r.frames++;
+        r.bytes += len;
+    }
+    r.secs = (esp_timer_get_time() - start) / 1000000.0;
+    return r;
+}
+
+static run_t run_preview(const std::vector<std::vector<uint8_t> > & frames, int width, int height, int scale, double seconds){
+    run_t r = {"vista previa", 0, 0, 0, 0};
+    preview_buf_t out = {NULL, 0, 0};
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    for(size_t i = 0; esp_timer_get_time() < end; i++){
+        const std::vector<uint8_t> & j = frames[i % frames.size()];
+        frame_t f = {(uint8_t *)j.data(), j.size(), j.size(), (size_t)width, (size_t)height, (uint32_t)i, 0, 1};
+        if(!stream_preview_encode(&f, scale, &out)){
+            break;
+        }
+        r.frames++;
+        r.bytes += out.len;
+    }
+    r.secs = (esp_timer_get_time() - start) / 1000000.0;
+    // El gris intermedio de stream_preview es (width / scale) * (height / scale)
+    r.scratch = (size_t)(width / scale) * (height / scale) + out.capacity;
+    heap_caps_free(out.buf);
+    return r;
+}
+
+static void report(int scale, const run_t * r, const run_t * base){
+    double ms = r->frames ? r->secs * 1000 / r->frames : 0;
+    double base_ms = base->frames ? base->secs * 1000 / base->frames : 0;
+    printf("1/%d %-13s %7.2f ms/frame  %6.1f KB/frame  %6zu KB de trabajo  %5.2fx\n", scale, r->name, ms,
+           r->frames ? r->bytes / 1024.0 / r->frames : 0.0, r->scratch / 1024, ms ? base_ms / ms : 0.0);
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 4);
+    const char * dir = bench_arg(argc, argv, "--corpus", NULL);
+    std::vector<std::vector<uint8_t> > frames;
+    size_t width = 0, height = 0;
+    if(!dir || !load_corpus(dir, frames, &width, &height)){
+        synth_corpus(frames, &width, &height);
+    }
+    uint64_t corpus_bytes = 0;
+    for(size_t i = 0; i < frames.size(); i++){
+        corpus_bytes += frames[i].size();
+    }
+    printf("corpus: %u frames %ux%u, %u bytes de media; la ultima columna es contra el generico\n",
+           (unsigned)frames.size(), (unsigned)width, (unsigned)height, (unsigned)(corpus_bytes / frames.size()));
+
+    bool ok = true;
+    double each = seconds / 12;
+    for(int scale = 1; scale <= 8; scale *= 2){
+        run_t generic = run_generic(frames, width, height, scale, false, each);
+        run_t generic_gray = run_generic(frames, width, height, scale, true, each);
+        run_t preview = run_preview(frames, width, height, scale, each);
+        report(scale, &generic, &generic);
+        report(scale, &generic_gray, &generic);
+        report(scale, &preview, &generic);
+        ok = ok && generic.frames && generic_gray.frames && preview.frames;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+#include "recorder.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "bench.h"
+#include "bench_corpus.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <string>
+
+// La grabacion contra tarjetas lentas: los frames llegan a recorder_tee al ritmo del sensor, como desde
+// la tarea de captura, y la "tarjeta" (host_sd_write_hook) tarda en cada write() lo que tardaria una de
+// verdad: una latencia fija, los bytes a su velocidad y de vez en cuando una pausa larga (la tarjeta
+// borrando bloques). Con dos buffers de RECORD_BUFFER_SIZE lo que no cabe mientras tanto se pierde.
+// Por cada tarjeta: MB/s que llegan, MB/s grabados, lo que mide el propio grabador y st.dropped.
+//   bench_recorder [--seconds 3] [--fps 25] [--frame-kb 40] [--corpus dir_con_jpg]
+//                  [--sd-kbps K --sd-latency-ms L --stall-ms S --stall-every-kb N]  (solo esa tarjeta)
+
+void camera_pipeline_subscribe(){}
+void camera_pipeline_unsubscribe(){}
+
+typedef struct {
+        const char * name;
+        uint32_t kbps;
+        uint32_t latency_us;
+        uint32_t stall_us;
+        uint32_t stall_every;   // bytes entre pausas, 0 sin pausas
+} card_t;
+
+// Medidas tipicas en SDMMC de 1 bit a 20 MHz: las buenas no pasan de 2 MB/s
+static const card_t cards[] = {
+    {"buena", 1800, 1000, 0, 0},
+    {"clase 10 con pausas", 1500, 2000, 100000, 4 * 1024 * 1024},
+    {"clase 4", 900, 3000, 250000, 2 * 1024 * 1024},
+    {"vieja", 400, 5000, 250000, 1024 * 1024},
+};
+#define CARDS (sizeof(cards) / sizeof(cards[0]))
+
+static const card_t * card;
+static uint64_t card_bytes;
+
+static void card_write(size_t len){
+    uint64_t us = card->latency_us + (uint64_t)len * 1000000 / ((uint64_t)card->kbps * 1024);
+    if(card->stall_every && (card_bytes + len) / card->stall_every != card_bytes / card->stall_every){
+        us += card->stall_us;
+    }
+    card_bytes += len;
+    usleep(us);
+}
+
+static void clear_clips(){
+    DIR * dir = opendir(RECORD_DIR);
+    if(!dir){
+        return;
+    }
+    struct dirent * e;
+    while((e = readdir(dir))){
+        if(e->d_name[0] != '.'){
+            unlink((std::string(RECORD_DIR "/") + e->d_name).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+// Sin corpus: tamanos de JPEG que varian alrededor de frame_kb como los de una escena que cambia
+static void synth_frames(std::vector<std::vector<uint8_t> > & frames, int frame_kb){
+    uint32_t seed = 1;
+    for(int i = 0; i < 50; i++){
+        seed = seed * 1103515245 + 12345;
+        size_t len = frame_kb * 1024 * (75 + (seed >> 16) % 51) / 100;
+        std::vector<uint8_t> j(len);
+        for(size_t p = 0; p < len; p++){
+            j[p] = p * 7 + i;
+        }
+        frames.push_back(j);
+    }
+}
+
+static bool run(const card_t * c, const std::vector<std::vector<uint8_t> > & frames, int fps, double seconds){
+    card = c;
+    card_bytes = 0;
+    if(recorder_begin() != RECORD_OK){
+        fprintf(stderr, "bench_recorder: no empieza a grabar\n");
+        return false;
+    }
+    frame_t f;
+    memset(&f, 0, sizeof(f));
+    f.width = 640;
+    f.height = 480;
+    uint64_t offered = 0;
+    int64_t start = esp_timer_get_time();
+    int64_t period = 1000000 / fps;
+    uint32_t n = seconds * fps;
+    for(uint32_t i = 0; i < n; i++){
+        int64_t due = start + i * period;
+        int64_t now = esp_timer_get_time();
+        if(due > now){
+            usleep(due - now);
+        }
+        const std::vector<uint8_t> & j = frames[i % frames.size()];
+        f.buf = (uint8_t *)j.data();
+        f.len = j.size();
+        f.seq = i + 1;
+        f.timestamp = esp_timer_get_time();
+        recorder_tee(&f);
+        offered += j.size();
+    }
+    double feed_secs = (esp_timer_get_time() - start) / 1000000.0;
+    recorder_end();
+    // Un frame mas para que la captura entregue el ultimo buffer
+    recorder_tee(&f);
+    record_status_t st;
+    do {
+        vTaskDelay(10);
+        recorder_status(&st);
+    } while(st.state != RECORD_IDLE);
+    double secs = (esp_timer_get_time() - start) / 1000000.0;
+    printf("%-20s %5u KB/s %2u ms, pausa %3u ms cada %4u KB | llega %.2f MB/s, grabado %.2f MB/s, grabador %5u KB/s,"
+           " %4u frames, %4u perdidos (%4.1f%%)%s\n", c->name, c->kbps, c->latency_us / 1000, c->stall_us / 1000,
+           c->stall_every / 1024, offered / 1048576.0 / feed_secs, st.bytes / 1048576.0 / secs, st.write_kbps, st.frames,
+           st.dropped, st.frames + st.dropped ? 100.0 * st.dropped / (st.frames + st.dropped) : 0.0,
+           st.error != RECORD_OK ? " ERROR" : "");
+    clear_clips();
+    return st.error == RECORD_OK && st.frames;
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 3);
+    int fps = atoi(bench_arg(argc, argv, "--fps", "25"));
+    int frame_kb = atoi(bench_arg(argc, argv, "--frame-kb", "40"));
+    const char * dir = bench_arg(argc, argv, "--corpus", NULL);
+    const char * kbps = bench_arg(argc, argv, "--sd-kbps", NULL);
+    std::vector<std::vector<uint8_t> > frames;
+    size_t w, h;
+    if(!dir || !load_corpus(dir, frames, &w, &h)){
+        synth_frames(frames, frame_kb);
+    }
+    uint64_t total = 0;
+    for(size_t i = 0; i < frames.size(); i++){
+        total += frames[i].size();
+    }
+    printf("%d fps, %u KB por frame de media, %.2f MB/s; dos buffers de %u KB\n", fps, (unsigned)(total / frames.size() / 1024),
+           total * fps / frames.size() / 1048576.0, RECORD_BUFFER_SIZE / 1024);
+
+    recorder_mount();
+    clear_clips();
+    recorder_start();
+    host_sd_write_hook = card_write;
+    bool ok = true;
+    if(kbps){
+        card_t custom = {"a medida", (uint32_t)atoi(kbps), (uint32_t)atoi(bench_arg(argc, argv, "--sd-latency-ms", "2")) * 1000,
+                         (uint32_t)atoi(bench_arg(argc, argv, "--stall-ms", "0")) * 1000,
+                         (uint32_t)atoi(bench_arg(argc, argv, "--stall-every-kb", "0")) * 1024};
+        ok = run(&custom, frames, fps, seconds);
+    } else {
+        for(size_t i = 0; i < CARDS; i++){
+            ok = run(&cards[i], frames, fps, seconds / CARDS) && ok;
+        }
+    }
+    fflush(stdout);
+    // La tarea del grabador sigue en su hilo
+    _exit(ok ? 0 : 1);
+}
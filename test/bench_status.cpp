@@ -0,0 +1,113 @@
+#include "esp_http_server.h"
+#include "device_state.h"
+#include "esp_timer.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Peticiones de /status por segundo por el status_handler de verdad (startCameraServer y
+// host_httpd_dispatch): con el JSON en cache, regenerandolo en cada una (un state_set antes, como
+// con el joystick moviendose) y con ?since=<version> sin cambios. Despues state_format solo:
+// el estado entero frente al diff de event_stream con uno o dos campos cambiados.
+// La peticion incluye lo que cuesta el stub (std::string), igual en los tres casos.
+
+extern httpd_handle_t camera_httpd;
+void startCameraServer();
+
+typedef enum {
+        STATUS_CACHED,
+        STATUS_REBUILD,
+        STATUS_SINCE
+} status_mode_t;
+
+static const char * const mode_names[] = {"cacheado", "regenerado", "since sin cambios"};
+
+static void bench_requests(status_mode_t mode, double seconds){
+    std::vector<uint32_t> lat;
+    uint64_t requests = 0;
+    uint64_t bytes = 0;
+    char query[24] = "";
+    httpd_req_t req;
+    req.fd = -1;
+    req.uri = "/status";
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    while(now < end){
+        if(mode == STATUS_SINCE){
+            snprintf(query, sizeof(query), "since=%u", state_version());
+        }
+        req.query = query;
+        int64_t t0 = esp_timer_get_time();
+        if(mode == STATUS_REBUILD){
+            state_set(STATE_DRIVEX, requests & 63);
+        }
+        req.status.clear();
+        req.headers.clear();
+        req.body.clear();
+        host_httpd_dispatch(camera_httpd, &req);
+        now = esp_timer_get_time();
+        lat.push_back(now - t0);
+        requests++;
+        bytes += req.body.size();
+    }
+    double secs = (now - start) / 1000000.0;
+    uint64_t busy = 0;
+    for(size_t i = 0; i < lat.size(); i++){
+        busy += lat[i];
+    }
+    printf("/status %-18s %8.0f peticiones/s, %5.0f ns de media, p99 %u us, %4.0f bytes\n", mode_names[mode],
+           requests / secs, busy * 1000.0 / requests, bench_percentile(lat, 99), (double)bytes / requests);
+}
+
+// changed campos distintos de prev; 0 es el estado entero (sin prev)
+static void bench_format(int changed, double seconds){
+    int32_t values[STATE_FIELDS];
+    int32_t prev[STATE_FIELDS];
+    uint32_t version = state_snapshot(values);
+    memcpy(prev, values, sizeof(prev));
+    char buf[608];
+    uint64_t calls = 0;
+    uint64_t bytes = 0;
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    while(now < end){
+        for(int i = 0; i < 1000; i++){
+            values[STATE_DRIVEX] = prev[STATE_DRIVEX] + (changed >= 1 ? 1 + (i & 7) : 0);
+            values[STATE_DRIVEY] = prev[STATE_DRIVEY] + (changed >= 2 ? 1 + (i & 7) : 0);
+            bytes += state_format(buf, sizeof(buf), version, values, changed ? prev : NULL);
+        }
+        calls += 1000;
+        now = esp_timer_get_time();
+    }
+    double secs = (now - start) / 1000000.0;
+    char label[24];
+    snprintf(label, sizeof(label), changed ? "diff, %d campo%s" : "entero", changed, changed > 1 ? "s" : "");
+    printf("state_format %-16s %8.0f /s, %5.0f ns, %4.0f bytes\n", label, calls / secs, secs * 1e9 / calls,
+           (double)bytes / calls);
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 3);
+    startCameraServer();
+    if(!camera_httpd){
+        fprintf(stderr, "bench_status: no arranca camera_httpd\n");
+        return 1;
+    }
+    // Servos con posicion, como despues de tocar la pagina: tambien salen en el JSON
+    state_set(STATE_SERVO, 500);
+    state_set(STATE_SERVOPAN, 520);
+    state_set(STATE_SERVO3, 610);
+
+    bench_requests(STATUS_CACHED, seconds / 6);
+    bench_requests(STATUS_REBUILD, seconds / 6);
+    bench_requests(STATUS_SINCE, seconds / 6);
+    bench_format(0, seconds / 6);
+    bench_format(1, seconds / 6);
+    bench_format(2, seconds / 6);
+    fflush(stdout);
+    // ws_control y las tareas de los servidores siguen en sus hilos
+    _exit(0);
+}
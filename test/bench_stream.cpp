@@ -0,0 +1,290 @@
+#include "camera_pipeline.h"
+#include "mjpeg_stream.h"
+#include "stream_preview.h"
+#include "gray_jpeg.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "bench.h"
+#include "bench_corpus.h"
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/tcp.h>
+#include <unistd.h>
+#include <string>
+
+// /stream de punta a punta en el PC: la tarea de captura lee un corpus de JPEG al ritmo del sensor,
+// el anillo y la tarea de envio de mjpeg_stream reparten a clientes TCP por loopback, y cada cliente
+// mide cuanto tarda cada frame desde la captura (X-Timestamp) hasta su ultimo byte.
+//   bench_stream [--seconds 5] [--clients N] [--fps 25] [--slow-kbps 0] [--preview 0] [--corpus dir_con_jpg]
+// Con --slow-kbps uno de los clientes lee a ese ritmo, como un movil con mala cobertura. Con --preview N
+// el primero pide la vista previa en gris a 1/N, que se decodifica y codifica de verdad (stream_preview).
+// Sin --clients va de 1 a MJPEG_MAX_CLIENTS en la misma ejecucion y acaba con una fila por cada numero.
+// bench_stream_parts es lo mismo con MJPEG_SEND_PARTS: un envio por parte, para comparar escrituras y
+// segmentos por frame con el sendmsg de tres iovec.
+
+void perf_frame(size_t len, uint32_t frame_ms){}
+void recorder_tee(const frame_t * f){}
+bool motion_stage_due(int64_t timestamp){ return false; }
+void motion_stage_offer(frame_t * f){ frame_release(f); }
+
+// lwip en la placa: TCP_SND_BUF de 4 segmentos; con el del PC ningun cliente se atascaria nunca
+#define BENCH_SNDBUF 5744
+// Y su TCP_MSS: por loopback los segmentos serian de 64 KB y no se veria cuantos salen por frame
+#define BENCH_MSS 1436
+
+typedef struct {
+        int fd;
+        int slow_kbps;
+        volatile bool stop;
+        uint32_t frames;
+        uint64_t bytes;
+        std::vector<uint32_t> latency_us;
+} bench_client_t;
+
+// Sin corpus: VGA con textura que se desplaza, para que cada frame pese como uno de verdad
+static void synth_corpus(std::vector<std::vector<uint8_t> > & frames, size_t * w, size_t * h){
+    const int width = 640, height = 480;
+    std::vector<uint8_t> gray(width * height);
+    std::vector<uint8_t> out(gray_jpeg_bound(width, height));
+    uint32_t seed = 1;
+    for(int f = 0; f < 30; f++){
+        for(int y = 0; y < height; y++){
+            for(int x = 0; x < width; x++){
+                seed = seed * 1103515245 + 12345;
+                gray[y * width + x] = ((x + f * 8) ^ y) + ((seed >> 16) & 3);
+            }
+        }
+        size_t len = gray_jpeg_encode(gray.data(), width, height, width, 80, out.data(), out.size());
+        frames.push_back(std::vector<uint8_t>(out.begin(), out.begin() + len));
+    }
+    *w = width;
+    *h = height;
+}
+
+static long header_value(const std::string & head, const char * key){
+    size_t p = head.find(key);
+    return p == std::string::npos ? -1 : atol(head.c_str() + p + strlen(key));
+}
+
+static void * client_main(void * arg){
+    bench_client_t * c = (bench_client_t *)arg;
+    std::string in;
+    char buf[16384];
+    int64_t start = esp_timer_get_time();
+    uint64_t total = 0;
+    while(!c->stop){
+        size_t want = sizeof(buf);
+        if(c->slow_kbps){
+            // Lee al ritmo pedido: lo que toca a estas alturas menos lo ya leido
+            int64_t allowed = (esp_timer_get_time() - start) * c->slow_kbps * 1024 / 1000000 - total;
+            if(allowed <= 0){
+                usleep(2000);
+                continue;
+            }
+            want = allowed < (int64_t)want ? allowed : want;
+        }
+        ssize_t n = recv(c->fd, buf, want, 0);
+        if(n <= 0){
+            break;
+        }
+        total += n;
+        in.append(buf, n);
+        while(true){
+            size_t end = in.find("\r\n\r\n");
+            if(end == std::string::npos){
+                break;
+            }
+            std::string head = in.substr(0, end);
+            long len = header_value(head, "Content-Length: ");
+            long long ts = header_value(head, "X-Timestamp: ");
+            if(len < 0){
+                in.erase(0, end + 4);
+                continue;
+            }
+            if(in.size() < end + 4 + len){
+                break;
+            }
+            int64_t now = esp_timer_get_time();
+            c->latency_us.push_back(now - ts);
+            c->frames++;
+            c->bytes += end + 4 + len;
+            in.erase(0, end + 4 + len);
+        }
+    }
+    return NULL;
+}
+
+static void tcp_pair(int * server_fd, int * client_fd){
+    int l = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in a;
+    memset(&a, 0, sizeof(a));
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t al = sizeof(a);
+    bind(l, (struct sockaddr *)&a, sizeof(a));
+    getsockname(l, (struct sockaddr *)&a, &al);
+    listen(l, 1);
+    *client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    int rcv = BENCH_SNDBUF;
+    setsockopt(*client_fd, SOL_SOCKET, SO_RCVBUF, &rcv, sizeof(rcv));
+    int mss = BENCH_MSS;
+    setsockopt(*client_fd, IPPROTO_TCP, TCP_MAXSEG, &mss, sizeof(mss));
+    connect(*client_fd, (struct sockaddr *)&a, sizeof(a));
+    *server_fd = accept(l, NULL, NULL);
+    int snd = BENCH_SNDBUF;
+    setsockopt(*server_fd, SOL_SOCKET, SO_SNDBUF, &snd, sizeof(snd));
+    ::close(l);
+}
+
+typedef struct {
+        int clients;
+        double fps;             // media de los clientes
+        double fps_min;
+        uint32_t p50_us;        // de todos los frames de todos los clientes
+        uint32_t p99_us;
+        double kbps;
+        uint32_t captured;
+        uint32_t dropped;
+        uint32_t skipped;
+        uint32_t writes;
+        uint32_t frames;
+        double writes_per_frame;        // llamadas a sendmsg por frame enviado
+        double bytes_per_frame;         // lo que sale por el socket: cabecera, JPEG y boundary
+        double segs_per_frame;          // segmentos TCP con datos (TCP_INFO)
+} round_t;
+
+static uint32_t data_segs_out(int fd){
+    struct tcp_info ti;
+    socklen_t len = sizeof(ti);
+    memset(&ti, 0, sizeof(ti));
+    return getsockopt(fd, IPPROTO_TCP, TCP_INFO, &ti, &len) == 0 ? ti.tcpi_data_segs_out : 0;
+}
+
+// n clientes durante seconds; al acabar se sueltan como lo haria el servidor y mjpeg_stream queda sin nadie
+static round_t run_round(int n, int slow_kbps, int preview, double seconds){
+    round_t r;
+    memset(&r, 0, sizeof(r));
+    r.clients = n;
+    uint32_t captured0, dropped0;
+    camera_pipeline_stats(&captured0, &dropped0);
+    mjpeg_stream_stats_t st0;
+    mjpeg_stream_stats(&st0);
+
+    bench_client_t c[MJPEG_MAX_CLIENTS];
+    int server_fd[MJPEG_MAX_CLIENTS];
+    pthread_t threads[MJPEG_MAX_CLIENTS];
+    for(int i = 0; i < n; i++){
+        tcp_pair(&server_fd[i], &c[i].fd);
+        c[i].slow_kbps = i == n - 1 ? slow_kbps : 0;
+        c[i].stop = false;
+        c[i].frames = 0;
+        c[i].bytes = 0;
+        pthread_create(&threads[i], NULL, client_main, &c[i]);
+        mjpeg_stream_add_client(server_fd[i], i ? 0 : preview);
+    }
+
+    int64_t start = esp_timer_get_time();
+    usleep((useconds_t)(seconds * 1000000));
+    double secs = (esp_timer_get_time() - start) / 1000000.0;
+    std::vector<uint32_t> lat;
+    uint64_t bytes = 0;
+    r.fps_min = -1;
+    uint32_t segs = 0;
+    for(int i = 0; i < n; i++){
+        // Primero sale de mjpeg_stream, luego se cierra: la tarea de envio ya no lo toca
+        mjpeg_stream_close_fn(NULL, server_fd[i]);
+        segs += data_segs_out(server_fd[i]);
+        c[i].stop = true;
+        shutdown(c[i].fd, SHUT_RDWR);
+        pthread_join(threads[i], NULL);
+        ::close(server_fd[i]);
+        ::close(c[i].fd);
+        double fps = c[i].frames / secs;
+        printf("  cliente %d%s%s: %.1f fps, %.0f KB/s, latencia p50 %.1f ms, p90 %.1f ms, p99 %.1f ms\n", i,
+               c[i].slow_kbps ? " (lento)" : "", !i && preview ? " (vista previa)" : "", fps, c[i].bytes / 1024.0 / secs,
+               bench_percentile(c[i].latency_us, 50) / 1000.0, bench_percentile(c[i].latency_us, 90) / 1000.0,
+               bench_percentile(c[i].latency_us, 99) / 1000.0);
+        r.fps += fps / n;
+        r.fps_min = r.fps_min < 0 || fps < r.fps_min ? fps : r.fps_min;
+        lat.insert(lat.end(), c[i].latency_us.begin(), c[i].latency_us.end());
+        bytes += c[i].bytes;
+        r.frames += c[i].frames;
+    }
+    r.p50_us = bench_percentile(lat, 50);
+    r.p99_us = bench_percentile(lat, 99);
+    r.kbps = bytes / 1024.0 / secs;
+    uint32_t captured, dropped;
+    camera_pipeline_stats(&captured, &dropped);
+    r.captured = captured - captured0;
+    r.dropped = dropped - dropped0;
+    mjpeg_stream_stats_t st;
+    mjpeg_stream_stats(&st);
+    r.skipped = st.skipped - st0.skipped;
+    r.writes = st.writes - st0.writes;
+    uint32_t sent = st.frames - st0.frames;
+    if(sent){
+        r.writes_per_frame = (double)r.writes / sent;
+        r.bytes_per_frame = (double)(st.wire_bytes - st0.wire_bytes) / sent;
+        r.segs_per_frame = (double)segs / sent;
+    }
+    return r;
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 5);
+    const char * only = bench_arg(argc, argv, "--clients", NULL);
+    int fps = atoi(bench_arg(argc, argv, "--fps", "25"));
+    int slow_kbps = atoi(bench_arg(argc, argv, "--slow-kbps", "0"));
+    int preview = atoi(bench_arg(argc, argv, "--preview", "0"));
+    const char * dir = bench_arg(argc, argv, "--corpus", NULL);
+    int clients = only ? atoi(only) : 0;
+    if(only && (clients < 1 || clients > MJPEG_MAX_CLIENTS)){
+        fprintf(stderr, "bench_stream: --clients de 1 a %d (MJPEG_MAX_CLIENTS)\n", MJPEG_MAX_CLIENTS);
+        return 1;
+    }
+    if(preview && !stream_preview_scale_ok(preview)){
+        fprintf(stderr, "bench_stream: --preview 1, 2, 4 u 8\n");
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t> > frames;
+    size_t width = 0, height = 0;
+    if(!dir || !load_corpus(dir, frames, &width, &height)){
+        synth_corpus(frames, &width, &height);
+    }
+    uint64_t corpus_bytes = 0;
+    for(size_t i = 0; i < frames.size(); i++){
+        corpus_bytes += frames[i].size();
+    }
+    printf("corpus: %u frames %ux%u, %u bytes de media, sensor a %d fps\n", (unsigned)frames.size(),
+           (unsigned)width, (unsigned)height, (unsigned)(corpus_bytes / frames.size()), fps);
+    host_camera_corpus(frames, width, height, fps);
+
+    camera_pipeline_start();
+    mjpeg_stream_start(host_httpd_server(mjpeg_stream_close_fn));
+
+    // Sin --clients, de 1 a MJPEG_MAX_CLIENTS en la misma ejecucion, repartiendo el tiempo
+    int first = clients ? clients : 1;
+    int last = clients ? clients : MJPEG_MAX_CLIENTS;
+    std::vector<round_t> rounds;
+    for(int n = first; n <= last; n++){
+        printf("%d cliente%s:\n", n, n > 1 ? "s" : "");
+        rounds.push_back(run_round(n, slow_kbps, preview, seconds / (last - first + 1)));
+    }
+    printf("envio: %s\n", MJPEG_SEND_PARTS ? "un envio por parte (cabecera, JPEG, boundary)" : "un sendmsg con 3 iovec");
+    printf("clientes  fps media  fps min  p50 ms  p99 ms   KB/s  capturados  perdidos  saltados  escrituras"
+           "  escr/frame  bytes/frame  segs/frame\n");
+    bool ok = true;
+    for(size_t i = 0; i < rounds.size(); i++){
+        round_t * r = &rounds[i];
+        printf("%8d  %9.1f  %7.1f  %6.1f  %6.1f  %5.0f  %10u  %8u  %8u  %10u  %10.2f  %11.0f  %10.1f\n", r->clients,
+               r->fps, r->fps_min, r->p50_us / 1000.0, r->p99_us / 1000.0, r->kbps, r->captured, r->dropped, r->skipped,
+               r->writes, r->writes_per_frame, r->bytes_per_frame, r->segs_per_frame);
+        ok = ok && r->frames;
+    }
+    fflush(stdout);
+    // Las tareas siguen en sus hilos; se sale sin destruir nada de lo que usan
+    _exit(ok ? 0 : 1);
+}
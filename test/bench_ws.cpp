@@ -0,0 +1,231 @@
+#include "ws_control.h"
+#include "control.h"
+#include "actuators.h"
+#include "esp_timer.h"
+#include "bench.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+
+// Comandos por segundo y latencia de ida y vuelta, uno detras de otro como el joystick:
+// el canal WebSocket de verdad (su tarea, por loopback) contra GET /control. Para /control hace de
+// camera_httpd un servidor minimo en un hilo que lee la peticion, llama a control_apply_query y
+// contesta lo mismo que cmd_handler; va con keep-alive y con una conexion nueva por comando.
+// En el PC no hay Wi-Fi: lo que se mide es lo que cuesta cada comando a los dos lados, no el RTT de la radio.
+//   bench_ws --seconds 3
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){}
+void mjpeg_stream_abr_enable(bool enable){}
+void event_stream_set_period(int ms){}
+bool motion_stage_enable(bool enable){ return true; }
+void motion_stage_set_threshold(int threshold){}
+void clip_server_set_rate(int kbps){}
+
+#define HTTP_PORT (WS_CONTROL_PORT + 1)
+
+// Lo mismo por los dos caminos: canal de ws_channels y su nombre en /control
+typedef struct {
+        uint8_t channel;
+        const char * name;
+        int16_t value;
+} bench_cmd_t;
+
+static const bench_cmd_t cmds[] = {
+    {9, "drivex", 40}, {10, "drivey", -20}, {5, "servo", 500}, {6, "servopan", 520},
+    {3, "speed", 200}, {2, "flash", 12}, {10, "drivey", 0}, {9, "drivex", 0},
+};
+#define CMDS (sizeof(cmds) / sizeof(cmds[0]))
+
+// Lo que manda fetch() desde la pagina, cabeceras incluidas
+#define HTTP_HEADERS "Host: 192.168.4.1\r\nConnection: keep-alive\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n" \
+                     "Accept: */*\r\nReferer: http://192.168.4.1/\r\nAccept-Encoding: gzip, deflate\r\n" \
+                     "Accept-Language: es-ES,es;q=0.9\r\n\r\n"
+
+static int tcp_connect(int port){
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for(int i = 0; i < 200; i++){
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0){
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            return fd;
+        }
+        close(fd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+// Hasta el final de las cabeceras; false si se cierra antes
+static bool read_head(int fd, std::string * head){
+    head->clear();
+    char buf[512];
+    while(head->find("\r\n\r\n") == std::string::npos){
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if(n <= 0){
+            return false;
+        }
+        head->append(buf, n);
+    }
+    return true;
+}
+
+// camera_httpd para /control: una conexion a la vez, como su unica tarea
+static void http_server(){
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(HTTP_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 4) < 0){
+        perror("bench_ws: bind");
+        exit(1);
+    }
+    char query[CONTROL_QUERY_MAX];
+    std::string head;
+    while(true){
+        int fd = accept(listen_fd, NULL, NULL);
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        while(read_head(fd, &head)){
+            size_t q = head.find('?');
+            size_t end = head.find(' ', q);
+            int applied = 0;
+            int res = -1;
+            if(q != std::string::npos && end - q - 1 < sizeof(query)){
+                memcpy(query, head.c_str() + q + 1, end - q - 1);
+                query[end - q - 1] = 0;
+                res = control_apply_query(query, &applied);
+            }
+            const char * resp = applied && !res ?
+                "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: 0\r\nAccess-Control-Allow-Origin: *\r\n\r\n" :
+                "HTTP/1.1 500 Internal Server Error\r\nContent-Type: text/html\r\nContent-Length: 0\r\n\r\n";
+            send(fd, resp, strlen(resp), 0);
+        }
+        close(fd);
+    }
+}
+
+typedef struct {
+        uint64_t commands;
+        uint64_t failed;        // sin respuesta
+        uint64_t rejected;      // NACK o 500: cola de motores llena
+        uint64_t wire;          // bytes por el socket en los dos sentidos
+        double secs;
+        std::vector<uint32_t> lat;
+} run_t;
+
+static void report(const char * name, run_t * r){
+    printf("%-22s %8.0f comandos/s  p50 %4u us  p99 %5u us  %4.0f bytes/comando  %llu rechazados  %llu fallidos\n", name,
+           r->commands / r->secs, bench_percentile(r->lat, 50), bench_percentile(r->lat, 99),
+           r->commands ? (double)r->wire / r->commands : 0.0, (unsigned long long)r->rejected, (unsigned long long)r->failed);
+}
+
+static run_t run_http(double seconds, bool keep_alive){
+    run_t r = {0, 0, 0, 0, 0, std::vector<uint32_t>()};
+    int fd = keep_alive ? tcp_connect(HTTP_PORT) : -1;
+    std::string head;
+    char req[512];
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    for(size_t i = 0; now < end; i = (i + 1) % CMDS){
+        int n = snprintf(req, sizeof(req), "GET /control?var=%s&val=%d HTTP/1.1\r\n" HTTP_HEADERS, cmds[i].name, cmds[i].value);
+        int64_t t0 = esp_timer_get_time();
+        if(!keep_alive){
+            fd = tcp_connect(HTTP_PORT);
+        }
+        send(fd, req, n, 0);
+        bool ok = read_head(fd, &head) && !head.compare(0, 9, "HTTP/1.1 ");
+        if(!keep_alive){
+            close(fd);
+        }
+        now = esp_timer_get_time();
+        r.lat.push_back(now - t0);
+        r.commands++;
+        r.failed += !ok;
+        r.rejected += ok && head.compare(0, 12, "HTTP/1.1 200");
+        r.wire += n + head.size();
+    }
+    if(keep_alive){
+        close(fd);
+    }
+    r.secs = (now - start) / 1000000.0;
+    return r;
+}
+
+static run_t run_ws(double seconds){
+    run_t r = {0, 0, 0, 0, 0, std::vector<uint32_t>()};
+    int fd = tcp_connect(WS_CONTROL_PORT);
+    const char * upgrade = "GET / HTTP/1.1\r\nHost: 192.168.4.1\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                           "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    send(fd, upgrade, strlen(upgrade), 0);
+    std::string head;
+    if(!read_head(fd, &head) || head.compare(0, 12, "HTTP/1.1 101")){
+        fprintf(stderr, "bench_ws: sin upgrade\n");
+        exit(1);
+    }
+    // Trama del navegador: 2 de cabecera, 4 de mascara y un comando; vuelve con 2 + 8
+    uint8_t frame[6 + WS_FRAME_LEN];
+    uint8_t reply[2 + WS_FRAME_LEN];
+    const uint8_t mask[4] = {0x12, 0x34, 0x56, 0x78};
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)(seconds * 1000000);
+    int64_t now = start;
+    uint32_t seq = 0;
+    for(size_t i = 0; now < end; i = (i + 1) % CMDS){
+        uint8_t cmd[WS_FRAME_LEN] = {WS_OP_SET, cmds[i].channel, (uint8_t)(cmds[i].value & 0xff), (uint8_t)((uint16_t)cmds[i].value >> 8)};
+        seq++;
+        memcpy(cmd + 4, &seq, 4);
+        frame[0] = 0x82;
+        frame[1] = 0x80 | WS_FRAME_LEN;
+        memcpy(frame + 2, mask, 4);
+        for(int b = 0; b < WS_FRAME_LEN; b++){
+            frame[6 + b] = cmd[b] ^ mask[b & 3];
+        }
+        int64_t t0 = esp_timer_get_time();
+        send(fd, frame, sizeof(frame), 0);
+        bool ok = recv(fd, reply, sizeof(reply), MSG_WAITALL) == sizeof(reply) && !memcmp(reply + 6, &seq, 4);
+        now = esp_timer_get_time();
+        r.lat.push_back(now - t0);
+        r.commands++;
+        r.failed += !ok;
+        r.rejected += ok && reply[2] != WS_OP_ACK;
+        r.wire += sizeof(frame) + sizeof(reply);
+    }
+    close(fd);
+    r.secs = (now - start) / 1000000.0;
+    return r;
+}
+
+int main(int argc, char ** argv){
+    double seconds = bench_seconds(argc, argv, 3);
+    actuators_start();
+    ws_control_start();
+    std::thread(http_server).detach();
+
+    run_t ws = run_ws(seconds / 3);
+    run_t keep = run_http(seconds / 3, true);
+    run_t fresh = run_http(seconds / 3, false);
+    report("websocket", &ws);
+    report("/control keep-alive", &keep);
+    report("/control sin keep-alive", &fresh);
+    // Contra /control keep-alive: por encima de 1 gana el WebSocket
+    double p50_ws = bench_percentile(ws.lat, 50);
+    printf("websocket / keep-alive: %.2fx comandos/s, %.2fx latencia p50, %.1fx menos bytes por comando\n",
+           (ws.commands / ws.secs) / (keep.commands / keep.secs), p50_ws ? bench_percentile(keep.lat, 50) / p50_ws : 0.0,
+           ws.commands && keep.commands ? ((double)keep.wire / keep.commands) / ((double)ws.wire / ws.commands) : 0.0);
+    fflush(stdout);
+    _exit(ws.failed || keep.failed || fresh.failed || !ws.commands ? 1 : 0);
+}
@@ -0,0 +1,36 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// Lo minimo para las pruebas en el PC: cada CHECK que falla se cuenta y se escribe con su linea,
+// la prueba sigue, y check_done() da el codigo de salida para ctest.
+
+#include <stdio.h>
+
+static int check_failures = 0;
+
+#define CHECK(cond) do { \
+        if(!(cond)){ \
+            fprintf(stderr, "%s:%d: fallo: %s\n", __FILE__, __LINE__, #cond); \
+            check_failures++; \
+        } \
+    } while(0)
+
+#define CHECK_EQ(a, b) do { \
+        long long check_a = (long long)(a); \
+        long long check_b = (long long)(b); \
+        if(check_a != check_b){ \
+            fprintf(stderr, "%s:%d: fallo: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, check_a, check_b); \
+            check_failures++; \
+        } \
+    } while(0)
+
+static inline int check_done(const char * name){
+    if(check_failures){
+        fprintf(stderr, "%s: %d fallos\n", name, check_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Lo del core de Arduino para ESP32 que usa el sketch. ledcWrite guarda el duty por canal (host.h).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+
+// En el ESP32 las constantes ya van en flash sin mas
+#define PROGMEM
+
+void ledcWrite(uint8_t channel, uint32_t duty);
+double ledcSetup(uint8_t channel, double freq, uint8_t resolution_bits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+
+// Timers hardware: timerBegin guarda la interrupcion, host_timer_fire la llama (host.h)
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t * timerBegin(uint8_t num, uint16_t divider, bool count_up);
+void timerAttachInterrupt(hw_timer_t * timer, void (*fn)(void), bool edge);
+void timerAlarmWrite(hw_timer_t * timer, uint64_t alarm_value, bool autoreload);
+void timerAlarmEnable(hw_timer_t * timer);
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef HOST_DRIVER_SDMMC_HOST_H
+#define HOST_DRIVER_SDMMC_HOST_H
+
+#include <stdint.h>
+
+#define SDMMC_HOST_FLAG_1BIT (1 << 0)
+#define SDMMC_HOST_FLAG_4BIT (1 << 1)
+
+typedef struct {
+        uint32_t flags;
+        int slot;
+} sdmmc_host_t;
+
+typedef struct {
+        uint8_t width;
+} sdmmc_slot_config_t;
+
+#define SDMMC_HOST_DEFAULT() {SDMMC_HOST_FLAG_4BIT, 1}
+#define SDMMC_SLOT_CONFIG_DEFAULT() {4}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef HOST_ESP_CAMERA_H
+#define HOST_ESP_CAMERA_H
+
+// esp32-camera del core 1.0.2: los frames salen de un corpus que carga el banco o la prueba (host.h)
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef enum {
+        PIXFORMAT_RGB565,
+        PIXFORMAT_YUV422,
+        PIXFORMAT_GRAYSCALE,
+        PIXFORMAT_JPEG,
+        PIXFORMAT_RGB888,
+        PIXFORMAT_RAW,
+        PIXFORMAT_RGB444,
+        PIXFORMAT_RGB555
+} pixformat_t;
+
+typedef enum {
+        FRAMESIZE_QQVGA,    // 160x120
+        FRAMESIZE_QQVGA2,   // 128x160
+        FRAMESIZE_QCIF,     // 176x144
+        FRAMESIZE_HQVGA,    // 240x176
+        FRAMESIZE_QVGA,     // 320x240
+        FRAMESIZE_CIF,      // 400x296
+        FRAMESIZE_VGA,      // 640x480
+        FRAMESIZE_SVGA,     // 800x600
+        FRAMESIZE_XGA,      // 1024x768
+        FRAMESIZE_SXGA,     // 1280x1024
+        FRAMESIZE_UXGA,     // 1600x1200
+        FRAMESIZE_QXGA,     // 2048x1536
+        FRAMESIZE_INVALID
+} framesize_t;
+
+typedef struct {
+        uint8_t * buf;
+        size_t len;
+        size_t width;
+        size_t height;
+        pixformat_t format;
+} camera_fb_t;
+
+typedef struct {
+        framesize_t framesize;
+        uint8_t quality;
+} camera_status_t;
+
+typedef struct _sensor sensor_t;
+struct _sensor {
+        pixformat_t pixformat;
+        camera_status_t status;
+        int (*set_framesize)(sensor_t * sensor, framesize_t framesize);
+        int (*set_quality)(sensor_t * sensor, int quality);
+};
+
+camera_fb_t * esp_camera_fb_get();
+void esp_camera_fb_return(camera_fb_t * fb);
+sensor_t * esp_camera_sensor_get();
+
+#endif
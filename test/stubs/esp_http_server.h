@@ -0,0 +1,99 @@
+#ifndef HOST_ESP_HTTP_SERVER_H
+#define HOST_ESP_HTTP_SERVER_H
+
+// esp_http_server de IDF 3.2, sin el servidor: una peticion es lo que la prueba rellena a mano
+// y las respuestas se guardan en ella. httpd_config_t sin core_id, como en esa version.
+// httpd_trigger_sess_close hace lo que el servidor de IDF 3.x: close_fn y despues cierra el socket.
+// httpd_start no abre ningun puerto: guarda la configuracion y los handlers, y host_httpd_dispatch
+// pasa una peticion por ellos como haria la tarea del servidor.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <map>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef void * httpd_handle_t;
+typedef void (*httpd_close_func_t)(httpd_handle_t hd, int sockfd);
+typedef void (*httpd_work_fn_t)(void * arg);
+
+typedef enum {
+        HTTP_GET,
+        HTTP_POST
+} httpd_method_t;
+
+typedef struct {
+        unsigned task_priority;
+        size_t stack_size;
+        uint16_t server_port;
+        uint16_t ctrl_port;
+        uint16_t max_open_sockets;
+        uint16_t max_uri_handlers;
+        uint16_t max_resp_headers;
+        uint16_t backlog_conn;
+        bool lru_purge_enable;
+        uint16_t recv_wait_timeout;
+        uint16_t send_wait_timeout;
+        httpd_close_func_t close_fn;
+} httpd_config_t;
+
+// Los valores por defecto de IDF 3.2
+#define HTTPD_DEFAULT_CONFIG() {5, 4096, 80, 32768, 7, 8, 8, 5, false, 5, 5, NULL}
+
+#define ESP_ERR_HTTPD_BASE 0x8000
+#define ESP_ERR_HTTPD_HANDLERS_FULL (ESP_ERR_HTTPD_BASE + 1)
+#define ESP_ERR_HTTPD_HANDLER_EXISTS (ESP_ERR_HTTPD_BASE + 2)
+
+typedef struct httpd_req {
+        int fd;
+        std::string uri;
+        std::string query;
+        std::map<std::string, std::string> req_headers;     // cabeceras de la peticion
+        void * user_ctx;                // el de su httpd_uri_t, lo pone host_httpd_dispatch
+        std::string status;             // lo que deja la respuesta
+        std::string type;
+        std::string headers;
+        std::string body;
+        bool chunked;
+} httpd_req_t;
+
+#define HTTPD_RESP_USE_STRLEN -1
+
+typedef struct httpd_uri {
+        const char * uri;
+        httpd_method_t method;
+        esp_err_t (*handler)(httpd_req_t * r);
+        void * user_ctx;
+} httpd_uri_t;
+
+// Un servidor de mentira con su close_fn, para httpd_trigger_sess_close
+httpd_handle_t host_httpd_server(httpd_close_func_t close_fn);
+// La peticion al handler registrado con esa URI exacta, como el servidor de IDF 3.2 (sin comodines).
+// Sin handler la respuesta es un 404 y devuelve ESP_ERR_NOT_FOUND.
+esp_err_t host_httpd_dispatch(httpd_handle_t handle, httpd_req_t * req);
+// La configuracion con la que se llamo a httpd_start
+const httpd_config_t * host_httpd_config(httpd_handle_t handle);
+
+esp_err_t httpd_start(httpd_handle_t * handle, const httpd_config_t * config);
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t * uri_handler);
+
+esp_err_t httpd_trigger_sess_close(httpd_handle_t handle, int sockfd);
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void * arg);
+int httpd_req_to_sockfd(httpd_req_t * req);
+int httpd_send(httpd_req_t * req, const char * buf, size_t len);
+
+size_t httpd_req_get_url_query_len(httpd_req_t * req);
+esp_err_t httpd_req_get_url_query_str(httpd_req_t * req, char * buf, size_t len);
+esp_err_t httpd_query_key_value(const char * query, const char * key, char * val, size_t len);
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t * req, const char * field, char * val, size_t len);
+
+esp_err_t httpd_resp_set_status(httpd_req_t * req, const char * status);
+esp_err_t httpd_resp_set_type(httpd_req_t * req, const char * type);
+esp_err_t httpd_resp_set_hdr(httpd_req_t * req, const char * field, const char * value);
+esp_err_t httpd_resp_send(httpd_req_t * req, const char * buf, ssize_t len);
+esp_err_t httpd_resp_send_chunk(httpd_req_t * req, const char * buf, ssize_t len);
+esp_err_t httpd_resp_send_404(httpd_req_t * req);
+esp_err_t httpd_resp_send_500(httpd_req_t * req);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef HOST_ESP_JPG_DECODE_H
+#define HOST_ESP_JPG_DECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    JPG_SCALE_NONE,
+    JPG_SCALE_2X,
+    JPG_SCALE_4X,
+    JPG_SCALE_8X,
+    JPG_SCALE_MAX = JPG_SCALE_8X
+} jpg_scale_t;
+
+typedef uint32_t (*jpg_reader_cb)(void * arg, size_t index, uint8_t * buf, size_t len);
+typedef bool (*jpg_writer_cb)(void * arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t * data);
+
+// Con libjpeg (HOST_JPEG) decodifica ya reducido, como el IDCT de tjpgd, y entrega bloques RGB888 del
+// tamano de un MCU; antes y despues llama a writer sin datos, igual que en la placa. Sin ella siempre falla
+esp_err_t esp_jpg_decode(size_t len, jpg_scale_t scale, jpg_reader_cb reader, jpg_writer_cb writer, void * arg);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_ESP_VFS_FAT_H
+#define HOST_ESP_VFS_FAT_H
+
+// La tarjeta SD es una carpeta del PC: montar solo la crea
+
+#include "esp_err.h"
+#include "driver/sdmmc_host.h"
+#include "sdmmc_cmd.h"
+#include <sys/types.h>
+#include <unistd.h>
+
+// Las escrituras en la tarjeta pasan por el PC para poder hacerla lenta (host_sd_write_hook de host.h)
+ssize_t host_sd_write(int fd, const void * buf, size_t len);
+#define write(fd, buf, len) host_sd_write(fd, buf, len)
+
+typedef struct {
+        bool format_if_mount_failed;
+        int max_files;
+        size_t allocation_unit_size;
+} esp_vfs_fat_sdmmc_mount_config_t;
+
+esp_err_t esp_vfs_fat_sdmmc_mount(const char * base_path, const sdmmc_host_t * host, const void * slot_config,
+                                  const esp_vfs_fat_sdmmc_mount_config_t * mount_config, sdmmc_card_t ** out_card);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// FreeRTOS de IDF 3.2 sobre hilos POSIX, solo lo que usa el sketch. Un tick es 1 ms.
+// Las secciones criticas son un unico cerrojo recursivo para todo el proceso.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t EventBits_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffUL
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define portNUM_PROCESSORS 2
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+#define IRAM_ATTR
+
+typedef struct {
+        int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void host_critical_enter(portMUX_TYPE * mux);
+void host_critical_exit(portMUX_TYPE * mux);
+#define portENTER_CRITICAL(mux) host_critical_enter(mux)
+#define portEXIT_CRITICAL(mux) host_critical_exit(mux)
+#define portENTER_CRITICAL_ISR(mux) host_critical_enter(mux)
+#define portEXIT_CRITICAL_ISR(mux) host_critical_exit(mux)
+
+#endif
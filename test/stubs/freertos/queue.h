@@ -0,0 +1,20 @@
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef struct host_queue * QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+BaseType_t xQueueSend(QueueHandle_t q, const void * item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t q, void * item, TickType_t ticks);
+BaseType_t xQueuePeek(QueueHandle_t q, void * item, TickType_t ticks);
+// Solo colas de longitud 1, como en FreeRTOS
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void * item);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q);
+
+#define xQueueSendToBack xQueueSend
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_task * TaskHandle_t;
+typedef void (*TaskFunction_t)(void * arg);
+
+typedef enum {
+        eRunning,
+        eReady,
+        eBlocked,
+        eSuspended,
+        eDeleted
+} eTaskState;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char * name, uint32_t stack, void * arg,
+                                   UBaseType_t priority, TaskHandle_t * handle, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char * name, uint32_t stack, void * arg,
+                       UBaseType_t priority, TaskHandle_t * handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t * previous, TickType_t increment);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+// Sin nucleos de verdad: nunca hay tarea en curso ni tarea idle
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t core);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(BaseType_t core);
+eTaskState eTaskGetState(TaskHandle_t task);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef HOST_H
+#define HOST_H
+
+// Lo que las pruebas y los bancos pueden mirar o preparar de los dobles del PC
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "esp_camera.h"
+
+// Ultimo duty escrito con ledcWrite en cada canal, y cuantas escrituras van
+uint32_t host_ledc_duty(int channel);
+uint32_t host_ledc_writes(int channel);
+
+// Frames que van saliendo de esp_camera_fb_get, en bucle, a fps frames por segundo (0 sin esperar).
+// Van en el formato de esp_camera_sensor_get()->pixformat: JPEG o la imagen sin comprimir.
+void host_camera_corpus(const std::vector<std::vector<uint8_t> > & frames, size_t width, size_t height, int fps);
+uint32_t host_camera_frames();
+
+// La PSRAM que ve heap_caps_*, y cuantas veces se ha llamado a heap_caps_malloc
+#define HOST_PSRAM_SIZE (4 * 1024 * 1024)
+uint32_t host_heap_allocs();
+
+// Se llama justo antes de que xEventGroupWaitBits bloquee, para provocar carreras a voluntad
+extern void (*host_event_wait_hook)();
+// Se llama al salir de xQueueReceive con un elemento, desde la tarea que lo ha sacado
+extern void (*host_queue_receive_hook)();
+// Se llama antes de cada write() en la tarjeta SD con su tamano, desde la tarea que escribe: para que
+// tarde lo que tardaria una tarjeta de verdad
+extern void (*host_sd_write_hook)(size_t len);
+
+// Interrupcion del timer hardware, una vez, como si venciera la alarma
+void host_timer_fire(int num);
+
+// Veces que uxTaskGetStackHighWaterMark ha mirado una tarea ya borrada
+uint32_t host_deleted_stack_reads();
+
+// Veces que se ha hecho close() de un socket ya cerrado por httpd_trigger_sess_close
+uint32_t host_httpd_double_closes();
+// Espera a que acaben los cierres pedidos con httpd_trigger_sess_close
+void host_httpd_settle();
+
+#endif
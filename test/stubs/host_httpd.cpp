@@ -0,0 +1,227 @@
+#include "esp_http_server.h"
+#include "host.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Como el servidor de IDF 3.x al borrar una sesion: primero close_fn y luego close() del socket.
+// Si close_fn ya lo ha cerrado, el segundo close() se cuenta: en la placa podria cerrar
+// un socket nuevo que lwip acabara de dar con el mismo numero.
+// httpd_trigger_sess_close no espera, como alli: el cierre lo hace luego la tarea del servidor,
+// asi que se puede pedir con los cerrojos del modulo cogidos.
+
+typedef struct {
+        httpd_close_func_t close_fn;
+        httpd_config_t config;
+        std::vector<httpd_uri_t> handlers;
+} host_server_t;
+
+static std::mutex close_lock;
+static std::condition_variable close_done;
+static std::set<int> closing;
+static std::set<int> closed_in_fn;
+static uint32_t pending = 0;
+static uint32_t double_closes = 0;
+
+httpd_handle_t host_httpd_server(httpd_close_func_t close_fn){
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.close_fn = close_fn;
+    httpd_handle_t handle;
+    httpd_start(&handle, &config);
+    return handle;
+}
+
+esp_err_t httpd_start(httpd_handle_t * handle, const httpd_config_t * config){
+    host_server_t * s = new host_server_t;
+    s->close_fn = config->close_fn;
+    s->config = *config;
+    *handle = s;
+    return ESP_OK;
+}
+
+const httpd_config_t * host_httpd_config(httpd_handle_t handle){
+    return &((host_server_t *)handle)->config;
+}
+
+// Como en IDF: la misma URI y metodo no se registra dos veces y mas de max_uri_handlers no caben
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t * uri_handler){
+    host_server_t * s = (host_server_t *)handle;
+    for(size_t i = 0; i < s->handlers.size(); i++){
+        if(!strcmp(s->handlers[i].uri, uri_handler->uri) && s->handlers[i].method == uri_handler->method){
+            return ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+    if(s->handlers.size() >= s->config.max_uri_handlers){
+        return ESP_ERR_HTTPD_HANDLERS_FULL;
+    }
+    s->handlers.push_back(*uri_handler);
+    return ESP_OK;
+}
+
+esp_err_t host_httpd_dispatch(httpd_handle_t handle, httpd_req_t * req){
+    host_server_t * s = (host_server_t *)handle;
+    for(size_t i = 0; i < s->handlers.size(); i++){
+        if(req->uri == s->handlers[i].uri){
+            req->user_ctx = s->handlers[i].user_ctx;
+            return s->handlers[i].handler(req);
+        }
+    }
+    httpd_resp_send_404(req);
+    return ESP_ERR_NOT_FOUND;
+}
+
+int host_close(int fd){
+    {
+        std::lock_guard<std::mutex> lk(close_lock);
+        if(closing.count(fd)){
+            closed_in_fn.insert(fd);
+        }
+    }
+    return ::close(fd);
+}
+
+uint32_t host_httpd_double_closes(){
+    std::lock_guard<std::mutex> lk(close_lock);
+    return double_closes;
+}
+
+void host_httpd_settle(){
+    std::unique_lock<std::mutex> lk(close_lock);
+    close_done.wait(lk, []{ return pending == 0; });
+}
+
+static void sess_delete(host_server_t * s, int sockfd){
+    {
+        std::lock_guard<std::mutex> lk(close_lock);
+        closing.insert(sockfd);
+    }
+    if(s && s->close_fn){
+        s->close_fn(s, sockfd);
+    }
+    std::lock_guard<std::mutex> lk(close_lock);
+    closing.erase(sockfd);
+    if(closed_in_fn.erase(sockfd)){
+        double_closes++;
+    } else {
+        ::close(sockfd);
+    }
+    pending--;
+    close_done.notify_all();
+}
+
+esp_err_t httpd_trigger_sess_close(httpd_handle_t handle, int sockfd){
+    {
+        std::lock_guard<std::mutex> lk(close_lock);
+        pending++;
+    }
+    std::thread(sess_delete, (host_server_t *)handle, sockfd).detach();
+    return ESP_OK;
+}
+
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void * arg){
+    work(arg);
+    return ESP_OK;
+}
+
+int httpd_req_to_sockfd(httpd_req_t * req){
+    return req->fd;
+}
+
+int httpd_send(httpd_req_t * req, const char * buf, size_t len){
+    return send(req->fd, buf, len, 0);
+}
+
+size_t httpd_req_get_url_query_len(httpd_req_t * req){
+    return req->query.size();
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t * req, char * buf, size_t len){
+    if(req->query.empty() || req->query.size() >= len){
+        return ESP_FAIL;
+    }
+    strcpy(buf, req->query.c_str());
+    return ESP_OK;
+}
+
+esp_err_t httpd_query_key_value(const char * query, const char * key, char * val, size_t len){
+    size_t key_len = strlen(key);
+    const char * p = query;
+    while(p && *p){
+        const char * end = strchr(p, '&');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+        if(n > key_len && !strncmp(p, key, key_len) && p[key_len] == '='){
+            size_t v = n - key_len - 1;
+            if(v >= len){
+                return ESP_FAIL;
+            }
+            memcpy(val, p + key_len + 1, v);
+            val[v] = 0;
+            return ESP_OK;
+        }
+        p = end ? end + 1 : NULL;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t * req, const char * field, char * val, size_t len){
+    for(std::map<std::string, std::string>::const_iterator h = req->req_headers.begin(); h != req->req_headers.end(); ++h){
+        if(!strcasecmp(field, h->first.c_str())){
+            if(h->second.size() >= len){
+                return ESP_FAIL;
+            }
+            strcpy(val, h->second.c_str());
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t * req, const char * status){
+    req->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t * req, const char * type){
+    req->type = type;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t * req, const char * field, const char * value){
+    req->headers += std::string(field) + ": " + value + "\r\n";
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t * req, const char * buf, ssize_t len){
+    if(req->status.empty()){
+        req->status = "200 OK";
+    }
+    if(buf){
+        req->body.assign(buf, len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t * req, const char * buf, ssize_t len){
+    if(req->status.empty()){
+        req->status = "200 OK";
+    }
+    req->chunked = true;
+    if(buf){
+        req->body.append(buf, len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)len);
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_404(httpd_req_t * req){
+    req->status = "404 Not Found";
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_500(httpd_req_t * req){
+    req->status = "500 Internal Server Error";
+    return ESP_OK;
+}
@@ -0,0 +1,98 @@
+#include "mbedtls/sha1.h"
+#include "mbedtls/base64.h"
+#include <stdint.h>
+#include <string.h>
+
+// SHA-1 y base64 para el upgrade de WebSocket en el PC. Solo lo que pide el RFC 6455, sin mas:
+// lo comprueba test_ws_control con el ejemplo del propio RFC.
+
+static uint32_t rol(uint32_t x, int n){
+    return (x << n) | (x >> (32 - n));
+}
+
+static void sha1_block(uint32_t h[5], const unsigned char * p){
+    uint32_t w[80];
+    for(int i = 0; i < 16; i++){
+        w[i] = (uint32_t)p[i * 4] << 24 | (uint32_t)p[i * 4 + 1] << 16 | (uint32_t)p[i * 4 + 2] << 8 | p[i * 4 + 3];
+    }
+    for(int i = 16; i < 80; i++){
+        w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for(int i = 0; i < 80; i++){
+        uint32_t f, k;
+        if(i < 20){
+            f = (b & c) | (~b & d);
+            k = 0x5a827999;
+        } else if(i < 40){
+            f = b ^ c ^ d;
+            k = 0x6ed9eba1;
+        } else if(i < 60){
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8f1bbcdc;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xca62c1d6;
+        }
+        uint32_t t = rol(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rol(b, 30);
+        b = a;
+        a = t;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+}
+
+int mbedtls_sha1_ret(const unsigned char * input, size_t ilen, unsigned char output[20]){
+    uint32_t h[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    size_t i = 0;
+    for(; i + 64 <= ilen; i += 64){
+        sha1_block(h, input + i);
+    }
+    // Cola con el 0x80 y la longitud en bits, en uno o dos bloques
+    unsigned char tail[128];
+    size_t rest = ilen - i;
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, input + i, rest);
+    tail[rest] = 0x80;
+    size_t blocks = rest + 9 > 64 ? 2 : 1;
+    uint64_t bits = (uint64_t)ilen * 8;
+    for(int b = 0; b < 8; b++){
+        tail[blocks * 64 - 1 - b] = bits >> (b * 8);
+    }
+    for(size_t b = 0; b < blocks; b++){
+        sha1_block(h, tail + b * 64);
+    }
+    for(int j = 0; j < 5; j++){
+        output[j * 4] = h[j] >> 24;
+        output[j * 4 + 1] = h[j] >> 16;
+        output[j * 4 + 2] = h[j] >> 8;
+        output[j * 4 + 3] = h[j];
+    }
+    return 0;
+}
+
+int mbedtls_base64_encode(unsigned char * dst, size_t dlen, size_t * olen, const unsigned char * src, size_t slen){
+    static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t need = (slen + 2) / 3 * 4;
+    if(dlen < need + 1){
+        *olen = need + 1;
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+    unsigned char * p = dst;
+    for(size_t i = 0; i < slen; i += 3){
+        uint32_t v = (uint32_t)src[i] << 16 | (i + 1 < slen ? src[i + 1] << 8 : 0) | (i + 2 < slen ? src[i + 2] : 0);
+        *p++ = digits[(v >> 18) & 63];
+        *p++ = digits[(v >> 12) & 63];
+        *p++ = i + 1 < slen ? digits[(v >> 6) & 63] : '=';
+        *p++ = i + 2 < slen ? digits[v & 63] : '=';
+    }
+    *p = 0;
+    *olen = need;
+    return 0;
+}
@@ -0,0 +1,341 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "host.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Cada tarea es un hilo. Lo que en FreeRTOS es esperar con un plazo en ticks aqui es una
+// condition_variable con el mismo plazo en ms; portMAX_DELAY espera sin limite.
+
+struct host_task {
+        TaskFunction_t fn;
+        void * arg;
+        const char * name;
+        std::mutex lock;
+        std::condition_variable cv;
+        uint32_t notify;
+        bool deleted;
+};
+
+struct host_queue {
+        std::mutex lock;
+        std::condition_variable cv;
+        std::deque<std::vector<uint8_t> > items;
+        size_t length;
+        size_t item_size;
+};
+
+// Como en FreeRTOS, xEventGroupSetBits desbloquea en el momento a quien espera esos bits,
+// aunque alguien los borre justo despues; por eso cada espera se apunta en la lista
+struct host_event_wait {
+        EventBits_t bits;
+        bool all;
+        bool done;
+        EventBits_t value;
+};
+
+struct host_event_group {
+        std::mutex lock;
+        std::condition_variable cv;
+        EventBits_t bits;
+        std::vector<host_event_wait *> waits;
+};
+
+void (*host_event_wait_hook)() = NULL;
+void (*host_queue_receive_hook)() = NULL;
+
+static std::recursive_mutex critical;
+static thread_local host_task * current = NULL;
+
+void host_critical_enter(portMUX_TYPE * mux){
+    critical.lock();
+}
+
+void host_critical_exit(portMUX_TYPE * mux){
+    critical.unlock();
+}
+
+// Espera en cv hasta que ready() o pasen ticks; false si se acaba el plazo
+template<typename Lock, typename Ready>
+static bool wait_ticks(std::condition_variable & cv, Lock & lk, TickType_t ticks, Ready ready){
+    if(ticks == portMAX_DELAY){
+        cv.wait(lk, ready);
+        return true;
+    }
+    return cv.wait_for(lk, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+}
+
+static void * task_main(void * arg){
+    host_task * t = (host_task *)arg;
+    current = t;
+    t->fn(t->arg);
+    // Como en FreeRTOS, una tarea no puede volver de su funcion; si lo hace se da por borrada
+    t->deleted = true;
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char * name, uint32_t stack, void * arg,
+                                   UBaseType_t priority, TaskHandle_t * handle, BaseType_t core){
+    host_task * t = new host_task();
+    t->fn = fn;
+    t->arg = arg;
+    t->name = name;
+    t->notify = 0;
+    t->deleted = false;
+    if(handle){
+        *handle = t;
+    }
+    pthread_t thread;
+    if(pthread_create(&thread, NULL, task_main, t)){
+        delete t;
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char * name, uint32_t stack, void * arg,
+                       UBaseType_t priority, TaskHandle_t * handle){
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, priority, handle, tskNO_AFFINITY);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(){
+    if(!current){
+        // El hilo principal de la prueba tambien puede esperar notificaciones
+        current = new host_task();
+        current->fn = NULL;
+        current->arg = NULL;
+        current->name = "main";
+        current->notify = 0;
+        current->deleted = false;
+    }
+    return current;
+}
+
+void vTaskDelete(TaskHandle_t task){
+    host_task * t = task ? task : xTaskGetCurrentTaskHandle();
+    t->deleted = true;
+    if(t == current){
+        pthread_exit(NULL);
+    }
+}
+
+eTaskState eTaskGetState(TaskHandle_t task){
+    return task->deleted ? eDeleted : eBlocked;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandleForCPU(BaseType_t core){
+    return NULL;
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(BaseType_t core){
+    return NULL;
+}
+
+static volatile uint32_t deleted_stack_reads = 0;
+
+uint32_t host_deleted_stack_reads(){
+    return deleted_stack_reads;
+}
+
+// En la placa la TCB de una tarea borrada la libera la tarea idle: leerla despues es basura o un cuelgue
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task){
+    if(task->deleted){
+        deleted_stack_reads++;
+    }
+    return 1024;
+}
+
+void vTaskDelay(TickType_t ticks){
+    usleep((useconds_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+TickType_t xTaskGetTickCount(){
+    return (TickType_t)(esp_timer_get_time() / 1000 / portTICK_PERIOD_MS);
+}
+
+void vTaskDelayUntil(TickType_t * previous, TickType_t increment){
+    *previous += increment;
+    int32_t left = (int32_t)(*previous - xTaskGetTickCount());
+    if(left > 0){
+        vTaskDelay(left);
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks){
+    host_task * t = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lk(t->lock);
+    if(!wait_ticks(t->cv, lk, ticks, [t]{ return t->notify > 0; })){
+        return 0;
+    }
+    uint32_t value = t->notify;
+    t->notify = clear ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task){
+    {
+        std::lock_guard<std::mutex> lk(task->lock);
+        task->notify++;
+    }
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size){
+    host_queue * q = new host_queue();
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void * item, TickType_t ticks){
+    {
+        std::unique_lock<std::mutex> lk(q->lock);
+        if(!wait_ticks(q->cv, lk, ticks, [q]{ return q->items.size() < q->length; })){
+            return pdFALSE;
+        }
+        const uint8_t * p = (const uint8_t *)item;
+        q->items.push_back(std::vector<uint8_t>(p, p + q->item_size));
+    }
+    q->cv.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void * item, TickType_t ticks){
+    {
+        std::unique_lock<std::mutex> lk(q->lock);
+        if(!wait_ticks(q->cv, lk, ticks, [q]{ return !q->items.empty(); })){
+            return pdFALSE;
+        }
+        if(q->item_size){
+            memcpy(item, q->items.front().data(), q->item_size);
+        }
+        q->items.pop_front();
+    }
+    q->cv.notify_all();
+    if(host_queue_receive_hook){
+        host_queue_receive_hook();
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void * item, TickType_t ticks){
+    std::unique_lock<std::mutex> lk(q->lock);
+    if(!wait_ticks(q->cv, lk, ticks, [q]{ return !q->items.empty(); })){
+        return pdFALSE;
+    }
+    if(q->item_size){
+        memcpy(item, q->items.front().data(), q->item_size);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void * item){
+    {
+        std::lock_guard<std::mutex> lk(q->lock);
+        const uint8_t * p = (const uint8_t *)item;
+        q->items.clear();
+        q->items.push_back(std::vector<uint8_t>(p, p + q->item_size));
+    }
+    q->cv.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q){
+    std::lock_guard<std::mutex> lk(q->lock);
+    return q->items.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q){
+    std::lock_guard<std::mutex> lk(q->lock);
+    return q->length - q->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(){
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(){
+    SemaphoreHandle_t s = xSemaphoreCreateBinary();
+    xSemaphoreGive(s);
+    return s;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks){
+    return xQueueReceive(s, NULL, ticks);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s){
+    return xQueueSend(s, NULL, 0);
+}
+
+EventGroupHandle_t xEventGroupCreate(){
+    host_event_group * g = new host_event_group();
+    g->bits = 0;
+    return g;
+}
+
+static bool event_match(EventBits_t have, EventBits_t bits, bool all){
+    return all ? (have & bits) == bits : (have & bits) != 0;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits){
+    EventBits_t now;
+    {
+        std::lock_guard<std::mutex> lk(g->lock);
+        g->bits |= bits;
+        now = g->bits;
+        for(size_t i = 0; i < g->waits.size(); i++){
+            host_event_wait * w = g->waits[i];
+            if(!w->done && event_match(now, w->bits, w->all)){
+                w->done = true;
+                w->value = now;
+            }
+        }
+    }
+    g->cv.notify_all();
+    return now;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits){
+    std::lock_guard<std::mutex> lk(g->lock);
+    EventBits_t before = g->bits;
+    g->bits &= ~bits;
+    return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g){
+    std::lock_guard<std::mutex> lk(g->lock);
+    return g->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks){
+    if(host_event_wait_hook){
+        host_event_wait_hook();
+    }
+    std::unique_lock<std::mutex> lk(g->lock);
+    host_event_wait w = {bits, all != pdFALSE, event_match(g->bits, bits, all), g->bits};
+    if(!w.done){
+        g->waits.push_back(&w);
+        wait_ticks(g->cv, lk, ticks, [&w]{ return w.done; });
+        g->waits.erase(std::find(g->waits.begin(), g->waits.end(), &w));
+    }
+    if(!w.done){
+        return g->bits;
+    }
+    if(clear){
+        g->bits &= ~bits;
+    }
+    return w.value;
+}
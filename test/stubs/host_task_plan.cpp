@@ -0,0 +1,46 @@
+#include "task_plan.h"
+
+// task_plan sin el timer de muestreo ni los nucleos: cada tarea del plan es un hilo mas.
+// Para las pruebas que no miran el reparto; task_plan.cpp tiene la suya.
+
+static TaskHandle_t handles[TASK_PLAN_COUNT];
+
+bool task_plan_create(task_id_t id, TaskFunction_t fn, void * arg, TaskHandle_t * handle){
+    if(xTaskCreatePinnedToCore(fn, "task", 4096, arg, 1, handle, 0) != pdPASS){
+        return false;
+    }
+    handles[id] = *handle;
+    return true;
+}
+
+void task_plan_httpd(task_id_t id, httpd_config_t * config){
+}
+
+void task_plan_httpd_started(task_id_t id, httpd_handle_t server){
+}
+
+void task_plan_register(task_id_t id, TaskHandle_t handle){
+    handles[id] = handle;
+}
+
+void task_plan_exit(task_id_t id){
+    handles[id] = NULL;
+    vTaskDelete(NULL);
+}
+
+void task_plan_start(){
+}
+
+void task_plan_sample(){
+}
+
+void task_plan_stats(task_id_t id, task_stats_t * out){
+    memset(out, 0, sizeof(*out));
+    out->name = "task";
+    out->core = -1;
+    out->running = handles[id] != NULL;
+}
+
+void task_plan_idle(uint16_t * core0, uint16_t * core1){
+    *core0 = *core1 = 0;
+}
@@ -0,0 +1,18 @@
+#ifndef HOST_IMG_CONVERTERS_H
+#define HOST_IMG_CONVERTERS_H
+
+#include "esp_camera.h"
+
+typedef size_t (*jpg_out_cb)(void * arg, size_t index, const void * data, size_t len);
+
+// Con libjpeg (HOST_JPEG) codifica de verdad gris, RGB565 y RGB888, a trozos al callback como en la placa;
+// sin ella siempre falla
+bool frame2jpg_cb(camera_fb_t * fb, uint8_t quality, jpg_out_cb cb, void * arg);
+
+// El camino de siempre: imagen entera en RGB888 y de vuelta a JPEG en un buffer nuevo (con malloc,
+// lo libera quien llama). Lo usa bench_preview para comparar con la vista previa en gris
+bool fmt2rgb888(const uint8_t * src_buf, size_t src_len, pixformat_t format, uint8_t * rgb_buf);
+bool fmt2jpg(uint8_t * src, size_t src_len, uint16_t width, uint16_t height, pixformat_t format, uint8_t quality,
+             uint8_t ** out, size_t * out_len);
+
+#endif
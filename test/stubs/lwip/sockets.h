@@ -0,0 +1,19 @@
+#ifndef HOST_LWIP_SOCKETS_H
+#define HOST_LWIP_SOCKETS_H
+
+// En el PC los sockets de lwip son los del sistema
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+// lwip tambien cambia close() por la suya; aqui pasa por el PC para ver quien cierra cada socket
+int host_close(int fd);
+#define close(fd) host_close(fd)
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef HOST_MBEDTLS_SHA1_H
+#define HOST_MBEDTLS_SHA1_H
+
+// Lo de mbedtls que usa el upgrade de ws_control, con la misma firma que en IDF 3.x
+#include <stddef.h>
+
+int mbedtls_sha1_ret(const unsigned char * input, size_t ilen, unsigned char output[20]);
+
+#endif
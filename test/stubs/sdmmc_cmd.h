@@ -0,0 +1,8 @@
+#ifndef HOST_SDMMC_CMD_H
+#define HOST_SDMMC_CMD_H
+
+typedef struct {
+        int unused;
+} sdmmc_card_t;
+
+#endif
@@ -0,0 +1,66 @@
+#include "actuators.h"
+#include "failsafe.h"
+#include "device_state.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "check.h"
+#include <unistd.h>
+
+// La tarea de actuadores de verdad en su hilo. Con el latido de la pagina y ningun comando de motores
+// el failsafe no salta; sin latido salta una vez y frena dentro de FAILSAFE_REACTION_MS.
+
+#define BEAT_MS 100
+
+static int32_t state_get(state_field_t field){
+    int32_t values[STATE_FIELDS];
+    state_snapshot(values);
+    return values[field];
+}
+
+int main(){
+    actuators_start();
+    actuators_set_failsafe(FAILSAFE_TIMEOUT_MS);
+    // En el PC el reloj empieza en 0 y un latido en el ms 0 no se distingue de ninguno
+    vTaskDelay(50);
+
+    // Un pulso sin fin (noStop) arma el failsafe y deja la tarea sin tick, esperando solo al plazo;
+    // despues solo latidos, como la pagina sin tocar nada
+    actuators_heartbeat();
+    motor_cmd_t hold = {{200, 0, 200, 0}, 0, MOTOR_EXPIRY_HOLD};
+    CHECK(motor_enqueue(&hold));
+    int64_t end = esp_timer_get_time() + 1500000;
+    while(esp_timer_get_time() < end){
+        vTaskDelay(BEAT_MS);
+        actuators_heartbeat();
+    }
+    uint32_t trips, worst, bound;
+    actuators_failsafe_stats(&trips, &worst, &bound);
+    CHECK_EQ(trips, 0);
+    CHECK_EQ(state_get(STATE_FAILSAFE), 0);
+    CHECK_EQ(host_ledc_duty(MOTOR_FIRST_CHANNEL), 200);
+
+    // Se cae la Wi-Fi
+    int64_t last = esp_timer_get_time();
+    vTaskDelay(FAILSAFE_REACTION_MS(FAILSAFE_TIMEOUT_MS, CONTROL_TICK_MS) + 100);
+    actuators_failsafe_stats(&trips, &worst, &bound);
+    CHECK_EQ(trips, 1);
+    CHECK_EQ(state_get(STATE_FAILSAFE), 1);
+    CHECK(worst >= FAILSAFE_TIMEOUT_MS);
+    CHECK(worst <= bound + 5);
+    CHECK(esp_timer_get_time() - last >= (int64_t)worst * 1000);
+    for(int i = 0; i < MOTOR_CHANNELS; i++){
+        CHECK_EQ(host_ledc_duty(MOTOR_FIRST_CHANNEL + i), 0);
+    }
+
+    // El siguiente latido lo rearma y quita el aviso
+    actuators_heartbeat();
+    motor_drive(0, 0, 255);
+    vTaskDelay(50);
+    CHECK_EQ(state_get(STATE_FAILSAFE), 0);
+
+    int res = check_done("test_actuators");
+    // La tarea de actuadores sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,164 @@
+#include "esp_http_server.h"
+#include "camera_pipeline.h"
+#include "mjpeg_stream.h"
+#include "actuators.h"
+#include "device_state.h"
+#include "Arduino.h"
+#include "static_assets.h"
+#include "camera_index.h"
+#include "host.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+// Los handlers de app_httpd.cpp tal cual los registra startCameraServer, con los modulos de verdad:
+// que todas las rutas caben en max_uri_handlers, la pagina con su ETag y el 304, /control y /status
+// con ?since, la foto desde el anillo y el 503 de /stream cuando ya no quedan sitios.
+
+extern httpd_handle_t camera_httpd;
+extern httpd_handle_t stream_httpd;
+void startCameraServer();
+
+typedef struct {
+        esp_err_t res;
+        int code;
+        std::string type;
+        std::string headers;
+        std::string body;
+} reply_t;
+
+static reply_t get(httpd_handle_t server, const char * uri, const char * query, const char * if_none_match, int fd){
+    httpd_req_t req;
+    req.fd = fd;
+    req.uri = uri;
+    req.query = query ? query : "";
+    if(if_none_match){
+        req.req_headers["If-None-Match"] = if_none_match;
+    }
+    req.chunked = false;
+    reply_t r;
+    r.res = host_httpd_dispatch(server, &req);
+    r.code = atoi(req.status.c_str());
+    r.type = req.type;
+    r.headers = req.headers;
+    r.body = req.body;
+    return r;
+}
+
+static reply_t get(const char * uri, const char * query = NULL, const char * if_none_match = NULL){
+    return get(camera_httpd, uri, query, if_none_match, -1);
+}
+
+static bool has(const std::string & s, const char * what){
+    return s.find(what) != std::string::npos;
+}
+
+int main(){
+    std::vector<std::vector<uint8_t> > frames(1, std::vector<uint8_t>(3000));
+    for(size_t i = 0; i < frames[0].size(); i++){
+        frames[0][i] = i * 13;
+    }
+    host_camera_corpus(frames, 320, 240, 20);
+    camera_pipeline_start();
+    actuators_start();
+    startCameraServer();
+    CHECK(camera_httpd != NULL && stream_httpd != NULL);
+    if(!camera_httpd || !stream_httpd){
+        return check_done("test_app_httpd");
+    }
+
+    // Todas las rutas registradas: sin handler el stub contesta ESP_ERR_NOT_FOUND, no el handler
+    static const char * const routes[] = {"/control", "/status", "/capture", "/perf", "/metrics", "/latency",
+                                          "/recording", "/clips"};
+    for(size_t i = 0; i < sizeof(routes) / sizeof(routes[0]); i++){
+        reply_t r = get(routes[i], "x=1");
+        if(r.res == ESP_ERR_NOT_FOUND){
+            printf("sin handler: %s\n", routes[i]);
+        }
+        CHECK(r.res != ESP_ERR_NOT_FOUND);
+    }
+    CHECK_EQ(get("/nada").res, ESP_ERR_NOT_FOUND);
+    CHECK_EQ(get("/nada").code, 404);
+    CHECK(host_httpd_config(stream_httpd)->max_open_sockets == MJPEG_MAX_CLIENTS + 1);
+    CHECK(host_httpd_config(stream_httpd)->server_port == host_httpd_config(camera_httpd)->server_port + 1);
+
+    // Pagina y assets: comprimidos, con ETag; con el mismo ETag 304 sin cuerpo
+    for(int i = 0; i < STATIC_ASSET_COUNT; i++){
+        const static_asset_t * a = &static_assets[i];
+        reply_t r = get(a->path);
+        CHECK_EQ(r.code, 200);
+        CHECK(r.type == a->mime);
+        CHECK(r.body == std::string((const char *)a->gz, a->len));
+        CHECK(has(r.headers, "Content-Encoding: gzip"));
+        CHECK(has(r.headers, (std::string("ETag: ") + a->etag).c_str()));
+        CHECK(has(r.headers, a->immutable ? "immutable" : "no-cache"));
+        r = get(a->path, NULL, a->etag);
+        CHECK_EQ(r.code, 304);
+        CHECK(r.body.empty());
+        CHECK_EQ(get(a->path, NULL, "\"0000000000000000\"").code, 200);
+    }
+
+    // /control: lo que entiende se aplica y se ve en /status; sin query o sin nada conocido, 404
+    CHECK_EQ(get("/control", "var=speed&val=200").code, 200);
+    CHECK_EQ(get("/control", "speed=150&flash=9").code, 200);
+    CHECK_EQ(get("/control").code, 404);
+    CHECK_EQ(get("/control", "nada=1").code, 404);
+    reply_t status = get("/status");
+    CHECK_EQ(status.code, 200);
+    CHECK(status.type == "application/json");
+    CHECK(has(status.body, "\"speed\":150"));
+    CHECK(has(status.body, "\"flash\":9"));
+
+    // ?since con la version actual: solo la version; con una vieja, el estado entero
+    char since[24];
+    snprintf(since, sizeof(since), "since=%u", state_version());
+    reply_t same = get("/status", since);
+    CHECK(has(same.body, "\"unchanged\":true"));
+    CHECK(!has(same.body, "speed"));
+    CHECK_EQ(get("/control", "speed=120").code, 200);
+    reply_t changed = get("/status", since);
+    CHECK(!has(changed.body, "unchanged"));
+    CHECK(has(changed.body, "\"speed\":120"));
+
+    // La foto es el frame del anillo, sin tocar
+    reply_t capture = get("/capture", "fresh=1");
+    CHECK_EQ(capture.code, 200);
+    CHECK(capture.type == "image/jpeg");
+    CHECK(capture.body == std::string(frames[0].begin(), frames[0].end()));
+    CHECK(has(capture.headers, "X-Timestamp: "));
+
+    CHECK_EQ(get("/latency").code, 404);
+    CHECK_EQ(get("/latency", "ts=99999999999999").code, 500);
+    CHECK_EQ(get("/recording", "action=nada").code, 400);
+    reply_t perf = get("/perf");
+    CHECK(has(perf.body, "\"control_requests\":"));
+    CHECK(has(perf.body, "\"index_not_modified\":4"));
+    reply_t metrics = get("/metrics");
+    CHECK_EQ(metrics.code, 200);
+    CHECK(has(metrics.body, "esp32cam_status_requests_total"));
+
+    // /stream en el otro servidor: escala que no existe, 400; MJPEG_MAX_CLIENTS clientes y el siguiente 503
+    CHECK_EQ(get(stream_httpd, "/stream", "preview=gray&scale=3", NULL, -1).code, 400);
+    int sv[MJPEG_MAX_CLIENTS + 1][2];
+    for(int i = 0; i <= MJPEG_MAX_CLIENTS; i++){
+        CHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv[i]), 0);
+        reply_t r = get(stream_httpd, "/stream", NULL, NULL, sv[i][0]);
+        if(i < MJPEG_MAX_CLIENTS){
+            CHECK_EQ(r.res, ESP_OK);
+            CHECK(r.code == 0);
+            char head[64];
+            ssize_t n = read(sv[i][1], head, sizeof(head) - 1);
+            head[n > 0 ? n : 0] = 0;
+            CHECK(has(head, "HTTP/1.1 200 OK"));
+        } else {
+            CHECK_EQ(r.code, 503);
+        }
+    }
+
+    int res = check_done("test_app_httpd");
+    fflush(stdout);
+    // Las tareas de captura y de envio siguen en sus hilos
+    _exit(res);
+}
@@ -0,0 +1,168 @@
+#include "avi.h"
+#include "check.h"
+#include <string.h>
+#include <vector>
+
+// Un AVI entero en memoria, como lo arma recorder.cpp, leido de vuelta trozo a trozo:
+// tamanos de cada lista, campos de avih/strh/strf en su sitio, 'movi' en AVI_MOVI_OFFSET,
+// frames desde AVI_HEADER_SIZE y entradas de idx1 que apuntan a la cabecera de cada frame.
+
+static uint32_t get32(const uint8_t * p){
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t get16(const uint8_t * p){
+    return p[0] | p[1] << 8;
+}
+
+static bool is4cc(const uint8_t * p, const char * cc){
+    return !memcmp(p, cc, 4);
+}
+
+// Arma el archivo con frames de los tamanos dados; sin indexed queda como uno sin cerrar
+static std::vector<uint8_t> build(const std::vector<size_t> & lens, bool indexed, avi_info_t * info){
+    std::vector<uint8_t> file(AVI_HEADER_SIZE);
+    std::vector<uint8_t> index;
+    info->max_chunk = 0;
+    info->movi_bytes = 0;
+    for(size_t i = 0; i < lens.size(); i++){
+        uint32_t pos = file.size();
+        uint8_t head[AVI_CHUNK_HEADER];
+        avi_chunk_header(head, lens[i]);
+        file.insert(file.end(), head, head + AVI_CHUNK_HEADER);
+        // JPEG de mentira: SOI, relleno con el numero de frame y EOI
+        std::vector<uint8_t> jpg(lens[i], (uint8_t)i);
+        jpg[0] = 0xff;
+        jpg[1] = 0xd8;
+        jpg[lens[i] - 2] = 0xff;
+        jpg[lens[i] - 1] = 0xd9;
+        file.insert(file.end(), jpg.begin(), jpg.end());
+        file.resize(pos + avi_chunk_size(lens[i]), 0);
+        uint8_t entry[AVI_INDEX_ENTRY];
+        avi_index_entry(entry, pos, lens[i]);
+        index.insert(index.end(), entry, entry + AVI_INDEX_ENTRY);
+        info->movi_bytes += avi_chunk_size(lens[i]);
+        info->max_chunk = lens[i] > info->max_chunk ? lens[i] : info->max_chunk;
+    }
+    info->frames = lens.size();
+    info->indexed = indexed;
+    if(indexed){
+        uint8_t head[8];
+        avi_index_header(head, lens.size());
+        file.insert(file.end(), head, head + 8);
+        file.insert(file.end(), index.begin(), index.end());
+    }
+    avi_header(file.data(), info);
+    return file;
+}
+
+int main(){
+    avi_info_t info = {640, 480, 0, 100000, 0, 0, false};
+    std::vector<size_t> lens = {1000, 1501, 4, 777, 4096};
+    std::vector<uint8_t> f = build(lens, true, &info);
+    const uint8_t * p = f.data();
+
+    // RIFF cubre todo el archivo
+    CHECK(is4cc(p, "RIFF"));
+    CHECK_EQ(get32(p + 4), f.size() - 8);
+    CHECK(is4cc(p + 8, "AVI "));
+
+    // hdrl con avih y strl dentro, cada uno con su tamano
+    CHECK(is4cc(p + 12, "LIST"));
+    uint32_t hdrl_end = 20 + get32(p + 16);
+    CHECK(is4cc(p + 20, "hdrl"));
+    CHECK(is4cc(p + 24, "avih"));
+    CHECK_EQ(get32(p + 28), 56);
+    const uint8_t * avih = p + 32;
+    CHECK_EQ(get32(avih), 100000);                  // dwMicroSecPerFrame
+    CHECK_EQ(get32(avih + 4), 4096 * 10);           // dwMaxBytesPerSec
+    CHECK_EQ(get32(avih + 12), 0x10);               // AVIF_HASINDEX
+    CHECK_EQ(get32(avih + 16), lens.size());        // dwTotalFrames
+    CHECK_EQ(get32(avih + 24), 1);                  // dwStreams
+    CHECK_EQ(get32(avih + 28), 4096);               // dwSuggestedBufferSize
+    CHECK_EQ(get32(avih + 32), 640);
+    CHECK_EQ(get32(avih + 36), 480);
+
+    const uint8_t * strl = avih + 56;
+    CHECK(is4cc(strl, "LIST"));
+    CHECK_EQ(strl + 8 + get32(strl + 4) - p, hdrl_end);
+    CHECK(is4cc(strl + 8, "strl"));
+    CHECK(is4cc(strl + 12, "strh"));
+    CHECK_EQ(get32(strl + 16), 56);
+    const uint8_t * strh = strl + 20;
+    CHECK(is4cc(strh, "vids"));
+    CHECK(is4cc(strh + 4, "MJPG"));
+    CHECK_EQ(get32(strh + 20), 100000);             // dwScale
+    CHECK_EQ(get32(strh + 24), 1000000);            // dwRate: 10 fps
+    CHECK_EQ(get32(strh + 32), lens.size());        // dwLength
+    CHECK_EQ(get32(strh + 36), 4096);
+    CHECK_EQ(get16(strh + 52), 640);                // rcFrame
+    CHECK_EQ(get16(strh + 54), 480);
+    const uint8_t * strf = strh + 56;
+    CHECK(is4cc(strf, "strf"));
+    CHECK_EQ(get32(strf + 4), 40);
+    CHECK_EQ(get32(strf + 8), 40);                  // biSize
+    CHECK_EQ(get32(strf + 12), 640);
+    CHECK_EQ(get32(strf + 16), 480);
+    CHECK_EQ(get16(strf + 20), 1);
+    CHECK_EQ(get16(strf + 22), 24);
+    CHECK(is4cc(strf + 24, "MJPG"));
+    CHECK_EQ(strf + 8 + 40 - p, hdrl_end);
+
+    // JUNK hasta la lista movi, que abre en el ultimo trozo del sector
+    CHECK(is4cc(p + hdrl_end, "JUNK"));
+    CHECK_EQ(hdrl_end + 8 + get32(p + hdrl_end + 4), AVI_MOVI_OFFSET - 8);
+    CHECK(is4cc(p + AVI_MOVI_OFFSET - 8, "LIST"));
+    CHECK(is4cc(p + AVI_MOVI_OFFSET, "movi"));
+    uint32_t movi_end = AVI_MOVI_OFFSET + get32(p + AVI_MOVI_OFFSET - 4);
+    CHECK_EQ(movi_end, AVI_HEADER_SIZE + info.movi_bytes);
+
+    // Los frames uno detras de otro desde el sector 1, en tamano par
+    uint32_t pos = AVI_HEADER_SIZE;
+    std::vector<uint32_t> starts;
+    for(size_t i = 0; i < lens.size(); i++){
+        CHECK(is4cc(p + pos, "00dc"));
+        CHECK_EQ(get32(p + pos + 4), lens[i]);
+        CHECK(p[pos + 8] == 0xff && p[pos + 9] == 0xd8);
+        CHECK(p[pos + 8 + lens[i] - 2] == 0xff && p[pos + 8 + lens[i] - 1] == 0xd9);
+        starts.push_back(pos);
+        pos += 8 + lens[i] + (lens[i] & 1);
+        CHECK_EQ(pos & 1, 0);
+    }
+    CHECK_EQ(pos, movi_end);
+
+    // idx1: offsets desde 'movi' a la cabecera de cada frame
+    CHECK(is4cc(p + movi_end, "idx1"));
+    CHECK_EQ(get32(p + movi_end + 4), lens.size() * AVI_INDEX_ENTRY);
+    CHECK_EQ(movi_end + 8 + lens.size() * AVI_INDEX_ENTRY, f.size());
+    for(size_t i = 0; i < lens.size(); i++){
+        const uint8_t * e = p + movi_end + 8 + i * AVI_INDEX_ENTRY;
+        CHECK(is4cc(e, "00dc"));
+        CHECK_EQ(get32(e + 4), 0x10);               // AVIIF_KEYFRAME
+        CHECK_EQ(get32(e + 8) + AVI_MOVI_OFFSET, starts[i]);
+        CHECK_EQ(get32(e + 12), lens[i]);
+        CHECK(is4cc(p + AVI_MOVI_OFFSET + get32(e + 8), "00dc"));
+    }
+
+    // Sin cerrar: sin indice ni AVIF_HASINDEX, RIFF y movi cuadran igual
+    f = build(lens, false, &info);
+    p = f.data();
+    CHECK_EQ(get32(p + 4), f.size() - 8);
+    CHECK_EQ(get32(p + 32 + 12), 0);
+    CHECK_EQ(AVI_MOVI_OFFSET + get32(p + AVI_MOVI_OFFSET - 4), f.size());
+
+    // Recien abierto: la cabecera sola es un AVI vacio valido, y sin periodo se supone 10 fps
+    avi_info_t empty = {0, 0, 0, 0, 0, 0, false};
+    uint8_t head[AVI_HEADER_SIZE];
+    memset(head, 0xaa, sizeof(head));
+    avi_header(head, &empty);
+    CHECK_EQ(get32(head + 4), AVI_HEADER_SIZE - 8);
+    CHECK_EQ(get32(head + 32), 100000);
+    CHECK_EQ(get32(head + AVI_MOVI_OFFSET - 4), 4);
+    CHECK(is4cc(head + AVI_MOVI_OFFSET, "movi"));
+
+    CHECK_EQ(avi_chunk_size(1), 10);
+    CHECK_EQ(avi_chunk_size(2), 10);
+
+    return check_done("test_avi");
+}
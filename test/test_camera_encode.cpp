@@ -0,0 +1,129 @@
+#include "camera_pipeline.h"
+#include "esp_heap_caps.h"
+#include "host.h"
+#include "check.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include <jpeglib.h>
+
+// Sensor sin JPEG: la tarea de captura codifica cada frame con frame2jpg_cb directamente en el hueco
+// del anillo. Lo que sale se tiene que poder decodificar con las medidas del sensor; con la resolucion
+// estable los huecos dejan de pedir memoria; y un frame que no cabe en la reserva se pierde una vez
+// y la reserva crece para los siguientes.
+
+void recorder_tee(const frame_t * f){}
+bool motion_stage_due(int64_t timestamp){ return false; }
+void motion_stage_offer(frame_t * f){ frame_release(f); }
+
+#define W 320
+#define H 240
+#define TEST_FPS 100
+
+static bool decodes(const frame_t * f, size_t w, size_t h){
+    if(f->len < 4 || f->buf[0] != 0xff || f->buf[1] != 0xd8 || f->buf[f->len - 2] != 0xff || f->buf[f->len - 1] != 0xd9){
+        return false;
+    }
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, f->buf, f->len);
+    jpeg_read_header(&cinfo, TRUE);
+    bool ok = cinfo.image_width == w && cinfo.image_height == h && f->width == w && f->height == h;
+    jpeg_destroy_decompress(&cinfo);
+    return ok;
+}
+
+// Escena con algo de textura que cambia un poco de un frame a otro
+static std::vector<std::vector<uint8_t> > scene(size_t bpp, int frames){
+    std::vector<std::vector<uint8_t> > out;
+    for(int i = 0; i < frames; i++){
+        std::vector<uint8_t> img(W * H * bpp);
+        for(size_t p = 0; p < img.size(); p++){
+            size_t x = (p / bpp) % W, y = (p / bpp) / W;
+            img[p] = (uint8_t)(x / 2 + y / 3 + ((x + i * 4) / 16 + y / 16) % 2 * 40);
+        }
+        out.push_back(img);
+    }
+    return out;
+}
+
+// n frames seguidos; cuantos se pueden decodificar con esas medidas
+static int consume(int n, size_t w = W, size_t h = H){
+    int good = 0;
+    uint32_t seq = 0;
+    for(int i = 0; i < n; i++){
+        frame_t * f = frame_acquire_latest(seq, 1000);
+        CHECK(f != NULL);
+        if(!f){
+            break;
+        }
+        good += decodes(f, w, h);
+        seq = f->seq;
+        frame_release(f);
+    }
+    return good;
+}
+
+int main(){
+    sensor_t * s = esp_camera_sensor_get();
+    s->pixformat = PIXFORMAT_GRAYSCALE;
+    host_camera_corpus(scene(1, 4), W, H, TEST_FPS);
+    camera_pipeline_start();
+    camera_pipeline_subscribe();
+
+    // Gris: todos los frames son JPEG de verdad con las medidas del sensor
+    CHECK_EQ(consume(3 * FRAME_RING_SIZE), 3 * FRAME_RING_SIZE);
+
+    // Con todos los huecos ya usados no se pide mas memoria, ni en el anillo ni en ningun heap_caps_malloc
+    uint32_t allocs, allocs_after, captured, dropped;
+    size_t bytes;
+    camera_pipeline_buffer_stats(&allocs, &bytes);
+    CHECK(allocs <= FRAME_RING_SIZE);
+    uint32_t heap_before = host_heap_allocs();
+    CHECK_EQ(consume(30), 30);
+    camera_pipeline_buffer_stats(&allocs_after, &bytes);
+    CHECK_EQ(allocs_after, allocs);
+    CHECK_EQ(host_heap_allocs(), heap_before);
+    camera_pipeline_stats(&captured, &dropped);
+    CHECK_EQ(dropped, 0);
+    CHECK(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) <= HOST_PSRAM_SIZE - bytes);
+
+    // RGB565: el mismo camino con dos bytes por pixel
+    camera_pipeline_unsubscribe();
+    usleep(100000);
+    s->pixformat = PIXFORMAT_RGB565;
+    host_camera_corpus(scene(2, 4), W, H, TEST_FPS);
+    camera_pipeline_subscribe();
+    CHECK_EQ(consume(2 * FRAME_RING_SIZE), 2 * FRAME_RING_SIZE);
+
+    // Ruido a 640x480: pasa de los 4 bits por pixel de la reserva y de su margen. Se pierde alguno
+    // y luego caben todos
+    camera_pipeline_unsubscribe();
+    usleep(100000);
+    std::vector<std::vector<uint8_t> > noise(3, std::vector<uint8_t>(4 * W * H * 2));
+    srand(1);
+    for(size_t i = 0; i < noise.size(); i++){
+        for(size_t p = 0; p < noise[i].size(); p++){
+            noise[i][p] = rand();
+        }
+    }
+    host_camera_corpus(noise, 2 * W, 2 * H, TEST_FPS);
+    camera_pipeline_stats(&captured, &dropped);
+    uint32_t dropped_before = dropped;
+    camera_pipeline_subscribe();
+    CHECK_EQ(consume(2 * FRAME_RING_SIZE, 2 * W, 2 * H), 2 * FRAME_RING_SIZE);
+    camera_pipeline_stats(&captured, &dropped);
+    printf("ruido: %u frames perdidos hasta que la reserva crece\n", dropped - dropped_before);
+    CHECK(dropped > dropped_before);
+    CHECK(dropped - dropped_before <= 3);
+    frame_t * f = frame_acquire_latest(0, 1000);
+    CHECK(f && f->len > (4 * W * H / 2 + 4096) * 5 / 4);
+    frame_release(f);
+
+    int res = check_done("test_camera_encode");
+    // La tarea de captura sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
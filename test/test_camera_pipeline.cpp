@@ -0,0 +1,68 @@
+#include "camera_pipeline.h"
+#include "esp_timer.h"
+#include "host.h"
+#include "check.h"
+#include <unistd.h>
+
+// Un frame publicado entre que el lector mira el anillo y se pone a esperar no se puede perder:
+// host_event_wait_hook aguanta al lector justo en esa ventana hasta que sale el siguiente frame.
+
+void recorder_tee(const frame_t * f){}
+bool motion_stage_due(int64_t timestamp){ return false; }
+void motion_stage_offer(frame_t * f){ frame_release(f); }
+
+// Sensor a 10 fps: perder la senal cuesta 100 ms, despertar a tiempo apenas nada
+#define TEST_FPS 10
+#define LATE_US 30000
+
+static uint32_t hook_seq;
+static int64_t hook_done;
+
+static void publish_in_window(){
+    host_event_wait_hook = NULL;
+    while(true){
+        frame_t * f = frame_acquire_latest(hook_seq, 0);
+        if(f){
+            frame_release(f);
+            break;
+        }
+        usleep(500);
+    }
+    hook_done = esp_timer_get_time();
+}
+
+int main(){
+    std::vector<std::vector<uint8_t> > frames(1, std::vector<uint8_t>(2000, 0x55));
+    host_camera_corpus(frames, 320, 240, TEST_FPS);
+    camera_pipeline_start();
+    camera_pipeline_subscribe();
+
+    frame_t * f = frame_acquire_latest(0, 1000);
+    CHECK(f != NULL);
+    for(int i = 0; i < 3 && f; i++){
+        hook_seq = f->seq;
+        host_event_wait_hook = publish_in_window;
+        frame_t * next = frame_acquire_latest(f->seq, 1000);
+        CHECK(next != NULL);
+        CHECK(next && next->seq != f->seq);
+        CHECK(esp_timer_get_time() - hook_done < LATE_US);
+        frame_release(f);
+        f = next;
+    }
+
+    for(int i = 0; i < 3 && f; i++){
+        hook_seq = f->seq;
+        host_event_wait_hook = publish_in_window;
+        frame_t * next = frame_acquire_since(f->timestamp + 1, 1000);
+        CHECK(next != NULL);
+        CHECK(next && next->timestamp > f->timestamp);
+        CHECK(esp_timer_get_time() - hook_done < LATE_US);
+        frame_release(f);
+        f = next;
+    }
+    frame_release(f);
+    int res = check_done("test_camera_pipeline");
+    // La tarea de captura sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,293 @@
+#include "clip_server.h"
+#include "recorder.h"
+#include "host.h"
+#include "esp_timer.h"
+#include "check.h"
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+// Range de /clips: el parser con los casos raros, y descargas enteras por un socketpair con la tarea
+// de envio de verdad. Lo que cae fuera del archivo es 416 con Content-Range: bytes */size;
+// lo que no se entiende se ignora y va el archivo entero. El tope de velocidad se mide con el reloj.
+// La tarjeta es la carpeta sdcard/ dentro de build/, como en test_recorder.
+
+#define CLIP_SIZE 1000
+#define RATE_CLIP_SIZE (128 * 1024)     // 16 trozos de CLIP_CHUNK
+
+static record_status_t record = {RECORD_IDLE, "", 0, 0, 0, 0, 0, RECORD_OK, 0, 0};
+
+bool recorder_mount(){
+    mkdir(RECORD_MOUNT, 0755);
+    mkdir(RECORD_DIR, 0755);
+    return true;
+}
+
+void recorder_status(record_status_t * out){
+    *out = record;
+}
+
+static void write_clip(const char * name, size_t size){
+    char path[64];
+    snprintf(path, sizeof(path), RECORD_DIR "/%s", name);
+    FILE * f = fopen(path, "wb");
+    for(size_t i = 0; i < size; i++){
+        fputc(i & 0xff, f);
+    }
+    fclose(f);
+}
+
+typedef struct {
+        const char * range;
+        uint32_t size;
+        int res;
+        uint32_t start;
+        uint32_t len;
+} range_case_t;
+
+static const range_case_t cases[] = {
+    {"bytes=0-499",       1000,  1,   0,  500},
+    {"bytes=500-",        1000,  1, 500,  500},
+    {"bytes=999-999",     1000,  1, 999,    1},
+    {"bytes=0-0",         1000,  1,   0,    1},
+    {"bytes=-200",        1000,  1, 800,  200},
+    {"bytes=-1000",       1000,  1,   0, 1000},
+    {"bytes=-5000",       1000,  1,   0, 1000},
+    {"bytes=0-5000",      1000,  1,   0, 1000},
+    {"bytes=0-99999999999999999999", 1000, 1, 0, 1000},
+    {"bytes=-99999999999999999999",  1000, 1, 0, 1000},
+    // Fuera del archivo: 416
+    {"bytes=1000-",       1000, -1},
+    {"bytes=1000-1001",   1000, -1},
+    {"bytes=99999999999999999999-", 1000, -1},
+    {"bytes=-0",          1000, -1},
+    {"bytes=0-",             0, -1},
+    {"bytes=-5",             0, -1},
+    // Mal escrito o que no se sirve: se ignora
+    {"bytes=5-3",         1000,  0},
+    {"bytes=0-1,5-6",     1000,  0},
+    {"items=0-1",         1000,  0},
+    {"bytes=",            1000,  0},
+    {"bytes=-",           1000,  0},
+    {"bytes=a-",          1000,  0},
+    {"bytes=1-x",         1000,  0},
+    {"bytes=1",           1000,  0},
+    {"bytes=--5",         1000,  0},
+    {"bytes=5--3",        1000,  0},
+    {"bytes=+5-",         1000,  0},
+    {"bytes= 5-",         1000,  0},
+    {"bytes=5- 9",        1000,  0},
+    {"bytes=-+5",         1000,  0},
+};
+
+typedef struct {
+        int code;               // de la linea de estado, venga por el socket o por httpd_resp_*
+        std::string headers;
+        std::string body;
+        bool closed;            // el servidor cerro la sesion despues de la respuesta
+} response_t;
+
+// Una peticion a /clips. Lo que se manda a mano por el socket va con Connection: close, asi que
+// se lee hasta el cierre: con cuerpo lo cierra la tarea de envio al acabar, sin cuerpo el handler.
+// Si en 5 s no llega el cierre la lectura se corta y closed queda a false.
+static response_t request(const char * query, const char * range){
+    int sv[2];
+    CHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    struct timeval tv = {5, 0};
+    setsockopt(sv[1], SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    httpd_req_t req;
+    req.fd = sv[0];
+    req.uri = "/clips";
+    req.query = query;
+    if(range){
+        req.req_headers["Range"] = range;
+    }
+    req.chunked = false;
+    clip_server_handler(&req);
+
+    response_t r;
+    r.closed = false;
+    if(!req.status.empty()){
+        // Contestado con httpd_resp_*
+        close(sv[0]);
+        close(sv[1]);
+        r.code = atoi(req.status.c_str());
+        r.headers = req.headers;
+        r.body = req.body;
+        return r;
+    }
+    std::string raw;
+    char buf[4096];
+    ssize_t n;
+    size_t head;
+    while((head = raw.find("\r\n\r\n")) == std::string::npos && (n = read(sv[1], buf, sizeof(buf))) > 0){
+        raw.append(buf, n);
+    }
+    size_t line = raw.find("\r\n");
+    if(head == std::string::npos || raw.compare(0, 9, "HTTP/1.1 ")){
+        close(sv[0]);
+        close(sv[1]);
+        r.code = 0;
+        return r;
+    }
+    r.code = atoi(raw.c_str() + 9);
+    r.headers = raw.substr(line + 2, head - line);
+    while((n = read(sv[1], buf, sizeof(buf))) > 0){
+        raw.append(buf, n);
+    }
+    r.closed = n == 0;
+    host_httpd_settle();
+    if(!r.closed){
+        close(sv[0]);
+    }
+    close(sv[1]);
+    r.body = raw.substr(head + 4);
+    return r;
+}
+
+// La tarea suelta la descarga justo despues de cerrar el socket; si aun no lo ha hecho se reintenta,
+// como haria el navegador con el Retry-After
+static response_t get(const char * query, const char * range){
+    response_t r = request(query, range);
+    for(int i = 0; r.code == 503 && i < 1000; i++){
+        usleep(1000);
+        r = request(query, range);
+    }
+    return r;
+}
+
+static bool has(const response_t & r, const char * header){
+    return r.headers.find(header) != std::string::npos;
+}
+
+// Los bytes de [start, start + len) del clip de prueba
+static bool body_is(const response_t & r, uint32_t start, uint32_t len){
+    if(r.body.size() != len){
+        return false;
+    }
+    for(uint32_t i = 0; i < len; i++){
+        if((uint8_t)r.body[i] != ((start + i) & 0xff)){
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(){
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        const range_case_t * c = &cases[i];
+        uint32_t start = 12345, len = 12345;
+        int res = clip_parse_range(c->range, c->size, &start, &len);
+        if(res != c->res){
+            fprintf(stderr, "Range \"%s\" (%u bytes)\n", c->range, c->size);
+        }
+        CHECK_EQ(res, c->res);
+        if(c->res == 1 && res == 1){
+            CHECK_EQ(start, c->start);
+            CHECK_EQ(len, c->len);
+        }
+    }
+
+    recorder_mount();
+    write_clip("a.avi", CLIP_SIZE);
+    write_clip("empty.avi", 0);
+    clip_server_start(host_httpd_server(NULL));
+    clip_server_set_rate(0);
+
+    // Entero y por trozos
+    response_t r = get("file=a.avi", NULL);
+    CHECK_EQ(r.code, 200);
+    CHECK(has(r, "Content-Length: 1000\r\n"));
+    CHECK(has(r, "Accept-Ranges: bytes\r\n"));
+    CHECK(has(r, "Content-Type: video/x-msvideo\r\n"));
+    CHECK(!has(r, "Content-Range"));
+    CHECK(body_is(r, 0, CLIP_SIZE));
+    CHECK(r.closed);
+
+    r = get("file=a.avi", "bytes=100-299");
+    CHECK_EQ(r.code, 206);
+    CHECK(has(r, "Content-Length: 200\r\n"));
+    CHECK(has(r, "Content-Range: bytes 100-299/1000\r\n"));
+    CHECK(body_is(r, 100, 200));
+
+    r = get("file=a.avi", "bytes=-1");
+    CHECK_EQ(r.code, 206);
+    CHECK(has(r, "Content-Range: bytes 999-999/1000\r\n"));
+    CHECK(body_is(r, 999, 1));
+
+    r = get("file=a.avi", "bytes=900-5000");
+    CHECK_EQ(r.code, 206);
+    CHECK(has(r, "Content-Range: bytes 900-999/1000\r\n"));
+    CHECK(body_is(r, 900, 100));
+
+    // Fuera del archivo: 416 con el tamano, sin cuerpo
+    const char * const unsatisfiable[] = {"bytes=1000-", "bytes=1000-2000", "bytes=-0", "bytes=4294967296-"};
+    for(size_t i = 0; i < sizeof(unsatisfiable) / sizeof(unsatisfiable[0]); i++){
+        r = get("file=a.avi", unsatisfiable[i]);
+        CHECK_EQ(r.code, 416);
+        CHECK(has(r, "Content-Range: bytes */1000\r\n"));
+        CHECK(r.body.empty());
+    }
+    // Un archivo vacio no tiene ningun byte que pedir
+    r = get("file=empty.avi", "bytes=0-");
+    CHECK_EQ(r.code, 416);
+    CHECK(has(r, "Content-Range: bytes */0\r\n"));
+    r = get("file=empty.avi", NULL);
+    CHECK_EQ(r.code, 200);
+    CHECK(has(r, "Content-Length: 0\r\n"));
+    CHECK(r.body.empty());
+    CHECK(r.closed);
+
+    // Mal escrito: el archivo entero
+    const char * const ignored[] = {"bytes=5-3", "bytes=0-1,5-6", "bytes=--5", "bytes=x"};
+    for(size_t i = 0; i < sizeof(ignored) / sizeof(ignored[0]); i++){
+        r = get("file=a.avi", ignored[i]);
+        CHECK_EQ(r.code, 200);
+        CHECK(body_is(r, 0, CLIP_SIZE));
+    }
+
+    // Ni rutas ni archivos que no estan, ni el que se esta grabando
+    CHECK_EQ(get("file=..%2Fa.avi", NULL).code, 400);
+    CHECK_EQ(get("file=.hidden", NULL).code, 400);
+    CHECK_EQ(get("file=b.avi", NULL).code, 404);
+    record.state = RECORD_RUNNING;
+    strcpy(record.name, "a.avi");
+    CHECK_EQ(get("file=a.avi", "bytes=0-1").code, 409);
+    record.state = RECORD_IDLE;
+
+    // La lista
+    r = get("", NULL);
+    CHECK_EQ(r.code, 200);
+    CHECK(r.body.find("{\"name\":\"a.avi\",\"bytes\":1000}") != std::string::npos);
+    CHECK(r.body.find("{\"name\":\"empty.avi\",\"bytes\":0}") != std::string::npos);
+
+    uint32_t downloads, bytes;
+    clip_server_stats(&downloads, &bytes);
+    CHECK_EQ(downloads, 8);
+    CHECK_EQ(bytes, 1000 + 200 + 1 + 100 + 4 * 1000);
+
+    // Con tope la descarga va a esa velocidad: ni mas rapido ni mucho mas lento (15% de margen)
+    write_clip("rate.avi", RATE_CLIP_SIZE);
+    const int rates[] = {256, 1024};
+    for(size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++){
+        clip_server_set_rate(rates[i]);
+        int64_t start = esp_timer_get_time();
+        r = get("file=rate.avi", NULL);
+        int64_t elapsed = esp_timer_get_time() - start;
+        CHECK_EQ(r.code, 200);
+        CHECK(body_is(r, 0, RATE_CLIP_SIZE));
+        int kbps = (int)((int64_t)RATE_CLIP_SIZE * 1000000 / 1024 / elapsed);
+        printf("cliprate %d KB/s: %d KB/s\n", rates[i], kbps);
+        CHECK(kbps <= rates[i] * 115 / 100);
+        CHECK(kbps >= rates[i] * 85 / 100);
+    }
+
+    int res = check_done("test_clip_server");
+    // La tarea de envio sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,153 @@
+#include "control.h"
+#include "actuators.h"
+#include "device_state.h"
+#include "host.h"
+#include "check.h"
+#include <string.h>
+#include <unistd.h>
+
+// /control de punta a punta: control_apply_query con el registro y los actuadores de verdad.
+// Lo de fuera del coche apunta lo que le llega para comprobar que el valor se reparte bien.
+
+static int ceiling_quality = -2;
+static int ceiling_framesize = -2;
+static int events_period = 0;
+static int motion_threshold = 0;
+static bool motion_enabled = false;
+static bool motion_available = true;
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){
+    ceiling_quality = quality;
+    ceiling_framesize = framesize;
+}
+void mjpeg_stream_abr_enable(bool enable){}
+void event_stream_set_period(int ms){ events_period = ms; }
+bool motion_stage_enable(bool enable){
+    if(!motion_available){
+        return !enable;
+    }
+    motion_enabled = enable;
+    return true;
+}
+void motion_stage_set_threshold(int threshold){ motion_threshold = threshold; }
+void clip_server_set_rate(int kbps){}
+
+static int32_t state_get(state_field_t field){
+    int32_t values[STATE_FIELDS];
+    state_snapshot(values);
+    return values[field];
+}
+
+// La query se parte en el propio buffer, como en el handler
+static int apply(const char * query, int * applied){
+    char buf[CONTROL_QUERY_MAX];
+    strcpy(buf, query);
+    return control_apply_query(buf, applied);
+}
+
+int main(){
+    actuators_start();
+    int applied;
+
+    // var/val y nombre=valor, varios en una peticion
+    CHECK_EQ(apply("var=speed&val=200", &applied), 0);
+    CHECK_EQ(applied, 1);
+    CHECK_EQ(state_get(STATE_SPEED), 200);
+    CHECK_EQ(apply("speed=100&flash=12", &applied), 0);
+    CHECK_EQ(applied, 2);
+    CHECK_EQ(state_get(STATE_SPEED), 100);
+    CHECK_EQ(state_get(STATE_FLASH), 12);
+    CHECK_EQ(host_ledc_duty(7), 12);
+    CHECK_EQ(apply("servo=400&servopan=520&servo3=610", &applied), 0);
+    CHECK_EQ(applied, 3);
+    CHECK_EQ(state_get(STATE_SERVO), 400);
+    CHECK_EQ(state_get(STATE_SERVOPAN), 520);
+    CHECK_EQ(state_get(STATE_SERVO3), 610);
+    CHECK_EQ(apply("val=50&var=speed", &applied), 0);
+    CHECK_EQ(applied, 1);
+    CHECK_EQ(state_get(STATE_SPEED), 50);
+
+    // Claves desconocidas, sin valor o var sin val: se ignoran
+    CHECK_EQ(apply("foo=1&speed=10&bar", &applied), 0);
+    CHECK_EQ(applied, 1);
+    CHECK_EQ(state_get(STATE_SPEED), 10);
+    CHECK_EQ(apply("var=speed", &applied), 0);
+    CHECK_EQ(applied, 0);
+    CHECK_EQ(apply("", &applied), 0);
+    CHECK_EQ(applied, 0);
+
+    // Basura y desbordamiento: error, no un 0, y el valor anterior se queda
+    const char * const garbage[] = {
+        "speed=", "speed=-", "speed=+", "speed=12a", "speed= 1", "speed=1=2", "speed=0x10",
+        "speed=9999999", "speed=99999999999", "speed=-9999999", "var=speed&val=", "var=speed&val=abc",
+    };
+    for(size_t i = 0; i < sizeof(garbage) / sizeof(garbage[0]); i++){
+        CHECK(apply(garbage[i], &applied) != 0);
+        CHECK_EQ(applied, 1);
+        CHECK_EQ(state_get(STATE_SPEED), 10);
+    }
+    CHECK_EQ(apply("speed=+999999", &applied), 0);
+    CHECK_EQ(state_get(STATE_SPEED), 255);
+
+    // Un comando malo no tapa a los buenos de la misma query
+    CHECK(apply("speed=x&flash=3", &applied) != 0);
+    CHECK_EQ(applied, 2);
+    CHECK_EQ(state_get(STATE_FLASH), 3);
+
+    // Con clamp se recorta al rango, sin clamp es un error
+    CHECK_EQ(apply("speed=999", &applied), 0);
+    CHECK_EQ(state_get(STATE_SPEED), 255);
+    CHECK_EQ(apply("speed=-5", &applied), 0);
+    CHECK_EQ(state_get(STATE_SPEED), 0);
+    CHECK_EQ(apply("servo=100", &applied), 0);
+    CHECK_EQ(state_get(STATE_SERVO), 325);
+    CHECK(apply("car=9", &applied) != 0);
+    CHECK(apply("car=0", &applied) != 0);
+    CHECK_EQ(apply("car=3", &applied), 0);
+    CHECK_EQ(state_get(STATE_ACTSTATE), 2);
+
+    // Joystick: cada entrada mueve su eje y el otro se queda. El estado se apunta aunque la cola
+    // de motores este llena (entonces da error), asi que aqui no se mira lo que devuelve
+    apply("drivex=40", &applied);
+    apply("drivey=-70", &applied);
+    CHECK_EQ(state_get(STATE_DRIVEX), 40);
+    CHECK_EQ(state_get(STATE_DRIVEY), -70);
+    apply("drivex=0", &applied);
+    CHECK_EQ(state_get(STATE_DRIVEX), 0);
+    CHECK_EQ(state_get(STATE_DRIVEY), -70);
+    apply("drivey=0", &applied);
+
+    // Lo que se reparte fuera del coche
+    CHECK_EQ(apply("quality=20", &applied), 0);
+    CHECK_EQ(ceiling_quality, 20);
+    CHECK_EQ(ceiling_framesize, -1);
+    CHECK_EQ(state_get(STATE_QUALITY), 20);
+    CHECK_EQ(apply("framesize=5", &applied), 0);
+    CHECK_EQ(ceiling_quality, -1);
+    CHECK_EQ(ceiling_framesize, 5);
+    CHECK_EQ(state_get(STATE_FRAMESIZE), 5);
+    CHECK_EQ(apply("events=50", &applied), 0);
+    CHECK_EQ(events_period, 100);
+    CHECK_EQ(apply("motionthreshold=40&motion=1", &applied), 0);
+    CHECK_EQ(motion_threshold, 40);
+    CHECK(motion_enabled);
+
+    // Sin PSRAM no se puede encender el centinela, apagarlo si
+    motion_available = false;
+    CHECK(apply("motion=1", &applied) != 0);
+    CHECK_EQ(apply("motion=0", &applied), 0);
+
+    // Failsafe por debajo del minimo: error; 0 lo apaga
+    CHECK(apply("failsafe=100", &applied) != 0);
+    CHECK_EQ(apply("failsafe=0", &applied), 0);
+    CHECK_EQ(apply("failsafe=500", &applied), 0);
+
+    CHECK(control_apply("nada", 1) != 0);
+    CHECK(control_find("nada") == NULL);
+    CHECK(control_find("servospeed") != NULL);
+
+    int res = check_done("test_control");
+    // La tarea de actuadores sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,142 @@
+#include "control.h"
+#include "actuators.h"
+#include "device_state.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// control_apply_query con queries al azar y cortadas por cualquier sitio: nunca lee ni escribe fuera
+// de la query, y si todos los valores son basura no cambia nada del estado.
+// Con ASan (se compila con -fsanitize=address si el compilador lo tiene) cada query va en un bloque
+// de su tamano justo y cualquier acceso fuera salta; sin ASan quedan los bytes de guarda alrededor.
+//   test_control_fuzz [iteraciones] [semilla]
+
+#ifdef __SANITIZE_ADDRESS__
+#define GUARD 0
+#else
+#define GUARD 32
+#endif
+#define GUARD_BYTE 0xa5
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){}
+void mjpeg_stream_abr_enable(bool enable){}
+void event_stream_set_period(int ms){}
+bool motion_stage_enable(bool enable){ return true; }
+void motion_stage_set_threshold(int threshold){}
+void clip_server_set_rate(int kbps){}
+
+// Trozos con los que se arman las queries: claves de la tabla, las de var/val y separadores
+static const char * const pieces[] = {
+    "var", "val", "speed", "flash", "servo", "servopan", "drivex", "drivey", "car", "nostop",
+    "quality", "events", "failsafe", "motion", "nada", "=", "=", "&", "&", "-", "+", "0", "7", "99",
+    "123456", "1234567", "x", " ", "%", "==", "&&",
+};
+#define PIECES (sizeof(pieces) / sizeof(pieces[0]))
+
+// Valores que control_parse_int tiene que rechazar
+static const char * const bad_values[] = {
+    "", "-", "+", "x", "12a", "a12", " 1", "1 ", "1=2", "0x10", "1234567", "-1234567", "++1", "+-1", "1-", "%31",
+};
+#define BAD_VALUES (sizeof(bad_values) / sizeof(bad_values[0]))
+
+static int fails = 0;
+
+// Aplica query[0..len) en un bloque con guardas y comprueba que nada las toca
+static int apply_guarded(const char * query, size_t len, int * applied){
+    uint8_t * block = (uint8_t *)malloc(GUARD + len + 1 + GUARD);
+    memset(block, GUARD_BYTE, GUARD + len + 1 + GUARD);
+    char * buf = (char *)block + GUARD;
+    memcpy(buf, query, len);
+    buf[len] = 0;
+    int res = control_apply_query(buf, applied);
+    uint8_t guard[GUARD + 1];
+    memset(guard, GUARD_BYTE, sizeof(guard));
+    bool intact = !memcmp(block, guard, GUARD) && !memcmp(block + GUARD + len + 1, guard, GUARD);
+    CHECK(intact);
+    // Lo que hay que partir son '=' y '&'; nunca se encuentran mas comandos que claves con valor
+    int values = 0;
+    for(size_t i = 0; i < len; i++){
+        values += query[i] == '=';
+    }
+    CHECK(*applied <= values);
+    if(!intact || *applied > values){
+        if(fails++ < 5){
+            fprintf(stderr, "query: \"%.*s\"\n", (int)len, query);
+        }
+    }
+    free(block);
+    return res;
+}
+
+static void append(char * q, size_t * len, const char * s){
+    size_t n = strlen(s);
+    if(*len + n < CONTROL_QUERY_MAX){
+        memcpy(q + *len, s, n);
+        *len += n;
+    }
+}
+
+int main(int argc, char ** argv){
+    long iterations = argc > 1 ? atol(argv[1]) : 100000;
+    unsigned seed = argc > 2 ? atoi(argv[2]) : 1;
+    srand(seed);
+    actuators_start();
+    char q[CONTROL_QUERY_MAX];
+    int applied;
+
+    for(long it = 0; it < iterations; it++){
+        // Trozos al azar, y a veces bytes cualesquiera
+        size_t len = 0;
+        int n = rand() % 24;
+        for(int i = 0; i < n; i++){
+            if(rand() % 8){
+                append(q, &len, pieces[rand() % PIECES]);
+            } else if(len < CONTROL_QUERY_MAX - 1){
+                q[len++] = 1 + rand() % 255;
+            }
+        }
+        apply_guarded(q, len, &applied);
+        // La misma cortada en cualquier sitio
+        if(len){
+            apply_guarded(q, rand() % len, &applied);
+        }
+
+        // Solo valores malos: todo rechazado y el estado como estaba
+        int32_t before[STATE_FIELDS], after[STATE_FIELDS];
+        state_snapshot(before);
+        len = 0;
+        int commands = 1 + rand() % 4;
+        for(int i = 0; i < commands; i++){
+            if(i){
+                append(q, &len, "&");
+            }
+            if(rand() % 2){
+                append(q, &len, "var=speed&val=");
+            } else {
+                append(q, &len, pieces[2 + rand() % 12]);
+                append(q, &len, "=");
+            }
+            append(q, &len, bad_values[rand() % BAD_VALUES]);
+        }
+        int res = apply_guarded(q, len, &applied);
+        state_snapshot(after);
+        CHECK(res != 0);
+        CHECK_EQ(applied, commands);
+        CHECK(!memcmp(before, after, sizeof(before)));
+        if((res == 0 || applied != commands || memcmp(before, after, sizeof(before))) && fails++ < 5){
+            fprintf(stderr, "query: \"%.*s\"\n", (int)len, q);
+        }
+    }
+
+    // Justo de CONTROL_QUERY_MAX - 1, como la deja el handler
+    memset(q, '&', CONTROL_QUERY_MAX - 1);
+    memcpy(q + CONTROL_QUERY_MAX - 9, "speed=12", 8);
+    apply_guarded(q, CONTROL_QUERY_MAX - 1, &applied);
+    CHECK_EQ(applied, 1);
+
+    int res = check_done("test_control_fuzz");
+    // La tarea de actuadores sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
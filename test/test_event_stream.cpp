@@ -0,0 +1,78 @@
+#include "event_stream.h"
+#include "mjpeg_stream.h"
+#include "device_state.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "check.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string>
+
+// /events con el socket lleno: el estado completo que no ha salido no cuenta como enviado,
+// y en cuanto el cliente lee lo recibe antes que cualquier diferencia. Al irse, el socket se cierra
+// una vez, el servidor.
+
+void mjpeg_stream_stats(mjpeg_stream_stats_t * out){
+    memset(out, 0, sizeof(*out));
+}
+
+#define TEST_PERIOD_MS 20
+
+// Lee lo que haya sin esperar
+static std::string drain(int fd){
+    std::string in;
+    char buf[4096];
+    ssize_t n;
+    while((n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0){
+        in.append(buf, n);
+    }
+    return in;
+}
+
+int main(){
+    int sv[2];
+    CHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+    int snd = 4096;
+    setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &snd, sizeof(snd));
+    // Se llena el socket: el primer envio del estado completo se encuentra EAGAIN
+    char junk[256];
+    memset(junk, 'x', sizeof(junk));
+    while(send(sv[0], junk, sizeof(junk), MSG_DONTWAIT) > 0){
+    }
+
+    httpd_handle_t server = host_httpd_server(event_stream_close_fn);
+    event_stream_start(server);
+    event_stream_set_period(TEST_PERIOD_MS);
+    CHECK(event_stream_add_client(sv[0]));
+    vTaskDelay(TEST_PERIOD_MS * 5);
+
+    std::string in = drain(sv[1]);
+    CHECK(in.find_first_not_of('x') == std::string::npos);
+    // Una diferencia despues de vaciar: antes tiene que llegar el estado completo
+    state_set(STATE_SPEED, 123);
+    vTaskDelay(TEST_PERIOD_MS * 5);
+    in = drain(sv[1]);
+    size_t full = in.find("\"flash\":");
+    size_t diff = in.find("\"speed\":123");
+    CHECK(full != std::string::npos);
+    CHECK(diff != std::string::npos);
+    CHECK(full <= diff);
+
+    uint32_t clients, ticks;
+    event_stream_stats(&clients, &ticks);
+    CHECK_EQ(clients, 1);
+
+    // El navegador se va: el servidor llama a close_fn y cierra el socket una sola vez
+    httpd_trigger_sess_close(server, sv[0]);
+    host_httpd_settle();
+    event_stream_stats(&clients, &ticks);
+    CHECK_EQ(clients, 0);
+    CHECK_EQ(host_httpd_double_closes(), 0);
+    char c;
+    CHECK_EQ(recv(sv[1], &c, 1, 0), 0);
+    int res = check_done("test_event_stream");
+    // La tarea de eventos sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,74 @@
+#include "failsafe.h"
+#include "check.h"
+
+// Los tiempos del hombre muerto sin la tarea: plazo que queda, vencimiento una sola vez, vuelta
+// del reloj de 32 bits y rampa de frenado en FAILSAFE_RAMP_TICKS escalones.
+
+int main(){
+    failsafe_t fs;
+    failsafe_init(&fs, FAILSAFE_TIMEOUT_MS);
+
+    // Sin operador no hay nada que vigilar
+    CHECK_EQ(failsafe_left(&fs, 100000), UINT32_MAX);
+    CHECK(!failsafe_expired(&fs, 100000));
+
+    failsafe_feed(&fs, 1000);
+    CHECK_EQ(failsafe_left(&fs, 1000), FAILSAFE_TIMEOUT_MS);
+    CHECK_EQ(failsafe_left(&fs, 1000 + FAILSAFE_TIMEOUT_MS - 1), 1);
+    CHECK(!failsafe_expired(&fs, 1000 + FAILSAFE_TIMEOUT_MS - 1));
+    CHECK_EQ(failsafe_left(&fs, 1000 + FAILSAFE_TIMEOUT_MS), 0);
+
+    // Vence una vez y queda desarmado hasta el siguiente comando
+    CHECK(failsafe_expired(&fs, 1000 + FAILSAFE_TIMEOUT_MS));
+    CHECK(!failsafe_expired(&fs, 1000 + FAILSAFE_TIMEOUT_MS + 1));
+    CHECK_EQ(failsafe_left(&fs, 1000 + FAILSAFE_TIMEOUT_MS + 1), UINT32_MAX);
+
+    // Cada comando alarga el plazo desde ese momento
+    for(uint32_t t = 5000; t < 8000; t += 150){
+        failsafe_feed(&fs, t);
+        CHECK(!failsafe_expired(&fs, t + 149));
+        CHECK_EQ(failsafe_left(&fs, t + 149), FAILSAFE_TIMEOUT_MS - 149);
+    }
+    // Muy tarde tambien vence (no da la vuelta a "queda mucho")
+    CHECK(failsafe_expired(&fs, 8000 + 100000));
+
+    // El reloj de ms da la vuelta a los 49 dias
+    failsafe_feed(&fs, UINT32_MAX - 100);
+    CHECK_EQ(failsafe_left(&fs, 50), FAILSAFE_TIMEOUT_MS - 151);
+    CHECK(!failsafe_expired(&fs, 50));
+    CHECK(failsafe_expired(&fs, FAILSAFE_TIMEOUT_MS - 101));
+
+    // Plazo 0: apagado aunque este armado
+    failsafe_feed(&fs, 0);
+    fs.timeout_ms = 0;
+    CHECK_EQ(failsafe_left(&fs, 1000000), UINT32_MAX);
+    CHECK(!failsafe_expired(&fs, 1000000));
+
+    // Rampa: desde el duty maximo, justo FAILSAFE_RAMP_TICKS escalones
+    uint8_t duty[4] = {255, 0, 100, 1};
+    int ticks = 0;
+    bool running = true;
+    while(running && ticks < 100){
+        uint8_t before[4] = {duty[0], duty[1], duty[2], duty[3]};
+        running = failsafe_ramp(duty, 4);
+        for(int i = 0; i < 4; i++){
+            CHECK(duty[i] <= before[i]);
+            CHECK(before[i] - duty[i] <= FAILSAFE_RAMP_STEP);
+        }
+        ticks++;
+    }
+    CHECK_EQ(ticks, FAILSAFE_RAMP_TICKS);
+    for(int i = 0; i < 4; i++){
+        CHECK_EQ(duty[i], 0);
+    }
+    // Los que van despacio paran en el primer tick
+    uint8_t slow[2] = {FAILSAFE_RAMP_STEP, 1};
+    CHECK(!failsafe_ramp(slow, 2));
+    CHECK_EQ(slow[0], 0);
+    CHECK_EQ(slow[1], 0);
+
+    // La cota que publica /perf: plazo mas la rampa entera
+    CHECK_EQ(FAILSAFE_REACTION_MS(500, 20), 500 + FAILSAFE_RAMP_TICKS * 20);
+
+    return check_done("test_failsafe");
+}
@@ -0,0 +1,138 @@
+#include "gray_jpeg.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <jpeglib.h>
+
+// El codificador de la vista previa contra libjpeg: lo que sale se tiene que poder decodificar,
+// con las medidas pedidas, un solo canal y parecerse a la imagen de entrada (PSNR).
+
+// Decodifica con libjpeg; false si libjpeg da error o no es gris
+static bool decode(const uint8_t * jpg, size_t len, std::vector<uint8_t> * out, int * width, int * height){
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    // Sin longjmp: cualquier aviso o error se cuenta y se sigue, libjpeg rellena lo que falte
+    jerr.emit_message = [](j_common_ptr c, int level){ if(level < 0) c->err->num_warnings++; };
+    jerr.error_exit = [](j_common_ptr c){ c->err->output_message(c); fprintf(stderr, "libjpeg: error\n"); exit(1); };
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char *)jpg, len);
+    jpeg_read_header(&cinfo, TRUE);
+    jpeg_start_decompress(&cinfo);
+    bool gray = cinfo.output_components == 1;
+    *width = cinfo.output_width;
+    *height = cinfo.output_height;
+    out->resize((size_t)*width * *height * cinfo.output_components);
+    while(cinfo.output_scanline < cinfo.output_height){
+        JSAMPROW row = &(*out)[(size_t)cinfo.output_scanline * *width * cinfo.output_components];
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    bool clean = jerr.num_warnings == 0;
+    jpeg_destroy_decompress(&cinfo);
+    return gray && clean;
+}
+
+static double psnr(const uint8_t * a, int stride, const uint8_t * b, int width, int height){
+    double err = 0;
+    for(int y = 0; y < height; y++){
+        for(int x = 0; x < width; x++){
+            double d = (double)a[y * stride + x] - b[y * width + x];
+            err += d * d;
+        }
+    }
+    err /= (double)width * height;
+    return err ? 10 * log10(255.0 * 255.0 / err) : 99;
+}
+
+// Codifica, decodifica y devuelve el PSNR; -1 si algo falla. La cota solo vale hasta calidad 90
+static double roundtrip(const uint8_t * gray, int width, int height, int stride, int quality){
+    std::vector<uint8_t> jpg(gray_jpeg_bound(width, height) * (quality > 90 ? 2 : 1));
+    size_t len = gray_jpeg_encode(gray, width, height, stride, quality, jpg.data(), jpg.size());
+    CHECK(len > 0);
+    if(!len){
+        return -1;
+    }
+    CHECK(jpg[0] == 0xff && jpg[1] == 0xd8);
+    CHECK(jpg[len - 2] == 0xff && jpg[len - 1] == 0xd9);
+    std::vector<uint8_t> out;
+    int w, h;
+    bool ok = decode(jpg.data(), len, &out, &w, &h);
+    CHECK(ok);
+    CHECK_EQ(w, width);
+    CHECK_EQ(h, height);
+    if(!ok || w != width || h != height){
+        return -1;
+    }
+    return psnr(gray, stride, out.data(), width, height);
+}
+
+int main(){
+    // Luminancia: blanco, negro y los tres primarios
+    const uint8_t rgb[15] = {255, 255, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255};
+    uint8_t y[5];
+    gray_from_rgb888(rgb, y, 5);
+    CHECK_EQ(y[0], 255);
+    CHECK_EQ(y[1], 0);
+    CHECK_EQ(y[2], (77 * 255 + 128) >> 8);
+    CHECK_EQ(y[3], (150 * 255 + 128) >> 8);
+    CHECK_EQ(y[4], (29 * 255 + 128) >> 8);
+
+    // Plano: sale casi exacto
+    std::vector<uint8_t> img(320 * 240, 128);
+    CHECK(roundtrip(img.data(), 320, 240, 320, GRAY_JPEG_QUALITY) > 45);
+
+    // Degradado con algo de textura, como una escena de verdad
+    for(int py = 0; py < 240; py++){
+        for(int px = 0; px < 320; px++){
+            img[py * 320 + px] = (uint8_t)(px * 255 / 319 / 2 + py * 255 / 239 / 4 + 40 * sin(px / 7.0) * cos(py / 5.0) + 50);
+        }
+    }
+    double q50 = roundtrip(img.data(), 320, 240, 320, GRAY_JPEG_QUALITY);
+    double q90 = roundtrip(img.data(), 320, 240, 320, 90);
+    double q10 = roundtrip(img.data(), 320, 240, 320, 10);
+    CHECK(q50 > 30);
+    CHECK(q90 > q50);
+    CHECK(q50 > q10);
+    CHECK(q10 > 20);
+
+    // Bordes del 0 al 255 en un tablero: los coeficientes mas grandes y las categorias mas altas
+    for(int py = 0; py < 240; py++){
+        for(int px = 0; px < 320; px++){
+            img[py * 320 + px] = ((px / 3) ^ (py / 3)) & 1 ? 255 : 0;
+        }
+    }
+    CHECK(roundtrip(img.data(), 320, 240, 320, 90) > 20);
+    CHECK(roundtrip(img.data(), 320, 240, 320, 100) > 25);
+    CHECK(roundtrip(img.data(), 320, 240, 320, 1) > 0);
+
+    // Ruido: el peor caso para la cota de salida
+    srand(1);
+    for(size_t i = 0; i < img.size(); i++){
+        img[i] = rand() & 0xff;
+    }
+    CHECK(roundtrip(img.data(), 320, 240, 320, 90) > 15);
+    CHECK(roundtrip(img.data(), 320, 240, 320, 100) > 20);
+
+    // Medidas que no llenan bloques de 8x8, y con stride mayor que el ancho (un recorte de la imagen)
+    CHECK(roundtrip(img.data(), 13, 9, 320, GRAY_JPEG_QUALITY) > 0);
+    CHECK(roundtrip(img.data(), 1, 1, 320, GRAY_JPEG_QUALITY) > 0);
+    for(int py = 0; py < 240; py++){
+        for(int px = 0; px < 320; px++){
+            img[py * 320 + px] = (uint8_t)(px + py);
+        }
+    }
+    CHECK(roundtrip(img.data() + 320 * 3 + 5, 161, 117, 320, GRAY_JPEG_QUALITY) > 30);
+
+    // Si no cabe devuelve 0 en lugar de escribir de mas
+    std::vector<uint8_t> small(600 + 16, 0xaa);
+    CHECK_EQ(gray_jpeg_encode(img.data(), 320, 240, 320, 90, small.data(), 600), 0);
+    for(size_t i = 600; i < small.size(); i++){
+        CHECK_EQ(small[i], 0xaa);
+    }
+
+    return check_done("test_gray_jpeg");
+}
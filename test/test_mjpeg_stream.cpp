@@ -0,0 +1,133 @@
+#include "mjpeg_stream.h"
+#include "camera_pipeline.h"
+#include "stream_preview.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "check.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+
+// La vista previa se codifica fuera de clients_lock: un close_fn que llega a mitad no espera a la
+// codificacion, y el frame que esta retenido para ella se suelta igual. El socket lo cierra el servidor.
+// El anillo es de mentira: un solo frame que la prueba publica a mano.
+
+#define ENCODE_MS 200
+#define PREVIEW_LEN 1000
+
+static frame_t frame;
+static portMUX_TYPE frame_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t frame_buf[4000];
+static volatile uint32_t published = 0;
+static volatile bool encoding = false;
+
+void perf_frame(size_t len, uint32_t frame_ms){}
+void camera_pipeline_subscribe(){}
+void camera_pipeline_unsubscribe(){}
+
+frame_t * frame_acquire_latest(uint32_t last_seq, uint32_t timeout_ms){
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while(true){
+        portENTER_CRITICAL(&frame_mux);
+        frame_t * f = NULL;
+        if(published && published != last_seq){
+            f = &frame;
+            f->seq = published;
+            f->refs++;
+        }
+        portEXIT_CRITICAL(&frame_mux);
+        if(f || esp_timer_get_time() >= deadline){
+            return f;
+        }
+        usleep(1000);
+    }
+}
+
+void frame_release(frame_t * f){
+    if(!f){
+        return;
+    }
+    portENTER_CRITICAL(&frame_mux);
+    f->refs--;
+    portEXIT_CRITICAL(&frame_mux);
+}
+
+bool stream_preview_encode(const frame_t * f, int scale, preview_buf_t * out){
+    encoding = true;
+    usleep(ENCODE_MS * 1000);
+    if(out->capacity < PREVIEW_LEN){
+        out->buf = (uint8_t *)realloc(out->buf, PREVIEW_LEN);
+        out->capacity = PREVIEW_LEN;
+    }
+    memset(out->buf, 0x33, PREVIEW_LEN);
+    out->len = PREVIEW_LEN;
+    encoding = false;
+    return true;
+}
+
+static int frame_refs(){
+    portENTER_CRITICAL(&frame_mux);
+    int refs = frame.refs;
+    portEXIT_CRITICAL(&frame_mux);
+    return refs;
+}
+
+static void publish(){
+    frame.buf = frame_buf;
+    frame.len = sizeof(frame_buf);
+    frame.timestamp = esp_timer_get_time();
+    published++;
+}
+
+int main(){
+    httpd_handle_t server = host_httpd_server(mjpeg_stream_close_fn);
+    mjpeg_stream_start(server);
+
+    // Un cliente de vista previa recibe lo codificado
+    int a[2];
+    CHECK_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, a), 0);
+    CHECK(mjpeg_stream_add_client(a[0], 2));
+    publish();
+    std::string in;
+    int64_t deadline = esp_timer_get_time() + 2000000;
+    while(in.find("Content-Length: 1000\r\n") == std::string::npos && esp_timer_get_time() < deadline){
+        char buf[2048];
+        ssize_t n = recv(a[1], buf, sizeof(buf), MSG_DONTWAIT);
+        if(n > 0){
+            in.append(buf, n);
+        } else {
+            usleep(1000);
+        }
+    }
+    CHECK(in.find("Content-Length: 1000\r\n") != std::string::npos);
+
+    // Se cierra mientras se codifica el siguiente frame
+    publish();
+    while(!encoding && esp_timer_get_time() < deadline){
+        usleep(500);
+    }
+    CHECK(encoding);
+    int64_t t0 = esp_timer_get_time();
+    httpd_trigger_sess_close(server, a[0]);
+    host_httpd_settle();
+    CHECK(esp_timer_get_time() - t0 < ENCODE_MS * 1000 / 4);
+    CHECK(encoding);
+    vTaskDelay(ENCODE_MS * 2);
+    CHECK_EQ(frame_refs(), 0);
+    mjpeg_stream_stats_t st;
+    mjpeg_stream_stats(&st);
+    CHECK_EQ(st.viewers, 0);
+    // El socket se ha cerrado una sola vez, el servidor
+    CHECK_EQ(host_httpd_double_closes(), 0);
+    char rest[4096];
+    ssize_t n;
+    while((n = recv(a[1], rest, sizeof(rest), 0)) > 0){
+    }
+    CHECK_EQ(n, 0);
+
+    int res = check_done("test_mjpeg_stream");
+    // La tarea de envio sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
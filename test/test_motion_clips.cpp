@@ -0,0 +1,251 @@
+#include "motion_stage.h"
+#include "motion_detect.h"
+#include "device_state.h"
+#include "img_converters.h"
+#include "freertos/task.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+// El modo centinela de punta a punta con clips generados: cada frame se codifica en JPEG como en la
+// camara, se ofrece a motion_stage y pasa por su tarea (stream_preview_decode a 1/8 y motion_detect).
+// Por clip, los eventos que salen en /status y los analisis con movimiento, a tres umbrales.
+// Con el umbral por defecto los clips con algo moviendose dan al menos un evento y los quietos ninguno.
+// El cambio brusco de exposicion solo se cuenta: toda la imagen cambia a la vez y el detector no lo
+// distingue de movimiento, se queda como limitacion conocida.
+
+#define W 320
+#define H 240
+#define CLIP_FRAMES 60          // 12 s a un analisis cada MOTION_PERIOD_MS
+#define JPEG_QUALITY 80
+
+typedef enum {
+        CLIP_MOTION,
+        CLIP_QUIET,
+        CLIP_REPORT             // se cuenta pero no se comprueba
+} clip_kind_t;
+
+typedef struct {
+        const char * name;
+        clip_kind_t kind;
+        void (*draw)(std::vector<uint8_t> & rgb, int frame, uint32_t * seed);
+} clip_t;
+
+static uint32_t next(uint32_t * seed){
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static uint8_t clamp(int v){
+    return v < 0 ? 0 : v > 255 ? 255 : v;
+}
+
+// Una habitacion: pared en degradado, un mueble y un cuadro, con ruido de sensor de +-amp
+static void room(std::vector<uint8_t> & rgb, uint32_t * seed, int amp, int light){
+    for(int y = 0; y < H; y++){
+        for(int x = 0; x < W; x++){
+            int v = 70 + x * 80 / W + y * 30 / H;
+            if(x > 200 && x < 300 && y > 140){
+                v = 50;
+            } else if(x > 40 && x < 110 && y > 40 && y < 90){
+                v = 170 + ((x / 8 + y / 8) & 1) * 30;
+            }
+            v += light + (amp ? (int)(next(seed) % (2 * amp + 1)) - amp : 0);
+            uint8_t * p = &rgb[(y * W + x) * 3];
+            p[0] = clamp(v + 10);
+            p[1] = clamp(v);
+            p[2] = clamp(v - 10);
+        }
+    }
+}
+
+static void rect(std::vector<uint8_t> & rgb, int x0, int y0, int w, int h, uint8_t v){
+    for(int y = y0 < 0 ? 0 : y0; y < y0 + h && y < H; y++){
+        for(int x = x0 < 0 ? 0 : x0; x < x0 + w && x < W; x++){
+            uint8_t * p = &rgb[(y * W + x) * 3];
+            p[0] = v;
+            p[1] = v + 10;
+            p[2] = v + 20;
+        }
+    }
+}
+
+// Alguien cruza la habitacion a 12 px por analisis
+static void draw_crossing(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, 0);
+    if(frame >= 5){
+        rect(rgb, (frame - 5) * 12 - 40, 90, 40, 90, 30);
+    }
+}
+
+// Entra, se para a mitad del clip y se queda: el evento tiene que acabar solo
+static void draw_enter_stop(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, 0);
+    int x = frame < 5 ? -60 : frame < 13 ? -60 + (frame - 5) * 20 : 100;
+    rect(rgb, x, 60, 60, 120, 25);
+}
+
+// Un gato: 32x32, un bloque de analisis, a 4 px por analisis
+static void draw_small_slow(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, 0);
+    if(frame >= 5){
+        rect(rgb, 20 + (frame - 5) * 4, 180, 32, 32, 20);
+    }
+}
+
+static void draw_quiet(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, 0);
+}
+
+// Poca luz: el sensor sube la ganancia y el ruido con ella
+static void draw_noisy(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 12, 0);
+}
+
+// Atardece: medio nivel menos por analisis, unos 2.5 por segundo
+static void draw_dusk(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, -frame / 2);
+}
+
+// Un LED de 8x8 que parpadea: un pixel de la imagen analizada
+static void draw_blink(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, 0);
+    if(frame & 1){
+        rect(rgb, 152, 120, 8, 8, 240);
+    }
+}
+
+// La exposicion automatica salta a mitad del clip
+static void draw_exposure(std::vector<uint8_t> & rgb, int frame, uint32_t * seed){
+    room(rgb, seed, 3, frame >= 15 ? 25 : 0);
+}
+
+static const clip_t clips[] = {
+    {"cruza", CLIP_MOTION, draw_crossing},
+    {"entra y se para", CLIP_MOTION, draw_enter_stop},
+    {"pequeno y lento", CLIP_MOTION, draw_small_slow},
+    {"quieto", CLIP_QUIET, draw_quiet},
+    {"ruido de poca luz", CLIP_QUIET, draw_noisy},
+    {"atardecer", CLIP_QUIET, draw_dusk},
+    {"led parpadeando", CLIP_QUIET, draw_blink},
+    {"salto de exposicion", CLIP_REPORT, draw_exposure},
+};
+#define CLIPS (sizeof(clips) / sizeof(clips[0]))
+
+void camera_pipeline_subscribe(){}
+void camera_pipeline_unsubscribe(){}
+
+// motion_stage_offer suelta el frame en el momento si el analisis anterior no ha sacado el suyo
+static thread_local bool offering = false;
+static thread_local bool rejected = false;
+
+void frame_release(frame_t * f){
+    if(offering){
+        rejected = true;
+    }
+}
+
+static size_t sink_write(void * arg, size_t index, const void * data, size_t len){
+    std::string * s = (std::string *)arg;
+    s->append((const char *)data, len);
+    return len;
+}
+
+static int32_t state_get(state_field_t field){
+    int32_t values[STATE_FIELDS];
+    state_snapshot(values);
+    return values[field];
+}
+
+// Ofrece el frame hasta que lo coge la tarea y espera a que acabe su analisis
+static bool analyze(frame_t * f){
+    uint32_t before, analyzed, events;
+    motion_stage_stats(&before, &events);
+    for(int tries = 0; tries < 1000; tries++){
+        rejected = false;
+        offering = true;
+        motion_stage_offer(f);
+        offering = false;
+        if(!rejected){
+            break;
+        }
+        usleep(200);
+    }
+    for(int waits = 0; waits < 5000; waits++){
+        motion_stage_stats(&analyzed, &events);
+        if(analyzed != before){
+            return true;
+        }
+        usleep(200);
+    }
+    return false;
+}
+
+int main(){
+    // Todos los clips en JPEG una vez
+    std::vector<std::vector<std::string> > jpegs(CLIPS);
+    std::vector<uint8_t> rgb(W * H * 3);
+    for(size_t c = 0; c < CLIPS; c++){
+        uint32_t seed = 1 + c;
+        for(int i = 0; i < CLIP_FRAMES; i++){
+            clips[c].draw(rgb, i, &seed);
+            camera_fb_t fb = {rgb.data(), rgb.size(), W, H, PIXFORMAT_RGB888};
+            std::string jpg;
+            CHECK(frame2jpg_cb(&fb, JPEG_QUALITY, sink_write, &jpg));
+            jpegs[c].push_back(jpg);
+        }
+    }
+
+    motion_stage_start();
+    static const int thresholds[] = {6, MOTION_THRESHOLD, 20};
+    for(size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++){
+        int threshold = thresholds[t];
+        motion_stage_set_threshold(threshold);
+        printf("umbral %d%s\n", threshold, threshold == MOTION_THRESHOLD ? " (por defecto)" : "");
+        int detected = 0, motion_clips = 0, false_events = 0;
+        for(size_t c = 0; c < CLIPS; c++){
+            // Apagar y encender vuelve a sembrar el fondo con el primer frame del clip
+            CHECK(motion_stage_enable(false));
+            CHECK(motion_stage_enable(true));
+            uint32_t analyzed, events_before, events_after;
+            motion_stage_stats(&analyzed, &events_before);
+            int active = 0;
+            for(int i = 0; i < CLIP_FRAMES; i++){
+                std::string & j = jpegs[c][i];
+                frame_t f = {(uint8_t *)&j[0], j.size(), j.size(), W, H, (uint32_t)i + 1, 0, 1};
+                CHECK(analyze(&f));
+                active += state_get(STATE_MOTION);
+            }
+            motion_stage_stats(&analyzed, &events_after);
+            int events = events_after - events_before;
+            printf("  %-20s %2d eventos, %2d de %d analisis con movimiento%s\n", clips[c].name, events, active,
+                   CLIP_FRAMES, clips[c].kind == CLIP_REPORT ? " (solo se cuenta)" : "");
+            if(clips[c].kind == CLIP_MOTION){
+                motion_clips++;
+                detected += events > 0;
+            } else if(clips[c].kind == CLIP_QUIET){
+                false_events += events;
+            }
+            if(threshold == MOTION_THRESHOLD && clips[c].kind == CLIP_MOTION){
+                CHECK(events >= 1);
+                // Quien se queda quieto pasa a ser fondo y el evento acaba
+                if(clips[c].draw == draw_enter_stop){
+                    CHECK_EQ(state_get(STATE_MOTION), 0);
+                }
+            }
+            if(threshold == MOTION_THRESHOLD && clips[c].kind == CLIP_QUIET){
+                CHECK_EQ(events, 0);
+            }
+        }
+        printf("  detectados %d de %d, %d disparos en falso\n", detected, motion_clips, false_events);
+    }
+    CHECK(motion_stage_enable(false));
+
+    int res = check_done("test_motion_clips");
+    fflush(stdout);
+    // La tarea de movimiento sigue en su hilo
+    _exit(res);
+}
@@ -0,0 +1,130 @@
+#include "motion_detect.h"
+#include "check.h"
+#include <string.h>
+
+// Los umbrales del detector: un bloque cuenta solo si la diferencia media pasa de threshold,
+// el rectangulo abarca los bloques activos y un cambio que se queda acaba siendo fondo.
+
+#define W 32
+#define H 24
+#define BLOCKS ((W / MOTION_BLOCK) * (H / MOTION_BLOCK))
+
+static uint16_t bg[W * H];
+
+static void fill(uint8_t * img, uint8_t v){
+    memset(img, v, W * H);
+}
+
+// Pinta el bloque (bx, by) entero
+static void block(uint8_t * img, int bx, int by, uint8_t v){
+    for(int r = 0; r < MOTION_BLOCK; r++){
+        memset(img + (by * MOTION_BLOCK + r) * W + bx * MOTION_BLOCK, v, MOTION_BLOCK);
+    }
+}
+
+// Siembra el fondo con base y compara una imagen
+static int against(motion_detector_t * m, uint8_t base, const uint8_t * img, motion_box_t * box){
+    uint8_t seed[W * H];
+    fill(seed, base);
+    motion_detect_reset(m);
+    motion_detect(m, seed, W, H, box);
+    return motion_detect(m, img, W, H, box);
+}
+
+int main(){
+    motion_detector_t m;
+    motion_detect_init(&m, bg, W * H, MOTION_THRESHOLD);
+    uint8_t img[W * H];
+    motion_box_t box = {-1, -1, -1, -1};
+
+    // La primera imagen solo siembra el fondo; la misma otra vez no es movimiento
+    fill(img, 100);
+    CHECK_EQ(motion_detect(&m, img, W, H, &box), 0);
+    CHECK_EQ(motion_detect(&m, img, W, H, &box), 0);
+
+    // Justo en el umbral no cuenta, uno mas si, en todos los bloques
+    fill(img, 100 + MOTION_THRESHOLD);
+    CHECK_EQ(against(&m, 100, img, &box), 0);
+    fill(img, 100 - MOTION_THRESHOLD);
+    CHECK_EQ(against(&m, 100, img, &box), 0);
+    fill(img, 100 + MOTION_THRESHOLD + 1);
+    CHECK_EQ(against(&m, 100, img, &box), BLOCKS);
+    CHECK_EQ(box.x, 0);
+    CHECK_EQ(box.y, 0);
+    CHECK_EQ(box.w, W / MOTION_BLOCK);
+    CHECK_EQ(box.h, H / MOTION_BLOCK);
+    fill(img, 100 - MOTION_THRESHOLD - 1);
+    CHECK_EQ(against(&m, 100, img, &box), BLOCKS);
+
+    // Es la media del bloque: un solo pixel muy distinto no basta si la media no pasa
+    fill(img, 0);
+    img[5 * W + 9] = MOTION_THRESHOLD * MOTION_BLOCK * MOTION_BLOCK;
+    CHECK_EQ(against(&m, 0, img, &box), 0);
+    img[5 * W + 9]++;
+    CHECK_EQ(against(&m, 0, img, &box), 1);
+    CHECK_EQ(box.x, 9 / MOTION_BLOCK);
+    CHECK_EQ(box.y, 5 / MOTION_BLOCK);
+    CHECK_EQ(box.w, 1);
+    CHECK_EQ(box.h, 1);
+
+    // Dos bloques separados: el rectangulo los abarca a los dos
+    fill(img, 100);
+    block(img, 1, 4, 0);
+    block(img, 6, 2, 255);
+    CHECK_EQ(against(&m, 100, img, &box), 2);
+    CHECK_EQ(box.x, 1);
+    CHECK_EQ(box.y, 2);
+    CHECK_EQ(box.w, 6);
+    CHECK_EQ(box.h, 3);
+
+    // Ruido del sensor por debajo del umbral en toda la imagen no es movimiento
+    for(int i = 0; i < W * H; i++){
+        img[i] = 100 + ((i * 7 + i / W) % 5 - 2) * MOTION_THRESHOLD / 2;
+    }
+    CHECK_EQ(against(&m, 100, img, &box), 0);
+
+    // Algo que entra y se queda: deja de ser movimiento cuando el fondo lo alcanza, y no vuelve
+    fill(img, 100);
+    block(img, 3, 3, 200);
+    int frames = 0;
+    int active = against(&m, 100, img, &box);
+    CHECK_EQ(active, 1);
+    while(active && frames < 200){
+        active = motion_detect(&m, img, W, H, &box);
+        frames++;
+    }
+    CHECK_EQ(active, 0);
+    // 100 de diferencia que se reduce 1/16 por imagen hasta quedar en el umbral: unas 33
+    CHECK(frames >= 25);
+    CHECK(frames <= 40);
+    for(int i = 0; i < 10; i++){
+        CHECK_EQ(motion_detect(&m, img, W, H, &box), 0);
+    }
+
+    // Lo que no llena un bloque en el borde derecho o inferior no se mira
+    uint16_t big[(W + 2) * (H + 3)];
+    motion_detector_t e;
+    motion_detect_init(&e, big, (W + 2) * (H + 3), MOTION_THRESHOLD);
+    uint8_t edge[(W + 2) * (H + 3)];
+    memset(edge, 100, sizeof(edge));
+    CHECK_EQ(motion_detect(&e, edge, W + 2, H + 3, &box), 0);
+    for(int r = 0; r < H + 3; r++){
+        edge[r * (W + 2) + W] = edge[r * (W + 2) + W + 1] = 255;
+    }
+    memset(edge + H * (W + 2), 255, 3 * (W + 2));
+    CHECK_EQ(motion_detect(&e, edge, W + 2, H + 3, &box), 0);
+
+    // Otro tamano vuelve a sembrar; si no cabe, -1
+    fill(img, 0);
+    CHECK_EQ(motion_detect(&m, img, W / 2, H, &box), 0);
+    CHECK_EQ(motion_detect(&m, img, W, H + 1, &box), -1);
+
+    // Umbral propio
+    motion_detect_init(&m, bg, W * H, 40);
+    fill(img, 140);
+    CHECK_EQ(against(&m, 100, img, &box), 0);
+    fill(img, 141);
+    CHECK_EQ(against(&m, 100, img, &box), BLOCKS);
+
+    return check_done("test_motion_detect");
+}
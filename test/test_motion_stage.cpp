@@ -0,0 +1,86 @@
+#include "motion_stage.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "check.h"
+#include <unistd.h>
+
+// El analisis nunca retiene mas de un frame del anillo aunque la captura ofrezca sin parar, tampoco
+// si ofrece justo cuando la tarea de movimiento saca uno de la cola (host_queue_receive_hook).
+// Sin tarea (sin PSRAM) encenderlo dice que no.
+
+#define DECODE_US 1000
+
+static frame_t frame;
+static portMUX_TYPE held_mux = portMUX_INITIALIZER_UNLOCKED;
+static int held = 0;
+static int max_held = 0;
+static volatile uint32_t decodes = 0;
+
+void camera_pipeline_subscribe(){}
+void camera_pipeline_unsubscribe(){}
+
+// Quien ofrece sabe si se lo han quedado porque motion_stage_offer no lo suelta en el momento
+static thread_local bool offering = false;
+static thread_local bool rejected = false;
+
+void frame_release(frame_t * f){
+    if(!f){
+        return;
+    }
+    if(offering){
+        rejected = true;
+        return;
+    }
+    portENTER_CRITICAL(&held_mux);
+    held--;
+    portEXIT_CRITICAL(&held_mux);
+}
+
+bool stream_preview_decode(const frame_t * f, int scale, uint8_t ** buf, size_t * capacity, int * width, int * height){
+    portENTER_CRITICAL(&held_mux);
+    max_held = held > max_held ? held : max_held;
+    portEXIT_CRITICAL(&held_mux);
+    usleep(DECODE_US);
+    decodes++;
+    return false;
+}
+
+static void offer(){
+    rejected = false;
+    offering = true;
+    frame.timestamp = esp_timer_get_time();
+    motion_stage_offer(&frame);
+    offering = false;
+    if(!rejected){
+        portENTER_CRITICAL(&held_mux);
+        held++;
+        portEXIT_CRITICAL(&held_mux);
+    }
+}
+
+int main(){
+    CHECK(!motion_stage_enable(true));
+    CHECK(motion_stage_enable(false));
+
+    motion_stage_start();
+    CHECK(motion_stage_enable(true));
+    // La captura ofrece tambien en el peor momento
+    host_queue_receive_hook = offer;
+    int64_t end = esp_timer_get_time() + 300000;
+    while(esp_timer_get_time() < end){
+        offer();
+        usleep(5);
+    }
+    host_queue_receive_hook = NULL;
+    vTaskDelay(DECODE_US / 1000 * 5 + 10);
+    CHECK(decodes > 10);
+    CHECK_EQ(max_held, 1);
+    CHECK_EQ(held, 0);
+    CHECK(motion_stage_enable(false));
+
+    int res = check_done("test_motion_stage");
+    // La tarea de movimiento sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
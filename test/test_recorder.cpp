@@ -0,0 +1,175 @@
+#include "recorder.h"
+#include "avi.h"
+#include "freertos/task.h"
+#include "host.h"
+#include "check.h"
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+// Grabacion a una carpeta del PC (RECORD_MOUNT de CMakeLists.txt). Con frames que cruzan de un buffer
+// al otro, el .idx escrito hasta cada momento solo apunta a datos que ya estan en el AVI, y al parar
+// idx1 tiene una entrada por frame que cae en su trozo '00dc'.
+
+void camera_pipeline_subscribe(){}
+void camera_pipeline_unsubscribe(){}
+
+static uint32_t get32(const uint8_t * p){
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static std::vector<uint8_t> read_file(const std::string & path){
+    std::vector<uint8_t> data;
+    FILE * f = fopen(path.c_str(), "rb");
+    if(!f){
+        return data;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0){
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return data;
+}
+
+static void clear_dir(){
+    DIR * dir = opendir(RECORD_DIR);
+    if(!dir){
+        return;
+    }
+    struct dirent * e;
+    while((e = readdir(dir))){
+        if(e->d_name[0] != '.'){
+            unlink((std::string(RECORD_DIR "/") + e->d_name).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+// Cada entrada del .idx, con lo que hay ahora mismo en la tarjeta
+static int idx_past_end(){
+    struct stat st;
+    if(stat(RECORD_DIR "/clip0001.avi", &st)){
+        return -1;
+    }
+    std::vector<uint8_t> idx = read_file(RECORD_DIR "/clip0001.idx");
+    int bad = 0;
+    for(size_t i = 0; i + AVI_INDEX_ENTRY <= idx.size(); i += AVI_INDEX_ENTRY){
+        uint32_t end = AVI_MOVI_OFFSET + get32(&idx[i + 8]) + AVI_CHUNK_HEADER + get32(&idx[i + 12]);
+        bad += end > (uint32_t)st.st_size;
+    }
+    return bad;
+}
+
+static void wait_written(){
+    record_status_t st;
+    uint32_t bytes = ~0u;
+    // Hasta que el grabador deja de escribir
+    do {
+        recorder_status(&st);
+        if(st.bytes == bytes){
+            break;
+        }
+        bytes = st.bytes;
+        vTaskDelay(20);
+    } while(true);
+}
+
+int main(){
+    recorder_mount();
+    clear_dir();
+    recorder_start();
+    CHECK_EQ(recorder_begin(), RECORD_OK);
+
+    // De 3 a 9 KB, impares y pares: muchos frames cruzan el borde de 32 KB entre los dos buffers
+    std::vector<uint8_t> jpeg(9000);
+    for(size_t i = 0; i < jpeg.size(); i++){
+        jpeg[i] = i * 7;
+    }
+    frame_t f;
+    memset(&f, 0, sizeof(f));
+    f.buf = jpeg.data();
+    f.width = 640;
+    f.height = 480;
+    const int count = 60;
+    std::vector<size_t> lens;
+    for(int i = 0; i < count; i++){
+        f.len = 3000 + (i * 1237) % 6001;
+        f.seq = i + 1;
+        f.timestamp = i * 40000;
+        recorder_tee(&f);
+        lens.push_back(f.len);
+        if(i % 5 == 4){
+            wait_written();
+            CHECK_EQ(idx_past_end(), 0);
+        }
+    }
+    record_status_t st;
+    recorder_status(&st);
+    CHECK_EQ(st.frames, count);
+    CHECK_EQ(st.dropped, 0);
+
+    recorder_end();
+    recorder_tee(&f);
+    for(int i = 0; i < 200; i++){
+        recorder_status(&st);
+        if(st.state == RECORD_IDLE){
+            break;
+        }
+        vTaskDelay(10);
+    }
+    CHECK_EQ(st.state, RECORD_IDLE);
+    CHECK_EQ(st.error, RECORD_OK);
+
+    std::vector<uint8_t> avi = read_file(RECORD_DIR "/clip0001.avi");
+    struct stat gone;
+    CHECK(stat(RECORD_DIR "/clip0001.idx", &gone) != 0);
+    size_t movi = 0;
+    for(size_t i = 0; i < lens.size(); i++){
+        movi += avi_chunk_size(lens[i]);
+    }
+    size_t idx1 = AVI_HEADER_SIZE + movi;
+    CHECK(avi.size() == idx1 + 8 + count * AVI_INDEX_ENTRY);
+    if(avi.size() == idx1 + 8 + count * AVI_INDEX_ENTRY){
+        CHECK(!memcmp(&avi[idx1], "idx1", 4));
+        for(int i = 0; i < count; i++){
+            const uint8_t * e = &avi[idx1 + 8 + i * AVI_INDEX_ENTRY];
+            size_t pos = AVI_MOVI_OFFSET + get32(e + 8);
+            CHECK_EQ(get32(e + 12), lens[i]);
+            CHECK(pos + AVI_CHUNK_HEADER + lens[i] <= idx1);
+            CHECK(!memcmp(&avi[pos], "00dc", 4));
+            CHECK_EQ(get32(&avi[pos + 4]), lens[i]);
+            CHECK(!memcmp(&avi[pos + AVI_CHUNK_HEADER], jpeg.data(), lens[i]));
+        }
+    }
+    // Frames de mas de un buffer con la tarjeta al dia: lo que queda a medias en el activo no puede
+    // dejarlos fuera para siempre
+    CHECK_EQ(recorder_begin(), RECORD_OK);
+    std::vector<uint8_t> big(50000, 0x5a);
+    f.buf = big.data();
+    for(int i = 0; i < 20; i++){
+        f.len = 33000 + (i * 7919) % 17000;
+        f.seq = i + 1;
+        f.timestamp = i * 40000;
+        recorder_tee(&f);
+        wait_written();
+    }
+    recorder_status(&st);
+    CHECK_EQ(st.frames, 20);
+    CHECK_EQ(st.dropped, 0);
+    recorder_end();
+    recorder_tee(&f);
+    for(int i = 0; i < 200 && st.state != RECORD_IDLE; i++){
+        vTaskDelay(10);
+        recorder_status(&st);
+    }
+    CHECK_EQ(st.state, RECORD_IDLE);
+
+    int res = check_done("test_recorder");
+    // La tarea del grabador sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,103 @@
+#include "servo_motion.h"
+#include "actuators.h"
+#include "host.h"
+#include "check.h"
+#include <stdlib.h>
+
+// El perfil de los servos tick a tick, leyendo el duty que llega a la PWM: ningun salto
+// mayor que la velocidad maxima, cambios de velocidad dentro de la aceleracion y sin pasarse del objetivo.
+
+#define CHANNEL SERVO_FIRST_CHANNEL
+// Unidades de /control por tick a velocidad maxima, en duty (x10); +1 por el redondeo de cada escritura
+#define PEAK_DUTY(speed) ((speed) * CONTROL_TICK_MS * 10 / 1000 + 1)
+#define ACCEL_DUTY(accel) ((accel) * CONTROL_TICK_MS * CONTROL_TICK_MS * 10 / 1000000 + 2)
+
+typedef struct {
+        int ticks;
+        int peak;               // mayor salto de duty entre dos ticks
+        int peak_accel;         // mayor cambio de ese salto entre dos ticks, sin el ultimo, que cae en el objetivo
+        int lo;
+        int hi;
+        int last;               // ultimo salto, para seguir midiendo en la siguiente tanda
+} run_t;
+
+// Ticks hasta que para (o max_ticks), con el duty del servo 0 en cada uno. prev_step: ultimo salto si ya se movia
+static run_t run(int max_ticks, int prev_step = 0){
+    run_t r = {0, 0, 0, 1 << 30, -(1 << 30), 0};
+    int prev = host_ledc_duty(CHANNEL);
+    bool moving = true;
+    while(moving && r.ticks < max_ticks){
+        moving = servo_motion_step();
+        int duty = host_ledc_duty(CHANNEL);
+        int step = duty - prev;
+        r.peak = abs(step) > r.peak ? abs(step) : r.peak;
+        if(moving && abs(step - prev_step) > r.peak_accel){
+            r.peak_accel = abs(step - prev_step);
+        }
+        r.lo = duty < r.lo ? duty : r.lo;
+        r.hi = duty > r.hi ? duty : r.hi;
+        prev = duty;
+        prev_step = step;
+        r.ticks++;
+    }
+    r.last = prev_step;
+    return r;
+}
+
+int main(){
+    // Hasta el primer comando no hay posicion; el primero va directo
+    CHECK(!servo_motion_known(0));
+    servo_motion_set_target(0, 325);
+    CHECK(servo_motion_known(0));
+    CHECK(!servo_motion_known(1));
+    CHECK_EQ(host_ledc_duty(CHANNEL), 3250);
+    CHECK(!servo_motion_step());
+
+    // Todo el recorrido: trapecio de ~1 s con los limites por defecto
+    servo_motion_set_target(0, 650);
+    run_t r = run(200);
+    CHECK_EQ(host_ledc_duty(CHANNEL), 6500);
+    CHECK(r.peak <= PEAK_DUTY(SERVO_MAX_SPEED));
+    CHECK(r.peak >= PEAK_DUTY(SERVO_MAX_SPEED) - 2);
+    CHECK(r.peak_accel <= ACCEL_DUTY(SERVO_MAX_ACCEL));
+    CHECK(r.hi <= 6500);
+    int ideal = (650 - 325) * 1000 / SERVO_MAX_SPEED + SERVO_MAX_SPEED * 1000 / SERVO_MAX_ACCEL;
+    CHECK(r.ticks * CONTROL_TICK_MS <= ideal + 3 * CONTROL_TICK_MS);
+    CHECK(r.ticks * CONTROL_TICK_MS >= ideal - 3 * CONTROL_TICK_MS);
+
+    // Media vuelta a toda velocidad: frena, vuelve y tampoco se pasa por el otro lado
+    servo_motion_set_target(0, 325);
+    r = run(20);
+    servo_motion_set_target(0, 650);
+    int turn = host_ledc_duty(CHANNEL);
+    r = run(200, r.last);
+    CHECK_EQ(host_ledc_duty(CHANNEL), 6500);
+    CHECK(r.lo >= 3250);
+    CHECK(r.lo <= turn);
+    CHECK(r.hi <= 6500);
+    CHECK(r.peak <= PEAK_DUTY(SERVO_MAX_SPEED));
+    CHECK(r.peak_accel <= ACCEL_DUTY(SERVO_MAX_ACCEL));
+
+    // Un paso de una unidad no se pasa
+    servo_motion_set_target(0, 649);
+    r = run(50);
+    CHECK_EQ(host_ledc_duty(CHANNEL), 6490);
+    CHECK(r.lo >= 6490);
+
+    // Limites nuevos desde el siguiente tick
+    servo_motion_set_limits(100, 500);
+    servo_motion_set_target(0, 400);
+    r = run(1000);
+    CHECK_EQ(host_ledc_duty(CHANNEL), 4000);
+    CHECK(r.peak <= PEAK_DUTY(100));
+    CHECK(r.peak_accel <= ACCEL_DUTY(500));
+    CHECK(r.lo >= 4000);
+
+    // Limites absurdos no paran el servo
+    servo_motion_set_limits(0, 0);
+    servo_motion_set_target(0, 401);
+    r = run(100000);
+    CHECK_EQ(host_ledc_duty(CHANNEL), 4010);
+
+    return check_done("test_servo_motion");
+}
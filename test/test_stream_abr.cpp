@@ -0,0 +1,107 @@
+#include "stream_abr.h"
+#include "check.h"
+
+// La escalera del control de bitrate ventana a ventana: bajar primero calidad y luego resolucion,
+// subir al reves y solo tras ABR_CALM_WINDOWS con margen, y esperar el doble si una subida no aguanta.
+
+#define BUDGET_US (1000000 / ABR_TARGET_FPS)
+#define CONGESTED (BUDGET_US * 3 / 2)
+#define TIGHT (BUDGET_US * 3 / 4)       // cabe pero no con margen para subir
+#define CALM (BUDGET_US / 4)
+
+static bool window(stream_abr_t * abr, uint32_t send_us){
+    stream_abr_window_t w = {10, (uint64_t)send_us * 10};
+    return stream_abr_update(abr, &w);
+}
+
+// Ventanas con margen hasta el siguiente cambio, o -1 si en limit no cambia nada
+static int calm_until_change(stream_abr_t * abr, int limit){
+    for(int i = 1; i <= limit; i++){
+        if(window(abr, CALM)){
+            return i;
+        }
+    }
+    return -1;
+}
+
+int main(){
+    stream_abr_t abr;
+    stream_abr_init(&abr, 10, 5, 2);
+    CHECK_EQ(abr.quality, 10);
+    CHECK_EQ(abr.size, 5);
+
+    // Bajada: calidad de ABR_QUALITY_STEP en ABR_QUALITY_STEP hasta ABR_QUALITY_WORST, luego resolucion
+    for(int q = 10 + ABR_QUALITY_STEP; q <= ABR_QUALITY_WORST; q += ABR_QUALITY_STEP){
+        CHECK(window(&abr, CONGESTED));
+        CHECK_EQ(abr.quality, q);
+        CHECK_EQ(abr.size, 5);
+    }
+    for(int size = 4; size >= 2; size--){
+        CHECK(window(&abr, CONGESTED));
+        CHECK_EQ(abr.quality, ABR_QUALITY_WORST);
+        CHECK_EQ(abr.size, size);
+    }
+    // En el suelo no hay mas que bajar
+    CHECK(!window(&abr, CONGESTED));
+    CHECK_EQ(abr.size, 2);
+
+    // Sin frames no hay medida
+    stream_abr_window_t empty = {0, 0};
+    CHECK(!stream_abr_update(&abr, &empty));
+
+    // Justo de presupuesto no sube, y corta la racha de ventanas con margen
+    for(int i = 0; i < 10; i++){
+        CHECK(!window(&abr, TIGHT));
+    }
+    CHECK(!window(&abr, CALM));
+    CHECK(!window(&abr, CALM));
+    CHECK(!window(&abr, TIGHT));
+    CHECK_EQ(calm_until_change(&abr, 10), ABR_CALM_WINDOWS);
+
+    // Subida: primero la resolucion, luego la calidad, un escalon cada ABR_CALM_WINDOWS
+    CHECK_EQ(abr.size, 3);
+    CHECK_EQ(abr.quality, ABR_QUALITY_WORST);
+    CHECK_EQ(calm_until_change(&abr, 10), ABR_CALM_WINDOWS);
+    CHECK_EQ(calm_until_change(&abr, 10), ABR_CALM_WINDOWS);
+    CHECK_EQ(abr.size, 5);
+    CHECK_EQ(abr.quality, ABR_QUALITY_WORST);
+    for(int q = ABR_QUALITY_WORST - ABR_QUALITY_STEP; q >= 10; q -= ABR_QUALITY_STEP){
+        CHECK_EQ(calm_until_change(&abr, 10), ABR_CALM_WINDOWS);
+        CHECK_EQ(abr.quality, q);
+        CHECK_EQ(abr.size, 5);
+    }
+    // En el techo se queda
+    CHECK_EQ(calm_until_change(&abr, 20), -1);
+    CHECK_EQ(abr.quality, 10);
+
+    // Una subida que no aguanta: la siguiente espera el doble, y otra vez el doble
+    stream_abr_set_ceiling(&abr, 10, 5);
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(calm_until_change(&abr, 10), ABR_CALM_WINDOWS);
+    CHECK_EQ(abr.quality, 10);
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(calm_until_change(&abr, 20), ABR_CALM_WINDOWS * 2);
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(calm_until_change(&abr, 20), ABR_CALM_WINDOWS * 4);
+    // Una subida que aguanta ABR_CALM_WINDOWS devuelve la espera a la mitad
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(calm_until_change(&abr, 40), ABR_CALM_WINDOWS * 8);
+    for(int i = 0; i < ABR_CALM_WINDOWS; i++){
+        window(&abr, TIGHT);
+    }
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(calm_until_change(&abr, 40), ABR_CALM_WINDOWS * 4);
+
+    // Techo del usuario peor que ABR_QUALITY_WORST: no se toca la calidad, se baja directamente la resolucion
+    stream_abr_set_ceiling(&abr, 50, 4);
+    CHECK(window(&abr, CONGESTED));
+    CHECK_EQ(abr.quality, 50);
+    CHECK_EQ(abr.size, 3);
+
+    // Un techo por debajo del minimo se queda en el minimo
+    stream_abr_set_ceiling(&abr, 10, 0);
+    CHECK_EQ(abr.size, 2);
+    CHECK_EQ(abr.calm, 0);
+
+    return check_done("test_stream_abr");
+}
@@ -0,0 +1,145 @@
+#include "stream_preview.h"
+#include "gray_jpeg.h"
+#include "img_converters.h"
+#include "host.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <jpeglib.h>
+
+// La vista previa con el decodificador de verdad (esp_jpg_decode sobre libjpeg, que reduce al
+// descomprimir como tjpgd): a cada escala las medidas y la luminancia de la imagen reducida, el JPEG
+// en gris que sale se puede leer, los buffers se reutilizan y un JPEG roto solo devuelve false.
+
+#define W 320
+#define H 240
+
+typedef struct {
+        std::vector<uint8_t> buf;
+} sink_t;
+
+static size_t sink_write(void * arg, size_t index, const void * data, size_t len){
+    sink_t * s = (sink_t *)arg;
+    s->buf.insert(s->buf.end(), (const uint8_t *)data, (const uint8_t *)data + len);
+    return len;
+}
+
+// Degradados en los tres canales: nada que el JPEG de calidad 90 vaya a estropear mucho
+static std::vector<uint8_t> scene(){
+    std::vector<uint8_t> rgb(W * H * 3);
+    for(int y = 0; y < H; y++){
+        for(int x = 0; x < W; x++){
+            uint8_t * p = &rgb[(y * W + x) * 3];
+            p[0] = x * 255 / W;
+            p[1] = y * 255 / H;
+            p[2] = 128 + (x - y) / 4;
+        }
+    }
+    return rgb;
+}
+
+// Luminancia media de cada bloque scale x scale, lo que deberia salir a esa escala
+static std::vector<uint8_t> expected(const std::vector<uint8_t> & rgb, int scale){
+    int w = W / scale, h = H / scale;
+    std::vector<uint8_t> out(w * h);
+    for(int y = 0; y < h; y++){
+        for(int x = 0; x < w; x++){
+            int sum[3] = {0, 0, 0};
+            for(int dy = 0; dy < scale; dy++){
+                for(int dx = 0; dx < scale; dx++){
+                    for(int c = 0; c < 3; c++){
+                        sum[c] += rgb[((y * scale + dy) * W + x * scale + dx) * 3 + c];
+                    }
+                }
+            }
+            uint8_t mean[3] = {(uint8_t)(sum[0] / (scale * scale)), (uint8_t)(sum[1] / (scale * scale)),
+                               (uint8_t)(sum[2] / (scale * scale))};
+            gray_from_rgb888(mean, &out[y * w + x], 1);
+        }
+    }
+    return out;
+}
+
+static double mean_abs_diff(const uint8_t * a, const uint8_t * b, size_t n){
+    double d = 0;
+    for(size_t i = 0; i < n; i++){
+        d += abs((int)a[i] - b[i]);
+    }
+    return d / n;
+}
+
+// Medidas y canales del JPEG con libjpeg
+static bool jpeg_info(const uint8_t * jpg, size_t len, int * width, int * height, int * components){
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char *)jpg, len);
+    bool ok = jpeg_read_header(&cinfo, TRUE) == JPEG_HEADER_OK;
+    *width = cinfo.image_width;
+    *height = cinfo.image_height;
+    *components = cinfo.num_components;
+    jpeg_destroy_decompress(&cinfo);
+    return ok;
+}
+
+int main(){
+    std::vector<uint8_t> rgb = scene();
+    camera_fb_t fb = {rgb.data(), rgb.size(), W, H, PIXFORMAT_RGB888};
+    sink_t jpg;
+    CHECK(frame2jpg_cb(&fb, 90, sink_write, &jpg));
+    frame_t f = {jpg.buf.data(), jpg.buf.size(), jpg.buf.size(), W, H, 1, 0, 1};
+
+    CHECK(stream_preview_scale_ok(1) && stream_preview_scale_ok(8));
+    CHECK(!stream_preview_scale_ok(3) && !stream_preview_scale_ok(0) && !stream_preview_scale_ok(16));
+
+    // Cada escala: medidas reducidas y la luminancia de la media de cada bloque
+    uint8_t * gray = NULL;
+    size_t capacity = 0;
+    for(int scale = 1; scale <= 8; scale *= 2){
+        int width = 0, height = 0;
+        CHECK(stream_preview_decode(&f, scale, &gray, &capacity, &width, &height));
+        CHECK_EQ(width, W / scale);
+        CHECK_EQ(height, H / scale);
+        if(width != W / scale || height != H / scale){
+            continue;
+        }
+        std::vector<uint8_t> want = expected(rgb, scale);
+        double diff = mean_abs_diff(gray, want.data(), want.size());
+        printf("escala 1/%d: %dx%d, diferencia media %.2f\n", scale, width, height, diff);
+        CHECK(diff < 3);
+    }
+    // Despues de la escala 1 el buffer ya no crece
+    CHECK_EQ(capacity, W * H);
+
+    // Codificada: un JPEG de un canal a la escala pedida; el segundo frame no pide memoria
+    preview_buf_t out = {NULL, 0, 0};
+    CHECK(stream_preview_encode(&f, 2, &out));
+    int width, height, components;
+    CHECK(jpeg_info(out.buf, out.len, &width, &height, &components));
+    CHECK_EQ(width, W / 2);
+    CHECK_EQ(height, H / 2);
+    CHECK_EQ(components, 1);
+    printf("vista previa 1/2: %zu bytes, el frame %zu\n", out.len, f.len);
+    CHECK(out.len < f.len / 2);
+    uint32_t allocs = host_heap_allocs();
+    size_t out_capacity = out.capacity;
+    CHECK(stream_preview_encode(&f, 2, &out));
+    CHECK_EQ(host_heap_allocs(), allocs);
+    CHECK_EQ(out.capacity, out_capacity);
+
+    // Roto: cortado a la mitad y con basura en lugar de las tablas
+    frame_t cut = f;
+    cut.len = f.len / 2;
+    CHECK(!stream_preview_encode(&cut, 2, &out));
+    std::vector<uint8_t> junk(jpg.buf);
+    for(size_t i = 2; i < 200; i++){
+        junk[i] = i * 37;
+    }
+    frame_t bad = f;
+    bad.buf = junk.data();
+    CHECK(!stream_preview_decode(&bad, 4, &gray, &capacity, &width, &height));
+
+    return check_done("test_stream_preview");
+}
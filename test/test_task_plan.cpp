@@ -0,0 +1,56 @@
+#include "task_plan.h"
+#include "host.h"
+#include "check.h"
+
+// task_plan.cpp de verdad: una tarea que se borra sola no se vuelve a mirar, y sin core_id en
+// httpd_config_t (IDF 3.2) los httpd no dicen un nucleo que no tienen.
+
+static void exit_task(void * arg){
+    task_plan_exit(TASK_WS);
+}
+
+static void wait_exit(task_id_t id){
+    task_stats_t st;
+    for(int i = 0; i < 1000; i++){
+        task_plan_stats(id, &st);
+        if(!st.running){
+            return;
+        }
+        vTaskDelay(1);
+    }
+}
+
+int main(){
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    task_plan_httpd(TASK_CAMERA_HTTPD, &config);
+    task_stats_t st;
+    task_plan_stats(TASK_CAMERA_HTTPD, &st);
+    CHECK_EQ(st.core, -1);
+    CHECK_EQ(config.stack_size, st.stack);
+    task_plan_stats(TASK_CAPTURE, &st);
+    CHECK_EQ(st.core, 1);
+
+    task_plan_start();
+    TaskHandle_t t = NULL;
+    CHECK(task_plan_create(TASK_WS, exit_task, NULL, &t));
+    wait_exit(TASK_WS);
+    vTaskDelay(10);
+    host_timer_fire(3);
+    task_plan_sample();
+    task_plan_stats(TASK_WS, &st);
+    CHECK(!st.running);
+    CHECK_EQ(host_deleted_stack_reads(), 0);
+
+    // Muestreo mientras las tareas se borran
+    for(int i = 0; i < 200; i++){
+        task_plan_create(TASK_WS, exit_task, NULL, &t);
+        host_timer_fire(3);
+        task_plan_sample();
+    }
+    wait_exit(TASK_WS);
+    vTaskDelay(10);
+    host_timer_fire(3);
+    task_plan_sample();
+    CHECK_EQ(host_deleted_stack_reads(), 0);
+    return check_done("test_task_plan");
+}
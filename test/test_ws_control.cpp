@@ -0,0 +1,303 @@
+#include "ws_control.h"
+#include "control.h"
+#include "actuators.h"
+#include "device_state.h"
+#include "esp_timer.h"
+#include "check.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+// El canal WebSocket: las tramas y los comandos de 8 bytes sin sockets (cortadas, opcodes malos,
+// comandos a medias) y luego la tarea de verdad por loopback, con un navegador que abre la conexion
+// y no acaba el upgrade mientras otro conduce. El puerto lo pone CMakeLists.txt.
+
+void mjpeg_stream_abr_ceiling(int quality, int framesize){}
+void mjpeg_stream_abr_enable(bool enable){}
+void event_stream_set_period(int ms){}
+bool motion_stage_enable(bool enable){ return true; }
+void motion_stage_set_threshold(int threshold){}
+void clip_server_set_rate(int kbps){}
+
+#define CH_SPEED 3              // posiciones en ws_channels
+#define CH_DRIVEX 9
+
+static int32_t state_get(state_field_t field){
+    int32_t values[STATE_FIELDS];
+    state_snapshot(values);
+    return values[field];
+}
+
+// Trama del cliente con mascara, como la manda el navegador
+static size_t ws_frame(uint8_t opcode, const uint8_t * payload, size_t len, uint8_t * out){
+    static const uint8_t mask[4] = {0x37, 0xfa, 0x21, 0x3d};
+    size_t hdr = 2;
+    out[0] = 0x80 | opcode;
+    if(len > 125){
+        out[1] = 0x80 | 126;
+        out[2] = len >> 8;
+        out[3] = len & 0xff;
+        hdr = 4;
+    } else {
+        out[1] = 0x80 | len;
+    }
+    memcpy(out + hdr, mask, 4);
+    for(size_t i = 0; i < len; i++){
+        out[hdr + 4 + i] = payload[i] ^ mask[i & 3];
+    }
+    return hdr + 4 + len;
+}
+
+static void command(uint8_t * p, uint8_t opcode, uint8_t channel, int16_t value, uint32_t seq){
+    p[0] = opcode;
+    p[1] = channel;
+    p[2] = value & 0xff;
+    p[3] = (uint16_t)value >> 8;
+    memcpy(p + 4, &seq, 4);
+}
+
+static int connect_ws(){
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(WS_CONTROL_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // La tarea abre el puerto en su hilo: se reintenta hasta que escucha
+    for(int i = 0; i < 200; i++){
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0){
+            struct timeval tv = {5, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            return fd;
+        }
+        close(fd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+#define RFC_KEY "dGhlIHNhbXBsZSBub25jZQ=="
+#define RFC_ACCEPT "s3pPLMBiTxaQ9kYGzzhZRbK+xOo="
+
+// Upgrade completo; false si no llega el 101 con el Sec-WebSocket-Accept del RFC
+static bool upgrade(int fd){
+    const char * req = "GET / HTTP/1.1\r\nHost: car\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                       "Sec-WebSocket-Key: " RFC_KEY "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    send(fd, req, strlen(req), 0);
+    std::string resp;
+    char c;
+    while(resp.find("\r\n\r\n") == std::string::npos && recv(fd, &c, 1, 0) == 1){
+        resp += c;
+    }
+    return !resp.compare(0, 12, "HTTP/1.1 101") && resp.find("Sec-WebSocket-Accept: " RFC_ACCEPT "\r\n") != std::string::npos;
+}
+
+// Lee una trama del servidor (sin mascara); opcode o -1 si se cierra o no llega
+static int read_frame(int fd, uint8_t * payload, size_t * len){
+    uint8_t hdr[4];
+    if(recv(fd, hdr, 2, MSG_WAITALL) != 2){
+        return -1;
+    }
+    size_t n = hdr[1] & 0x7f;
+    if(n == 126){
+        if(recv(fd, hdr + 2, 2, MSG_WAITALL) != 2){
+            return -1;
+        }
+        n = hdr[2] << 8 | hdr[3];
+    }
+    if(n && recv(fd, payload, n, MSG_WAITALL) != (ssize_t)n){
+        return -1;
+    }
+    *len = n;
+    return hdr[0] & 0x0f;
+}
+
+// true si el servidor cierra la conexion antes de timeout_ms
+static bool closed_within(int fd, int timeout_ms){
+    struct timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    char c;
+    ssize_t r;
+    while((r = recv(fd, &c, 1, 0)) > 0){
+    }
+    return r == 0;
+}
+
+int main(){
+    actuators_start();
+    uint8_t buf[512];
+    uint8_t payload[300];
+    ws_frame_t f;
+
+    // Clave del RFC 6455
+    char accept[32];
+    CHECK_EQ(ws_handshake_accept("GET / HTTP/1.1\r\nsec-websocket-key:  " RFC_KEY "\r\n\r\n", accept, sizeof(accept)), 28);
+    CHECK(!memcmp(accept, RFC_ACCEPT, 28));
+    CHECK_EQ(ws_handshake_accept("GET / HTTP/1.1\r\nHost: car\r\n\r\n", accept, sizeof(accept)), 0);
+    CHECK_EQ(ws_handshake_accept("GET / HTTP/1.1\r\nSec-WebSocket-Key: \r\n\r\n", accept, sizeof(accept)), 0);
+
+    // Trama: cortada en cualquier sitio falta por llegar; entera se desenmascara
+    for(size_t i = 0; i < sizeof(payload); i++){
+        payload[i] = i * 7;
+    }
+    size_t n = ws_frame(0x2, payload, 16, buf);
+    for(size_t cut = 0; cut < n; cut++){
+        CHECK_EQ(ws_frame_parse(buf, cut, &f), 0);
+    }
+    CHECK_EQ(ws_frame_parse(buf, n, &f), (int)n);
+    CHECK_EQ(f.opcode, 0x2);
+    CHECK_EQ(f.len, 16);
+    CHECK(!memcmp(f.payload, payload, 16));
+    // Dos seguidas: solo la primera
+    n = ws_frame(0x9, payload, 3, buf);
+    size_t second = ws_frame(0x2, payload, 8, buf + n);
+    CHECK_EQ(ws_frame_parse(buf, n + second, &f), (int)n);
+    CHECK_EQ(f.opcode, 0x9);
+    // Longitud de 16 bits, tambien cortada justo en la longitud
+    n = ws_frame(0x2, payload, 200, buf);
+    CHECK_EQ(ws_frame_parse(buf, 3, &f), 0);
+    CHECK_EQ(ws_frame_parse(buf, n - 1, &f), 0);
+    CHECK_EQ(ws_frame_parse(buf, n, &f), (int)n);
+    CHECK_EQ(f.len, 200);
+    CHECK(!memcmp(f.payload, payload, 200));
+
+    // Lo que cierra: sin mascara, 64 bits, mas que el buffer, opcodes reservados, control de mas de 125
+    n = ws_frame(0x2, payload, 8, buf);
+    buf[1] &= 0x7f;
+    CHECK_EQ(ws_frame_parse(buf, n, &f), -1);
+    n = ws_frame(0x2, payload, 8, buf);
+    buf[1] = 0x80 | 127;
+    CHECK_EQ(ws_frame_parse(buf, n, &f), -1);
+    n = ws_frame(0x2, payload, 300, buf);
+    CHECK_EQ(ws_frame_parse(buf, n, &f), -1);
+    for(uint8_t op = 0; op < 16; op++){
+        n = ws_frame(op, payload, 8, buf);
+        bool reserved = (op > 0x2 && op < 0x8) || op > 0xa;
+        CHECK_EQ(ws_frame_parse(buf, n, &f), reserved ? -1 : (int)n);
+    }
+    n = ws_frame(0x9, payload, 126, buf);
+    CHECK_EQ(ws_frame_parse(buf, n, &f), -1);
+
+    // Comandos: ACK/NACK en el sitio, con la secuencia intacta
+    uint8_t cmds[6 * WS_FRAME_LEN + 5];
+    command(cmds, WS_OP_SET, CH_SPEED, 200, 1);
+    command(cmds + 8, WS_OP_SET, CH_DRIVEX, -50, 2);
+    command(cmds + 16, WS_OP_SET, 200, 1, 3);               // canal que no existe
+    command(cmds + 24, 0x07, CH_SPEED, 10, 4);              // opcode que no existe
+    command(cmds + 32, WS_OP_PING, 0, 0, 0xdeadbeef);
+    command(cmds + 40, WS_OP_SET, CH_SPEED, 999, 6);        // se recorta a 255
+    memset(cmds + 48, 0x01, 5);                             // comando a medias: ni se aplica ni se contesta
+    CHECK_EQ(ws_commands_run(cmds, sizeof(cmds)), 6 * WS_FRAME_LEN);
+    const uint8_t expect[6] = {WS_OP_ACK, WS_OP_ACK, WS_OP_NACK, WS_OP_NACK, WS_OP_ACK, WS_OP_ACK};
+    for(int i = 0; i < 6; i++){
+        CHECK_EQ(cmds[i * 8], expect[i]);
+        uint32_t seq;
+        memcpy(&seq, cmds + i * 8 + 4, 4);
+        CHECK_EQ(seq, i == 4 ? 0xdeadbeef : (uint32_t)i + 1);
+    }
+    CHECK_EQ(cmds[48], 0x01);
+    CHECK_EQ(state_get(STATE_SPEED), 255);
+    CHECK_EQ(state_get(STATE_DRIVEX), -50);
+    CHECK_EQ(ws_commands_run(cmds, 7), 0);
+    CHECK_EQ(ws_commands_run(cmds, 0), 0);
+
+    // Por loopback: uno abre y no acaba el upgrade, otro conduce sin esperarle
+    ws_control_start();
+    int slow = connect_ws();
+    CHECK(slow >= 0);
+    const char * half = "GET / HTTP/1.1\r\nHost: car\r\nUpgrade: websocket\r\n";
+    send(slow, half, strlen(half), 0);
+    usleep(50000);
+    int64_t t0 = esp_timer_get_time();
+    int fd = connect_ws();
+    CHECK(upgrade(fd));
+    int64_t handshake_us = esp_timer_get_time() - t0;
+    printf("upgrade con otro a medias: %lld us\n", (long long)handshake_us);
+    CHECK(handshake_us < WS_HANDSHAKE_TIMEOUT_MS * 1000LL / 4);
+
+    // Cada comando con su ACK mientras el lento sigue colgado
+    int64_t worst = 0;
+    for(int i = 0; i < 50; i++){
+        uint8_t c[WS_FRAME_LEN], reply[300];
+        command(c, WS_OP_SET, CH_SPEED, 100 + i, 100 + i);
+        n = ws_frame(0x2, c, sizeof(c), buf);
+        int64_t s = esp_timer_get_time();
+        send(fd, buf, n, 0);
+        size_t len = 0;
+        CHECK_EQ(read_frame(fd, reply, &len), 0x2);
+        int64_t us = esp_timer_get_time() - s;
+        worst = us > worst ? us : worst;
+        CHECK_EQ(len, WS_FRAME_LEN);
+        CHECK_EQ(reply[0], WS_OP_ACK);
+        CHECK_EQ(reply[4], 100 + i);
+    }
+    printf("peor comando con otro a medias: %lld us\n", (long long)worst);
+    CHECK(worst < WS_HANDSHAKE_TIMEOUT_MS * 1000LL / 4);
+    CHECK_EQ(state_get(STATE_SPEED), 149);
+
+    // Una trama que llega en dos trozos separados: una sola respuesta con todo
+    uint8_t two[2 * WS_FRAME_LEN], reply[300];
+    command(two, WS_OP_SET, CH_SPEED, 42, 7);
+    command(two + 8, WS_OP_PING, 0, 0, 8);
+    n = ws_frame(0x2, two, sizeof(two), buf);
+    send(fd, buf, 5, 0);
+    usleep(30000);
+    send(fd, buf + 5, n - 5, 0);
+    size_t len = 0;
+    CHECK_EQ(read_frame(fd, reply, &len), 0x2);
+    CHECK_EQ(len, 2 * WS_FRAME_LEN);
+    CHECK_EQ(reply[0], WS_OP_ACK);
+    CHECK_EQ(reply[8], WS_OP_ACK);
+    CHECK_EQ(state_get(STATE_SPEED), 42);
+
+    // Ping de WebSocket: pong con lo mismo
+    n = ws_frame(0x9, (const uint8_t *)"hola", 4, buf);
+    send(fd, buf, n, 0);
+    CHECK_EQ(read_frame(fd, reply, &len), 0xA);
+    CHECK_EQ(len, 4);
+    CHECK(!memcmp(reply, "hola", 4));
+
+    // El lento se cierra al vencer su plazo, no antes
+    CHECK(closed_within(slow, WS_HANDSHAKE_TIMEOUT_MS + 1000));
+    int64_t slow_us = esp_timer_get_time() - t0;
+    CHECK(slow_us >= WS_HANDSHAKE_TIMEOUT_MS * 1000LL - 100000);
+    close(slow);
+
+    // Upgrade sin clave: se cierra enseguida
+    int bad = connect_ws();
+    const char * nokey = "GET / HTTP/1.1\r\nHost: car\r\n\r\n";
+    send(bad, nokey, strlen(nokey), 0);
+    CHECK(closed_within(bad, 500));
+    close(bad);
+
+    // Opcode reservado: se cierra la sesion
+    n = ws_frame(0x3, payload, 8, buf);
+    send(fd, buf, n, 0);
+    CHECK(closed_within(fd, 1000));
+    close(fd);
+
+    // El siguiente navegador entra
+    fd = connect_ws();
+    CHECK(upgrade(fd));
+    // La tarea cuenta la sesion despues de mandar el 101: un latido con su ACK asegura que ya lo ha hecho
+    uint8_t ping[WS_FRAME_LEN];
+    command(ping, WS_OP_PING, 0, 0, 9);
+    n = ws_frame(0x2, ping, sizeof(ping), buf);
+    send(fd, buf, n, 0);
+    CHECK_EQ(read_frame(fd, reply, &len), 0x2);
+    uint32_t commands, sessions;
+    ws_control_stats(&commands, &sessions);
+    CHECK_EQ(sessions, 2);
+    close(fd);
+
+    int res = check_done("test_ws_control");
+    // La tarea del WebSocket sigue en su hilo
+    fflush(stdout);
+    _exit(res);
+}
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Genera camera_index.h a partir de html/: minimiza, comprime con gzip y deja cada fichero
+# como array PROGMEM dentro de una tabla de assets (ruta, tipo, bytes, ETag).
+#
+# El CSS y el JS se publican con el hash del contenido en el nombre (style.1a2b3c4d.css) y
+# la pagina se reescribe para apuntar a esos nombres: el navegador los guarda sin revalidar
+# y solo la pagina (pequena) se vuelve a pedir al reconectar.
+#
+# Hay que ejecutarlo despues de tocar la pagina, antes de compilar en el IDE de Arduino:
+#   python3 tools/embed_html.py
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, 'html')
+OUT = os.path.join(ROOT, 'camera_index.h')
+
+# Fichero, tipo MIME. La pagina va la ultima: necesita los nombres con hash de los demas.
+ASSETS = [
+    ('style.css', 'text/css'),
+    ('joy.js', 'application/javascript'),
+    ('app.js', 'application/javascript'),
+]
+PAGE = ('index.html', 'text/html')
+
+
+def strip_block_comments(text):
+    # La cabecera de licencia (MIT de joy.js) tiene que seguir viajando con el codigo
+    def keep_license(m):
+        return m.group(0) if 'License' in m.group(0) else ''
+    return re.sub(r'/\*.*?\*/', keep_license, text, flags=re.S)
+
+
+def minify_lines(text, line_comment=None):
+    # Se conservan los saltos de linea: el JS no lleva todos los ; y depende de ellos
+    lines = (line.strip() for line in text.splitlines())
+    if line_comment:
+        lines = (line for line in lines if not line.startswith(line_comment))
+    return '\n'.join(line for line in lines if line) + '\n'
+
+
+def minify_css(css):
+    return minify_lines(strip_block_comments(css))
+
+
+def minify_js(js):
+    return minify_lines(strip_block_comments(js), '//')
+
+
+def minify(html):
+    # Comentarios /* */ solo dentro de <style> y <script>, en el HTML no significan nada
+    def inner(m):
+        return strip_block_comments(m.group(0))
+    html = re.sub(r'<(style|script)\b.*?</\1>', inner, html, flags=re.S | re.I)
+    html = re.sub(r'<!--.*?-->', '', html, flags=re.S)
+    return minify_lines(html)
+
+
+MINIFY = {
+    'text/html': minify,
+    'text/css': minify_css,
+    'application/javascript': minify_js,
+}
+
+
+def c_ident(name):
+    return re.sub(r'\W', '_', name) + '_gz'
+
+
+def c_array(name, data):
+    out = ['static const uint8_t %s[] PROGMEM = {' % name]
+    for i in range(0, len(data), 16):
+        out.append('  ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    out.append('};')
+    return '\n'.join(out)
+
+
+def build(name, mime, text):
+    raw = len(text.encode('utf-8'))
+    mini = MINIFY[mime](text).encode('utf-8')
+    gz = gzip.compress(mini, compresslevel=9, mtime=0)
+    digest = hashlib.sha1(gz).hexdigest()
+    return {'name': name, 'mime': mime, 'raw': raw, 'mini': len(mini), 'gz': gz, 'digest': digest}
+
+
+def main():
+    built = []
+    page = open(os.path.join(SRC, PAGE[0]), encoding='utf-8').read()
+    for name, mime in ASSETS:
+        with open(os.path.join(SRC, name), encoding='utf-8') as f:
+            a = build(name, mime, f.read())
+        stem, ext = os.path.splitext(name)
+        a['path'] = '/%s.%s%s' % (stem, a['digest'][:8], ext)
+        a['immutable'] = True
+        ref = re.compile(r'(href|src)="%s"' % re.escape(name))
+        if not ref.search(page):
+            sys.exit('%s no aparece en %s' % (name, PAGE[0]))
+        page = ref.sub(lambda m: '%s="%s"' % (m.group(1), a['path'][1:]), page)
+        built.append(a)
+
+    a = build(PAGE[0], PAGE[1], page)
+    a['path'] = '/'
+    a['immutable'] = False
+    built.append(a)
+
+    out = [
+        '// Generado por tools/embed_html.py a partir de html/, no editar a mano',
+        '#ifndef CAMERA_INDEX_H',
+        '#define CAMERA_INDEX_H',
+        '',
+        '#include <stdint.h>',
+        '#include "Arduino.h"',
+        '#include "static_assets.h"',
+        '',
+    ]
+    for a in built:
+        out.append('// %s: %d bytes originales, %d minimizado, %d con gzip'
+                   % (a['name'], a['raw'], a['mini'], len(a['gz'])))
+        out.append(c_array(c_ident(a['name']), a['gz']))
+        out.append('')
+    out.append('static const static_asset_t static_assets[] = {')
+    for a in built:
+        out.append('    { "%s", "%s", %s, %d, "\\"%s\\"", %s },'
+                   % (a['path'], a['mime'], c_ident(a['name']), len(a['gz']), a['digest'][:16],
+                      'true' if a['immutable'] else 'false'))
+    out.append('};')
+    out.append('#define STATIC_ASSET_COUNT %d' % len(built))
+    out.append('')
+    out.append('#endif')
+    out.append('')
+    with open(OUT, 'w', newline='\r\n') as f:
+        f.write('\n'.join(out))
+
+    for a in built:
+        print('%-10s -> %-22s %6d bytes -> minimizado %6d -> gzip %5d (%.1f%%)'
+              % (a['name'], a['path'], a['raw'], a['mini'], len(a['gz']), 100.0 * len(a['gz']) / a['raw']))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,345 @@
+#include "ws_control.h"
+#include "control.h"
+#include "actuators.h"
+#include "metrics.h"
+#include "task_plan.h"
+#include "esp_timer.h"
+#include "Arduino.h"
+#include "lwip/sockets.h"
+#include "mbedtls/sha1.h"
+#include "mbedtls/base64.h"
+
+// Servidor WebSocket minimo para el joystick, botones y deslizadores.
+// Una conexion persistente en vez de un GET /control por cada evento.
+// El esp_http_server de este core no sabe de WebSocket, por eso va aparte con sockets de lwip.
+// Solo hay un operador: si se conecta otro navegador, el anterior se cierra.
+// Todos los sockets van sin bloqueo y un solo select: un upgrade lento no para los comandos del que conduce.
+
+#define WS_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define WS_RX_BUF 256
+
+// Orden de los canales, tiene que coincidir con ctlChannels en INDEX_HTML
+static const char * ws_channels[] = {"framesize", "quality", "flash", "speed", "nostop", "servo", "servopan", "servo3", "car",
+                                     "drivex", "drivey"};
+#define WS_CHANNELS (sizeof(ws_channels) / sizeof(ws_channels[0]))
+
+static TaskHandle_t ws_task_handle = NULL;
+static uint32_t ws_commands = 0;
+static uint32_t ws_sessions = 0;
+
+// Upgrades a medias a la vez; otro mas cierra el mas viejo
+#define WS_PENDING 2
+
+// Conexion aceptada que aun no ha mandado la peticion de upgrade entera
+typedef struct {
+        int fd;                 // -1 si el hueco esta libre
+        size_t len;
+        int64_t since;
+        char req[WS_HANDSHAKE_MAX];
+} ws_pending_t;
+
+static ws_pending_t pending[WS_PENDING];
+
+size_t ws_handshake_accept(const char * req, char * accept, size_t size){
+    const char * key = strcasestr(req, "Sec-WebSocket-Key:");
+    if(!key){
+        return 0;
+    }
+    key += strlen("Sec-WebSocket-Key:");
+    while(*key == ' '){
+        key++;
+    }
+    size_t key_len = strcspn(key, "\r\n ");
+    if(!key_len || key_len > 64){
+        return 0;
+    }
+
+    char concat[64 + sizeof(WS_GUID)];
+    memcpy(concat, key, key_len);
+    memcpy(concat + key_len, WS_GUID, sizeof(WS_GUID) - 1);
+    unsigned char sha[20];
+    mbedtls_sha1_ret((const unsigned char *)concat, key_len + sizeof(WS_GUID) - 1, sha);
+    size_t accept_len = 0;
+    if(mbedtls_base64_encode((unsigned char *)accept, size, &accept_len, sha, sizeof(sha))){
+        return 0;
+    }
+    return accept_len;
+}
+
+// Lee lo que haya llegado de la peticion de upgrade sin esperar. 1 completa, 0 falta, -1 para cerrar.
+static int ws_pending_read(ws_pending_t * p){
+    int r = recv(p->fd, p->req + p->len, sizeof(p->req) - 1 - p->len, MSG_DONTWAIT);
+    if(r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+        return 0;
+    }
+    if(r <= 0){
+        return -1;
+    }
+    p->len += r;
+    p->req[p->len] = 0;
+    if(strstr(p->req, "\r\n\r\n")){
+        return 1;
+    }
+    return p->len < sizeof(p->req) - 1 ? 0 : -1;
+}
+
+static bool ws_handshake_reply(int fd, const char * req){
+    char accept[32];
+    size_t accept_len = ws_handshake_accept(req, accept, sizeof(accept));
+    if(!accept_len){
+        return false;
+    }
+    char resp[160];
+    int n = snprintf(resp, sizeof(resp),
+                     "HTTP/1.1 101 Switching Protocols\r\n"
+                     "Upgrade: websocket\r\n"
+                     "Connection: Upgrade\r\n"
+                     "Sec-WebSocket-Accept: %.*s\r\n\r\n", (int)accept_len, accept);
+    // Socket recien abierto: la respuesta cabe entera en su buffer de envio
+    return send(fd, resp, n, MSG_DONTWAIT) == n;
+}
+
+// Del servidor al cliente las tramas van sin mascara. Sin esperar: un cliente que no lee se cierra.
+static bool ws_send(int fd, uint8_t opcode, const uint8_t * payload, size_t len){
+    uint8_t frame[4 + WS_RX_BUF];
+    size_t hdr = 2;
+    if(len > WS_RX_BUF){
+        return false;
+    }
+    frame[0] = 0x80 | opcode;
+    if(len > 125){
+        frame[1] = 126;
+        frame[2] = len >> 8;
+        frame[3] = len & 0xff;
+        hdr = 4;
+    } else {
+        frame[1] = len;
+    }
+    memcpy(frame + hdr, payload, len);
+    return send(fd, frame, hdr + len, MSG_DONTWAIT) == (int)(hdr + len);
+}
+
+size_t ws_commands_run(uint8_t * payload, size_t len){
+    size_t i;
+    for(i = 0; i + WS_FRAME_LEN <= len; i += WS_FRAME_LEN){
+        uint8_t * p = payload + i;
+        uint8_t opcode = p[0];
+        uint8_t channel = p[1];
+        int16_t value = (int16_t)(p[2] | (p[3] << 8));
+        int res = -1;
+
+        if(opcode == WS_OP_SET && channel < WS_CHANNELS){
+            int64_t start = esp_timer_get_time();
+            res = control_apply(ws_channels[channel], value);
+            metric_observe(&metric_control_ws_us, esp_timer_get_time() - start);
+            ws_commands++;
+        } else if(opcode == WS_OP_PING){
+            // Latido de la pagina con el joystick quieto, mantiene armado el failsafe
+            actuators_heartbeat();
+            res = 0;
+        }
+        p[0] = res ? WS_OP_NACK : WS_OP_ACK;
+    }
+    return i;
+}
+
+int ws_frame_parse(uint8_t * buf, size_t len, ws_frame_t * frame){
+    if(len < 2){
+        return 0;
+    }
+    uint8_t opcode = buf[0] & 0x0f;
+    bool masked = buf[1] & 0x80;
+    size_t payload_len = buf[1] & 0x7f;
+    size_t hdr = 2;
+    // 0x3-0x7 y 0xb-0xf estan reservados: el RFC pide cerrar
+    if((opcode > 0x2 && opcode < 0x8) || opcode > 0xa){
+        return -1;
+    }
+    if(payload_len == 126){
+        if(len < 4){
+            return 0;
+        }
+        payload_len = (buf[2] << 8) | buf[3];
+        hdr = 4;
+    } else if(payload_len == 127){
+        return -1;
+    }
+    if(!masked || hdr + 4 + payload_len > WS_RX_BUF || ((opcode & 0x8) && payload_len > 125)){
+        return -1;
+    }
+    if(len < hdr + 4 + payload_len){
+        return 0;
+    }
+
+    const uint8_t * mask = buf + hdr;
+    uint8_t * payload = buf + hdr + 4;
+    for(size_t i = 0; i < payload_len; i++){
+        payload[i] ^= mask[i & 3];
+    }
+    frame->opcode = opcode;
+    frame->payload = payload;
+    frame->len = payload_len;
+    return hdr + 4 + payload_len;
+}
+
+// Procesa una trama completa del buffer. Bytes consumidos, 0 si falta por llegar, -1 para cerrar.
+static int ws_process(int fd, uint8_t * buf, size_t len){
+    ws_frame_t frame;
+    int used = ws_frame_parse(buf, len, &frame);
+    if(used <= 0){
+        return used;
+    }
+    bool sent = true;
+    switch(frame.opcode){
+        case 0x2: {
+            size_t reply = ws_commands_run(frame.payload, frame.len);
+            sent = !reply || ws_send(fd, 0x2, frame.payload, reply);
+            break;
+        }
+        case 0x8:
+            ws_send(fd, 0x8, frame.payload, frame.len < 2 ? frame.len : 2);
+            return -1;
+        case 0x9:
+            sent = ws_send(fd, 0xA, frame.payload, frame.len);
+            break;
+        default:
+            // Texto, continuaciones y pong no llevan comandos
+            break;
+    }
+    return sent ? used : -1;
+}
+
+static void ws_pending_drop(ws_pending_t * p){
+    close(p->fd);
+    p->fd = -1;
+}
+
+static void ws_task(void * arg){
+    int listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(WS_CONTROL_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if(bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 2) < 0){
+        close(listen_fd);
+        task_plan_exit(TASK_WS);
+        return;
+    }
+    for(int i = 0; i < WS_PENDING; i++){
+        pending[i].fd = -1;
+    }
+
+    int client = -1;
+    uint8_t rx[WS_RX_BUF];
+    size_t rx_len = 0;
+    while(true){
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(listen_fd, &rfds);
+        int maxfd = listen_fd;
+        if(client >= 0){
+            FD_SET(client, &rfds);
+            maxfd = client > maxfd ? client : maxfd;
+        }
+        // Sin upgrades a medias se espera sin plazo; con alguno, hasta que venza el mas viejo
+        int64_t oldest = INT64_MAX;
+        for(int i = 0; i < WS_PENDING; i++){
+            if(pending[i].fd >= 0){
+                FD_SET(pending[i].fd, &rfds);
+                maxfd = pending[i].fd > maxfd ? pending[i].fd : maxfd;
+                oldest = pending[i].since < oldest ? pending[i].since : oldest;
+            }
+        }
+        struct timeval tv;
+        struct timeval * timeout = NULL;
+        if(oldest != INT64_MAX){
+            int64_t left = oldest + WS_HANDSHAKE_TIMEOUT_MS * 1000LL - esp_timer_get_time();
+            left = left > 0 ? left : 0;
+            tv.tv_sec = left / 1000000;
+            tv.tv_usec = left % 1000000;
+            timeout = &tv;
+        }
+        int ready = select(maxfd + 1, &rfds, NULL, NULL, timeout);
+        if(ready < 0){
+            continue;
+        }
+        if(!ready){
+            FD_ZERO(&rfds);
+        }
+
+        if(client >= 0 && FD_ISSET(client, &rfds)){
+            int r = recv(client, rx + rx_len, sizeof(rx) - rx_len, MSG_DONTWAIT);
+            int used = r > 0 || (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) ? 0 : -1;
+            if(r > 0){
+                rx_len += r;
+                while(rx_len && (used = ws_process(client, rx, rx_len)) > 0){
+                    memmove(rx, rx + used, rx_len - used);
+                    rx_len -= used;
+                }
+            }
+            if(used < 0){
+                close(client);
+                client = -1;
+            }
+        }
+
+        int64_t now = esp_timer_get_time();
+        for(int i = 0; i < WS_PENDING; i++){
+            ws_pending_t * p = &pending[i];
+            if(p->fd < 0){
+                continue;
+            }
+            int res = FD_ISSET(p->fd, &rfds) ? ws_pending_read(p) : 0;
+            if(res > 0 && ws_handshake_reply(p->fd, p->req)){
+                // El ultimo navegador en conectar es el que conduce
+                if(client >= 0){
+                    close(client);
+                }
+                client = p->fd;
+                p->fd = -1;
+                rx_len = 0;
+                ws_sessions++;
+            } else if(res != 0 || now - p->since >= WS_HANDSHAKE_TIMEOUT_MS * 1000LL){
+                ws_pending_drop(p);
+            }
+        }
+
+        if(FD_ISSET(listen_fd, &rfds)){
+            int fd = accept(listen_fd, NULL, NULL);
+            if(fd < 0){
+                continue;
+            }
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            // Sin hueco se cae el upgrade mas viejo: el que llega ahora es el que tiene mas posibilidades
+            ws_pending_t * slot = &pending[0];
+            for(int i = 0; i < WS_PENDING; i++){
+                if(pending[i].fd < 0 || (slot->fd >= 0 && pending[i].since < slot->since)){
+                    slot = &pending[i];
+                }
+            }
+            if(slot->fd >= 0){
+                ws_pending_drop(slot);
+            }
+            slot->fd = fd;
+            slot->len = 0;
+            slot->req[0] = 0;
+            slot->since = now;
+        }
+    }
+}
+
+void ws_control_start(){
+    if(ws_task_handle){
+        return;
+    }
+    task_plan_create(TASK_WS, ws_task, NULL, &ws_task_handle);
+}
+
+void ws_control_stats(uint32_t * commands, uint32_t * sessions){
+    *commands = ws_commands;
+    *sessions = ws_sessions;
+}
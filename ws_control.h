@@ -0,0 +1,51 @@
+#ifndef WS_CONTROL_H
+#define WS_CONTROL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Canal de control por WebSocket, en su propio puerto como el stream (80 web, 81 stream, 82 control)
+#ifndef WS_CONTROL_PORT
+#define WS_CONTROL_PORT 82
+#endif
+
+// Un navegador que abre la conexion y no termina la peticion de upgrade se cierra pasado este tiempo.
+// La peticion se va juntando en cada vuelta del select, sin parar los comandos del que conduce.
+#define WS_HANDSHAKE_TIMEOUT_MS 2000
+#define WS_HANDSHAKE_MAX 768
+
+// Cada mensaje binario lleva una o varias tramas de 8 bytes, little-endian:
+//   opcode (1) | canal (1) | valor int16 (2) | secuencia uint32 (4)
+// El servidor responde con la misma trama cambiando el opcode a ACK o NACK.
+#define WS_OP_SET   0x01
+#define WS_OP_PING  0x02
+#define WS_OP_ACK   0x81
+#define WS_OP_NACK  0x82
+
+#define WS_FRAME_LEN 8
+
+void ws_control_start();
+
+// Lo que hace la tarea con cada trama, separado de los sockets para probarlo en el PC.
+
+// Trama del cliente, ya sin mascara (payload apunta dentro del buffer)
+typedef struct {
+        uint8_t opcode;
+        uint8_t * payload;
+        size_t len;
+} ws_frame_t;
+
+// Una trama al principio de buf. Bytes que ocupa, 0 si falta por llegar, -1 si hay que cerrar:
+// sin mascara, longitud de 64 bits, mas grande que el buffer de recepcion u opcode reservado.
+int ws_frame_parse(uint8_t * buf, size_t len, ws_frame_t * frame);
+
+// Aplica los comandos de 8 bytes de un mensaje binario y deja la respuesta en el mismo sitio
+// (opcode cambiado a ACK o NACK). Bytes de respuesta; un comando a medias al final se descarta.
+size_t ws_commands_run(uint8_t * payload, size_t len);
+
+// Sec-WebSocket-Accept para la peticion de upgrade req. Longitud escrita en accept, 0 si no hay clave.
+size_t ws_handshake_accept(const char * req, char * accept, size_t size);
+
+void ws_control_stats(uint32_t * commands, uint32_t * sessions);
+
+#endif